@@ -14,7 +14,7 @@ static Particle particles[PARTICLE_COUNT];
 /* Vulkan state */
 Rvk_Descriptor_Pool_Arena arena = {0};
 Rvk_Descriptor_Set_Layout compute_ds_layout = {0};
-VkDescriptorSet compute_ds;
+VkDescriptorSet compute_ds[RVK_MAX_FRAMES_IN_FLIGHT]; // one per frame in flight, each points to that frame's ubo
 
 VkPipelineLayout compute_pl_layout;
 VkPipeline compute_pl;
@@ -69,10 +69,10 @@ void setup_ds_layout()
     rvk_ds_layout_init(bindings, RVK_ARRAY_LEN(bindings), &compute_ds_layout);
 }
 
-void setup_ds(Rvk_Buffer ubo, Rvk_Buffer comp_buff)
+void setup_ds(uint32_t frame, Rvk_Buffer ubo, Rvk_Buffer comp_buff)
 {
     /* allocate descriptor sets based on layouts */
-    rvk_descriptor_pool_arena_alloc_set(&arena, &compute_ds_layout, &compute_ds);
+    rvk_descriptor_pool_arena_alloc_set(&arena, &compute_ds_layout, &compute_ds[frame]);
 
     /* update descriptor sets */
     VkWriteDescriptorSet writes[] = {
@@ -81,7 +81,7 @@ void setup_ds(Rvk_Buffer ubo, Rvk_Buffer comp_buff)
             .dstBinding = 0,
             .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
             .descriptorCount = 1,
-            .dstSet = compute_ds,
+            .dstSet = compute_ds[frame],
             .pBufferInfo = &ubo.info,
         },
         {
@@ -89,7 +89,7 @@ void setup_ds(Rvk_Buffer ubo, Rvk_Buffer comp_buff)
             .dstBinding = 1,
             .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
             .descriptorCount = 1,
-            .dstSet = compute_ds,
+            .dstSet = compute_ds[frame],
             .pBufferInfo = &comp_buff.info,
         },
     };
@@ -182,10 +182,10 @@ int main()
     /* initialize some vulkan resources */
     Rvk_Buffer comp_buff = rvk_upload_compute_buff(PARTICLE_COUNT * sizeof(Particle), PARTICLE_COUNT, particles);
     float time = 0.0f;
-    Rvk_Buffer ubo = rvk_create_mapped_uniform_buff(sizeof(float), &time);
+    Rvk_Frame_Buffer ubo = rvk_create_mapped_uniform_frame_buff(sizeof(float), &time);
     rvk_descriptor_pool_arena_init(&arena);
     setup_ds_layout();
-    setup_ds(ubo, comp_buff);
+    for (uint32_t i = 0; i < ubo.count; i++) setup_ds(i, ubo.buffs[i], comp_buff);
     create_pipelines();
 
     set_target_fps(60);
@@ -193,7 +193,7 @@ int main()
         begin_frame();
         /* record compute commands */
         size_t group_x = ceilf(PARTICLE_COUNT / 256.0f);
-        rvk_dispatch(compute_pl, compute_pl_layout, compute_ds, group_x, 1, 1);
+        rvk_dispatch(compute_pl, compute_pl_layout, compute_ds[rvk_get_frame_idx()], group_x, 1, 1);
 
         rvk_begin_render_pass(0.0f, 0.0f, 0.0f, 1.0f);
             /* record drawing commands */
@@ -202,13 +202,13 @@ int main()
                 rvk_bind_vertex_buffers(comp_buff);
                 rvk_cmd_draw(comp_buff.count);
                 time = get_time();
-                memcpy(ubo.mapped, &time, sizeof(float));
+                memcpy(rvk_frame_buff_get(&ubo)->mapped, &time, sizeof(float));
             end_mode_3d();
         end_drawing(); // ends rendering pass
     }
 
     rvk_wait_idle();
-    rvk_buff_destroy(ubo);
+    rvk_destroy_frame_buffer(ubo);
     rvk_buff_destroy(comp_buff);
     rvk_descriptor_pool_arena_destroy(arena);
     rvk_destroy_descriptor_set_layout(compute_ds_layout.handle);
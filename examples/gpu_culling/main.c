@@ -0,0 +1,54 @@
+#include "cvr.h"
+
+#define GRID_SIZE 320 // 102400 objects
+
+int main()
+{
+    Camera camera = {
+        .position   = {0.0f, 20.0f, 40.0f},
+        .target     = {0.0f, 0.0f, 0.0f},
+        .up         = {0.0f, 1.0f, 0.0f},
+        .fovy       = 45.0f,
+        .projection = PERSPECTIVE,
+    };
+
+    enable_gpu_scene(GRID_SIZE * GRID_SIZE + 1); // the grid and the spinner
+    init_window(800, 800, "GPU Culling");
+
+    /* every object is added once, after that the cpu only records the cull pass and one draw */
+    for (int i = 0; i < GRID_SIZE; i++) {
+        for (int j = 0; j < GRID_SIZE; j++) {
+            Shape_Type shape = ((i + j) % 2) ? SHAPE_CUBE : SHAPE_TETRAHEDRON;
+            Matrix transform = MatrixMultiply(
+                MatrixRotateY((i * 7 + j * 13) * 0.1f),
+                MatrixTranslate((i - GRID_SIZE / 2) * 2.0f, 0.0f, (j - GRID_SIZE / 2) * 2.0f)
+            );
+            add_gpu_object(shape, transform);
+        }
+    }
+
+    /* one object keeps moving, only its transform is uploaded again */
+    uint32_t spinner = add_gpu_object(SHAPE_CUBE, MatrixIdentity());
+
+    while (!window_should_close()) {
+        update_camera_free(&camera);
+        if (is_key_pressed(KEY_F)) log_fps();
+
+        double time = get_time();
+        set_gpu_object_transform(spinner, MatrixMultiply(
+            MatrixRotateXYZ((Vector3){time, time * 0.5f, 0.0f}),
+            MatrixTranslate(0.0f, 3.0f, 0.0f)
+        ));
+
+        begin_frame();
+        cull_gpu_scene(camera);
+        rvk_begin_render_pass(0.2f, 0.2f, 0.2f, 1.0f);
+            begin_mode_3d(camera);
+                draw_gpu_scene();
+            end_mode_3d();
+        end_drawing(); // ends rendering pass
+    }
+
+    close_window();
+    return 0;
+}
@@ -0,0 +1,67 @@
+#version 450
+
+/* frustum culls every object and appends an indexed draw for the visible ones,
+ * the shapes share one vertex and index buffer so every draw goes in one list */
+struct Object {
+    mat4 model;
+    vec4 bounds; // object space sphere, center then radius
+    uvec4 shape; // only x is used
+};
+
+struct Draw_Cmd {
+    uint index_count;
+    uint instance_count;
+    uint first_index;
+    int vertex_offset;
+    uint first_instance;
+};
+
+layout(std430, set = 0, binding = 0) readonly buffer Objects {
+    Object objects[];
+};
+
+layout(std430, set = 0, binding = 1) writeonly buffer Cmds {
+    Draw_Cmd cmds[];
+};
+
+layout(std430, set = 0, binding = 2) buffer Count {
+    uint draw_count;
+};
+
+/* per shape ranges in the shared geometry buffers */
+layout(push_constant) uniform constants
+{
+    mat4 view_proj;
+    uvec4 first_idx;
+    uvec4 idx_count;
+    ivec4 vtx_offset;
+    uint object_count;
+} cull;
+
+layout(local_size_x = 64, local_size_y = 1, local_size_z = 1) in;
+
+void main()
+{
+    uint idx = gl_GlobalInvocationID.x;
+    if (idx >= cull.object_count) return;
+
+    Object obj = objects[idx];
+    vec3 center = (obj.model * vec4(obj.bounds.xyz, 1.0)).xyz;
+    float scale = max(length(obj.model[0].xyz), max(length(obj.model[1].xyz), length(obj.model[2].xyz)));
+    float radius = obj.bounds.w * scale;
+
+    /* frustum planes are sums and differences of the rows of view_proj */
+    mat4 rows = transpose(cull.view_proj);
+    vec4 planes[6] = vec4[6](
+        rows[3] + rows[0], rows[3] - rows[0],
+        rows[3] + rows[1], rows[3] - rows[1],
+        rows[3] + rows[2], rows[3] - rows[2]
+    );
+    for (int i = 0; i < 6; i++) {
+        if (dot(planes[i].xyz, center) + planes[i].w < -radius * length(planes[i].xyz)) return;
+    }
+
+    uint shape = obj.shape.x;
+    uint slot = atomicAdd(draw_count, 1);
+    cmds[slot] = Draw_Cmd(cull.idx_count[shape], 1, cull.first_idx[shape], cull.vtx_offset[shape], idx);
+}
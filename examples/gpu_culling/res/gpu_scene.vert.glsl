@@ -0,0 +1,29 @@
+#version 450
+
+/* the cull pass sets first_instance to the object index */
+struct Object {
+    mat4 model;
+    vec4 bounds;
+    uvec4 shape;
+};
+
+layout(std430, set = 0, binding = 0) readonly buffer Objects {
+    Object objects[];
+};
+
+layout(push_constant) uniform constants
+{
+    mat4 view_proj;
+} push_const;
+
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec3 inColor;
+layout(location = 2) in vec2 inUv;
+
+layout(location = 0) out vec3 fragColor;
+
+void main()
+{
+    gl_Position = push_const.view_proj * objects[gl_InstanceIndex].model * vec4(inPosition, 1.0);
+    fragColor = inColor;
+}
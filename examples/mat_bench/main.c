@@ -0,0 +1,124 @@
+#include "cvr.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* compares the mat_simd kernels against the raymath functions they replace.
+ * no window or vulkan context is needed */
+
+#define COUNT 4096
+#define ROUNDS 500
+
+static Matrix models[COUNT];
+static float16 mvps[COUNT];
+static Vector3 points[COUNT];
+static Vector3 out_points[COUNT];
+
+static double now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static float rand_float()
+{
+    return (float)rand() / RAND_MAX * 2.0f - 1.0f;
+}
+
+static float max_diff(const float *a, const float *b, size_t count)
+{
+    float diff = 0.0f;
+    for (size_t i = 0; i < count; i++) {
+        float d = fabsf(a[i] - b[i]) / (1.0f + fabsf(b[i]));
+        if (d > diff) diff = d;
+    }
+    return diff;
+}
+
+static void report(const char *name, double ref_secs, double simd_secs, size_t ops)
+{
+    printf("%-16s raymath %7.2f ns, %s %7.2f ns, %5.2fx\n", name,
+           ref_secs * 1e9 / ops, MAT_SIMD_PATH, simd_secs * 1e9 / ops, ref_secs / simd_secs);
+}
+
+int main()
+{
+    srand(0);
+    Matrix view = MatrixLookAt((Vector3){10.0f, 10.0f, 10.0f}, Vector3Zero(), (Vector3){0.0f, 1.0f, 0.0f});
+    Matrix proj = MatrixPerspective(45.0 * DEG2RAD, 16.0 / 9.0, 0.01, 1000.0);
+    Matrix view_proj = MatrixMultiply(view, proj);
+    for (size_t i = 0; i < COUNT; i++) {
+        Vector3 axis = Vector3Normalize((Vector3){rand_float(), rand_float(), rand_float()});
+        Matrix rot = MatrixRotate(axis, rand_float() * PI);
+        models[i] = MatrixMultiply(rot, MatrixTranslate(rand_float() * 50, rand_float() * 50, rand_float() * 50));
+        points[i] = (Vector3){rand_float() * 10, rand_float() * 10, rand_float() * 10};
+    }
+
+    const size_t ops = (size_t)COUNT * ROUNDS;
+    float sink = 0.0f;
+    printf("kernel path: %s\n", MAT_SIMD_PATH);
+
+    /* model * view_proj into float16, the per draw mvp */
+    double start = now();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (size_t i = 0; i < COUNT; i++) mvps[i] = MatrixToFloatV(MatrixMultiply(models[i], view_proj));
+        sink += mvps[r].v[0];
+    }
+    double ref_secs = now() - start;
+    float16 ref_mvp = mvps[7];
+    start = now();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (size_t i = 0; i < COUNT; i++) mvps[i] = mat_mul_float16(models[i], view_proj);
+        sink += mvps[r].v[0];
+    }
+    double simd_secs = now() - start;
+    report("mvp", ref_secs, simd_secs, ops);
+    float diff = max_diff(mvps[7].v, ref_mvp.v, 16);
+
+    /* the same, batched the way flush_instances does */
+    start = now();
+    for (int r = 0; r < ROUNDS; r++) {
+        mat_mul_batch_float16(models, view_proj, mvps, COUNT);
+        sink += mvps[r].v[0];
+    }
+    simd_secs = now() - start;
+    report("mvp batch", ref_secs, simd_secs, ops);
+    diff = fmaxf(diff, max_diff(mvps[7].v, ref_mvp.v, 16));
+
+    start = now();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (size_t i = 0; i < COUNT; i++) models[i] = MatrixInvert(models[i]);
+        sink += models[r].m0;
+    }
+    ref_secs = now() - start;
+    Matrix ref_inv = MatrixInvert(models[7]);
+    start = now();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (size_t i = 0; i < COUNT; i++) models[i] = mat_invert(models[i]);
+        sink += models[r].m0;
+    }
+    simd_secs = now() - start;
+    report("invert", ref_secs, simd_secs, ops);
+    Matrix inv = mat_invert(models[7]);
+    diff = fmaxf(diff, max_diff(&inv.m0, &ref_inv.m0, 16));
+
+    start = now();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (size_t i = 0; i < COUNT; i++) out_points[i] = Vector3Transform(points[i], view_proj);
+        sink += out_points[r].x;
+    }
+    ref_secs = now() - start;
+    Vector3 ref_point = out_points[7];
+    start = now();
+    for (int r = 0; r < ROUNDS; r++) {
+        mat_transform_points(view_proj, points, out_points, COUNT);
+        sink += out_points[r].x;
+    }
+    simd_secs = now() - start;
+    report("transform points", ref_secs, simd_secs, ops);
+    diff = fmaxf(diff, max_diff(&out_points[7].x, &ref_point.x, 3));
+
+    printf("max relative difference %g (sink %f)\n", diff, sink);
+    return 0;
+}
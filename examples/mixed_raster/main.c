@@ -32,23 +32,15 @@ typedef struct {
 } UBO_Data;
 
 typedef struct {
-    Rvk_Buffer buff;
+    Rvk_Frame_Buffer buff; // one ubo per frame in flight
     UBO_Data data;
 } Point_Cloud_UBO;
 
-typedef struct {
-    VkFramebuffer frame_buff;
-    Rvk_Texture depth;
-    Rvk_Texture color;
-    VkRenderPass rp;
-    VkImageView img_views[2];
-} Prepass;
-
 typedef struct {
     VkPipeline pl;
     VkPipelineLayout pl_layout;
     Rvk_Descriptor_Set_Layout ds_layout;
-    VkDescriptorSet ds;
+    VkDescriptorSet ds[RVK_MAX_FRAMES_IN_FLIGHT];
 } Pipeline;
 
 Rvk_Descriptor_Pool_Arena arena = {0};
@@ -60,7 +52,7 @@ Pipeline comp_render  = {0}; // 3) compute shader rasterization
 Pipeline comp_resolve = {0}; // 4) resolve colors from compute shader raster
 Pipeline sst_gfx      = {0}; // 5) draw resolved colors to a screen space triangle
 VkDescriptorPool pool;
-Prepass prepass = {0};
+Rvk_Render_Texture prepass = {0};
 
 Point_Cloud gen_point_cloud(size_t num_points)
 {
@@ -104,127 +96,6 @@ Frame_Buffer alloc_frame_buff(size_t width, size_t height)
     return frame;
 }
 
-void setup_prerender_pass()
-{
-    VkAttachmentDescription color = {
-        .format = VK_FORMAT_R8G8B8A8_UNORM,
-        .samples = VK_SAMPLE_COUNT_1_BIT,
-        .loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
-        .storeOp = VK_ATTACHMENT_STORE_OP_STORE,
-        .stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
-        .stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
-        .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
-        .finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-    };
-    VkAttachmentReference color_ref = {
-        .layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
-    };
-    VkAttachmentDescription depth = {
-        .format = VK_FORMAT_D32_SFLOAT,
-        .samples = VK_SAMPLE_COUNT_1_BIT,
-        .loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
-        .storeOp = VK_ATTACHMENT_STORE_OP_STORE,
-        .stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
-        .stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
-        .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
-        .finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL,
-    };
-    VkAttachmentReference depth_ref = {
-        .attachment = 1,
-        .layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
-    };
-    VkSubpassDependency dependency = {
-        // .srcSubpass = VK_SUBPASS_EXTERNAL,
-        // .srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT,
-        // .dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT,
-        // .dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
-
-        .srcSubpass      = VK_SUBPASS_EXTERNAL,
-        .dstSubpass      = 0,
-        .srcStageMask    = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
-        .dstStageMask    = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
-        .srcAccessMask   = 0,
-        .dstAccessMask   = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
-        .dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT,
-
-    };
-    VkSubpassDescription subpass = {
-        .colorAttachmentCount = 1,
-        .pColorAttachments = &color_ref,
-        .pDepthStencilAttachment = &depth_ref,
-    };
-    VkAttachmentDescription attachments[] = {color, depth};
-    VkRenderPassCreateInfo render_pass_ci = {
-        .sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO,
-        .attachmentCount = RVK_ARRAY_LEN(attachments),
-        .pAttachments = attachments,
-        .subpassCount = 1,
-        .pSubpasses = &subpass,
-        .dependencyCount = 1,
-        .pDependencies = &dependency,
-    };
-
-    rvk_create_render_pass(&render_pass_ci, &prepass.rp);
-}
-
-void setup_prepass_frame_buff(Window_Size win_sz)
-{
-    /* create the depth image */
-    prepass.depth.img = (Rvk_Image) {
-        .extent = {win_sz.width, win_sz.height},
-        .aspect_mask = VK_IMAGE_ASPECT_DEPTH_BIT,
-        .format = VK_FORMAT_D32_SFLOAT,
-    };
-    rvk_img_init(
-        &prepass.depth.img,
-        VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
-        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
-    );
-
-    rvk_img_view_init(prepass.depth.img, &prepass.depth.view);
-    rvk_sampler_init(&prepass.depth.sampler);
-
-    /* book keeping */
-    prepass.depth.info = (VkDescriptorImageInfo) {
-        .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-        .sampler = prepass.depth.sampler,
-        .imageView = prepass.depth.view,
-    };
-
-    /* create the color image */
-    prepass.color.img = (Rvk_Image) {
-        .extent = {win_sz.width, win_sz.height},
-        .aspect_mask = VK_IMAGE_ASPECT_COLOR_BIT,
-        .format = VK_FORMAT_R8G8B8A8_UNORM,
-    };
-    rvk_img_init(
-        &prepass.color.img,
-        VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
-        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
-    );
-    rvk_img_view_init(prepass.color.img, &prepass.color.view);
-    rvk_sampler_init(&prepass.color.sampler);
-
-    /* create the frame buffer which combines both depth and color */
-    prepass.img_views[0] = prepass.color.view;
-    prepass.img_views[1] = prepass.depth.view;
-    rvk_create_frame_buff(
-        win_sz.width,
-        win_sz.height,
-        prepass.img_views,
-        RVK_ARRAY_LEN(prepass.img_views),
-        prepass.rp,
-        &prepass.frame_buff
-    );
-
-    /* book keeping */
-    prepass.color.info = (VkDescriptorImageInfo) {
-        .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-        .sampler = prepass.color.sampler,
-        .imageView = prepass.color.view,
-    };
-}
-
 void setup_ds_layouts()
 {
     /* mix.comp shader layout */
@@ -315,13 +186,13 @@ void setup_ds_layouts()
     rvk_ds_layout_init(sst_gfx_bindings, RVK_ARRAY_LEN(sst_gfx_bindings), &sst_gfx.ds_layout);
 }
 
-void setup_ds_sets(Rvk_Buffer ubo, Rvk_Buffer point_cloud, Rvk_Buffer frame_buff, Rvk_Texture storage_tex)
+void setup_frame_ds_sets(uint32_t frame, Rvk_Buffer ubo, Rvk_Buffer point_cloud, Rvk_Buffer frame_buff, Rvk_Texture storage_tex)
 {
     /* allocate descriptor sets based on layouts */
-    rvk_descriptor_pool_arena_alloc_set(&arena, &comp_mix.ds_layout,  &comp_mix.ds);
-    rvk_descriptor_pool_arena_alloc_set(&arena, &comp_render.ds_layout,  &comp_render.ds);
-    rvk_descriptor_pool_arena_alloc_set(&arena, &comp_resolve.ds_layout,  &comp_resolve.ds);
-    rvk_descriptor_pool_arena_alloc_set(&arena, &sst_gfx.ds_layout,  &sst_gfx.ds);
+    rvk_descriptor_pool_arena_alloc_set(&arena, &comp_mix.ds_layout,  &comp_mix.ds[frame]);
+    rvk_descriptor_pool_arena_alloc_set(&arena, &comp_render.ds_layout,  &comp_render.ds[frame]);
+    rvk_descriptor_pool_arena_alloc_set(&arena, &comp_resolve.ds_layout,  &comp_resolve.ds[frame]);
+    rvk_descriptor_pool_arena_alloc_set(&arena, &sst_gfx.ds_layout,  &sst_gfx.ds[frame]);
 
     // .imageLayout = VK_IMAGE_LAYOUT_GENERAL,
     VkWriteDescriptorSet writes[] = {
@@ -331,7 +202,7 @@ void setup_ds_sets(Rvk_Buffer ubo, Rvk_Buffer point_cloud, Rvk_Buffer frame_buff
             .dstBinding = 0,
             .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
             .descriptorCount = 1,
-            .dstSet = comp_mix.ds,
+            .dstSet = comp_mix.ds[frame],
             .pBufferInfo = &ubo.info,
         },
         {
@@ -339,7 +210,7 @@ void setup_ds_sets(Rvk_Buffer ubo, Rvk_Buffer point_cloud, Rvk_Buffer frame_buff
             .dstBinding = 1,
             .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
             .descriptorCount = 1,
-            .dstSet = comp_mix.ds,
+            .dstSet = comp_mix.ds[frame],
             .pBufferInfo = &frame_buff.info,
         },
         {
@@ -347,7 +218,7 @@ void setup_ds_sets(Rvk_Buffer ubo, Rvk_Buffer point_cloud, Rvk_Buffer frame_buff
             .dstBinding = 2,
             .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
             .descriptorCount = 1,
-            .dstSet = comp_mix.ds,
+            .dstSet = comp_mix.ds[frame],
             .pImageInfo = &prepass.depth.info,
         },
         {
@@ -355,7 +226,7 @@ void setup_ds_sets(Rvk_Buffer ubo, Rvk_Buffer point_cloud, Rvk_Buffer frame_buff
             .dstBinding = 3,
             .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
             .descriptorCount = 1,
-            .dstSet = comp_mix.ds,
+            .dstSet = comp_mix.ds[frame],
             .pImageInfo = &prepass.color.info,
         },
         /* render.comp */
@@ -364,7 +235,7 @@ void setup_ds_sets(Rvk_Buffer ubo, Rvk_Buffer point_cloud, Rvk_Buffer frame_buff
             .dstBinding = 0,
             .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
             .descriptorCount = 1,
-            .dstSet = comp_render.ds,
+            .dstSet = comp_render.ds[frame],
             .pBufferInfo = &ubo.info,
         },
         {
@@ -372,7 +243,7 @@ void setup_ds_sets(Rvk_Buffer ubo, Rvk_Buffer point_cloud, Rvk_Buffer frame_buff
             .dstBinding = 1,
             .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
             .descriptorCount = 1,
-            .dstSet = comp_render.ds,
+            .dstSet = comp_render.ds[frame],
             .pBufferInfo = &point_cloud.info,
         },
         {
@@ -380,7 +251,7 @@ void setup_ds_sets(Rvk_Buffer ubo, Rvk_Buffer point_cloud, Rvk_Buffer frame_buff
             .dstBinding = 2,
             .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
             .descriptorCount = 1,
-            .dstSet = comp_render.ds,
+            .dstSet = comp_render.ds[frame],
             .pBufferInfo = &frame_buff.info,
         },
         /* resolve.comp */
@@ -389,7 +260,7 @@ void setup_ds_sets(Rvk_Buffer ubo, Rvk_Buffer point_cloud, Rvk_Buffer frame_buff
             .dstBinding = 0,
             .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
             .descriptorCount = 1,
-            .dstSet = comp_resolve.ds,
+            .dstSet = comp_resolve.ds[frame],
             .pBufferInfo = &ubo.info,
         },
         {
@@ -397,7 +268,7 @@ void setup_ds_sets(Rvk_Buffer ubo, Rvk_Buffer point_cloud, Rvk_Buffer frame_buff
             .dstBinding = 1,
             .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
             .descriptorCount = 1,
-            .dstSet = comp_resolve.ds,
+            .dstSet = comp_resolve.ds[frame],
             .pBufferInfo = &frame_buff.info,
         },
         {
@@ -405,7 +276,7 @@ void setup_ds_sets(Rvk_Buffer ubo, Rvk_Buffer point_cloud, Rvk_Buffer frame_buff
             .dstBinding = 2,
             .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
             .descriptorCount = 1,
-            .dstSet = comp_resolve.ds,
+            .dstSet = comp_resolve.ds[frame],
             .pImageInfo = &storage_tex.info,
         },
         /* sst.frag */
@@ -414,21 +285,32 @@ void setup_ds_sets(Rvk_Buffer ubo, Rvk_Buffer point_cloud, Rvk_Buffer frame_buff
             .dstBinding = 0,
             .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
             .descriptorCount = 1,
-            .dstSet = sst_gfx.ds,
+            .dstSet = sst_gfx.ds[frame],
             .pImageInfo = &storage_tex.info,
         },
     };
     rvk_update_ds(RVK_ARRAY_LEN(writes), writes);
 }
 
+void setup_ds_sets(Rvk_Frame_Buffer *ubo, Rvk_Buffer point_cloud, Rvk_Buffer frame_buff, Rvk_Texture storage_tex)
+{
+    /* each frame in flight gets its own sets, since they point to that frame's ubo */
+    for (uint32_t i = 0; i < ubo->count; i++)
+        setup_frame_ds_sets(i, ubo->buffs[i], point_cloud, frame_buff, storage_tex);
+}
+
 void build_compute_cmds(size_t point_cloud_count, Window_Size win_sz)
 {
     size_t group_x = 1; size_t group_y = 1; size_t group_z = 1;
+    uint32_t frame = rvk_get_frame_idx();
+
+    /* frame buffer and storage image are shared between frames in flight */
+    rvk_frame_compute_barrier();
 
     /* mix the frame buffer from prepass fixed-function render */
     group_x = ceilf((float)win_sz.width / IMG_WORKGROUP_SZ);
     group_y = ceilf((float)win_sz.height / IMG_WORKGROUP_SZ);
-    rvk_dispatch(comp_mix.pl, comp_mix.pl_layout, comp_mix.ds, group_x, group_y, group_z);
+    rvk_dispatch(comp_mix.pl, comp_mix.pl_layout, comp_mix.ds[frame], group_x, group_y, group_z);
 
     rvk_compute_pl_barrier();
 
@@ -438,7 +320,7 @@ void build_compute_cmds(size_t point_cloud_count, Window_Size win_sz)
     for (size_t i = 0; i < NUM_BATCHES; i++) {
         uint32_t offset = i * batch_size * WORKGROUP_SZ;
         rvk_push_const(comp_render.pl_layout, VK_SHADER_STAGE_COMPUTE_BIT, sizeof(uint32_t), &offset);
-        rvk_dispatch(comp_render.pl, comp_render.pl_layout, comp_render.ds, batch_size, group_y, group_z);
+        rvk_dispatch(comp_render.pl, comp_render.pl_layout, comp_render.ds[frame], batch_size, group_y, group_z);
     }
 
     rvk_compute_pl_barrier();
@@ -446,7 +328,7 @@ void build_compute_cmds(size_t point_cloud_count, Window_Size win_sz)
     /* resolve the frame buffer */
     group_x = ceilf((float)win_sz.width / IMG_WORKGROUP_SZ);
     group_y = ceilf((float)win_sz.height / IMG_WORKGROUP_SZ);
-    rvk_dispatch(comp_resolve.pl, comp_resolve.pl_layout, comp_resolve.ds, group_x, group_y, group_z);
+    rvk_dispatch(comp_resolve.pl, comp_resolve.pl_layout, comp_resolve.ds[frame], group_x, group_y, group_z);
 }
 
 void create_prepass_pipeline()
@@ -481,7 +363,6 @@ void create_prepass_pipeline()
         .inputRate = VK_VERTEX_INPUT_RATE_VERTEX,
         .stride    = sizeof(Vector3) * 2 + sizeof(Vector2),
     };
-    assert(prepass.rp != NULL && "prepass renderpass was NULL");
     Pipeline_Config config = {
         .pl_layout = prepass_gfx.pl_layout,
         .vert = "./res/default.vert.glsl.spv",
@@ -492,13 +373,17 @@ void create_prepass_pipeline()
         .vert_attr_count = RVK_ARRAY_LEN(vert_attrs),
         .vert_bindings = &vert_bindings,
         .vert_binding_count = 1,
-        .render_pass = prepass.rp,
+        .render_texture = &prepass,
     };
     rvk_basic_pl_init(config, &prepass_gfx.pl);
 }
 
 void create_pipelines()
 {
+    /* all five pipelines are compiled together on worker threads */
+    Rvk_Pipeline_Batch pl_batch = {0};
+    rvk_begin_pipeline_batch(&pl_batch);
+
     VkPushConstantRange pk_range = {.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT, .size = sizeof(uint32_t)};
     /* compute shader render pipeline */
     rvk_create_pipeline_layout(
@@ -521,6 +406,8 @@ void create_pipelines()
     rvk_sst_pl_init(sst_gfx.pl_layout, &sst_gfx.pl);
 
     create_prepass_pipeline();
+
+    rvk_end_pipeline_batch(&pl_batch, 4);
 }
 
 #define shift(xs_sz, xs) (assert((xs_sz) > 0), (xs_sz)--, *(xs)++)
@@ -533,12 +420,13 @@ int main(int argc, char **argv)
         if (strcmp(option, "--fullscreen") == 0) enable_full_screen();
     }
 
-    Point_Cloud_UBO ubo = {.buff = {.count = 1, .size = sizeof(UBO_Data)}};
+    Point_Cloud_UBO ubo = {0};
     Point_Cloud pc = gen_point_cloud(POINT_COUNT);
     rvk_log(RVK_INFO, "point count %zu", pc.count);
 
     /* initialize window and Vulkan */
     rvk_enable_atomic_features();
+    rvk_enable_dynamic_rendering();
     init_window(DEFAULT_WINDOW_WIDTH, DEFAULT_WINDOW_HEIGHT, "mixing rasterization with fixed function");
     Window_Size win_sz = get_window_size();
     Rvk_Texture storage_tex = {.img.extent = {win_sz.width, win_sz.height}};
@@ -554,15 +442,14 @@ int main(int argc, char **argv)
     /* upload resources to GPU */
     pc.buff    = rvk_upload_compute_buff(pc.buff.size, pc.buff.count, pc.items);
     frame.buff = rvk_upload_compute_buff(frame.buff.size, frame.buff.count, frame.data);
-    ubo.buff   = rvk_create_mapped_uniform_buff(sizeof(UBO_Data), &ubo.data);
+    ubo.buff   = rvk_create_mapped_uniform_frame_buff(sizeof(UBO_Data), &ubo.data);
     rvk_storage_tex_init(&storage_tex, storage_tex.img.extent);
 
     /* setup vulkan resources */
-    setup_prerender_pass();
-    setup_prepass_frame_buff(win_sz);
+    prepass = rvk_create_render_texture((VkExtent2D){win_sz.width, win_sz.height});
     setup_ds_layouts();
     rvk_descriptor_pool_arena_init(&arena);
-    setup_ds_sets(ubo.buff, pc.buff, frame.buff, storage_tex);
+    setup_ds_sets(&ubo.buff, pc.buff, frame.buff, storage_tex);
     create_pipelines();
 
     Shape_Type shape = 0;
@@ -585,7 +472,7 @@ int main(int argc, char **argv)
         rvk_begin_rec_gfx();
             begin_mode_3d(camera);
                 /* draw spinning cube in an offscreen pass */ 
-                rvk_begin_offscreen_render_pass(1.0, 0.0, 0.0, 1.0, prepass.rp, prepass.frame_buff, prepass.depth.img.extent);
+                rvk_begin_render_texture(prepass, 1.0, 0.0, 0.0, 1.0);
                     if (spin) rotate_y(get_time() * 1.0);
                     scale(s, s, s);
                 draw_shape_ex(prepass_gfx.pl, prepass_gfx.pl_layout, NULL, shape);
@@ -602,14 +489,15 @@ int main(int argc, char **argv)
                 get_mvp_float16(&ubo.data.mvp);
                 ubo.data.width  = win_sz.width;
                 ubo.data.height = win_sz.height;
-                memcpy(ubo.buff.mapped, &ubo.data, ubo.buff.size);
+                Rvk_Buffer *frame_ubo = rvk_frame_buff_get(&ubo.buff);
+                memcpy(frame_ubo->mapped, &ubo.data, frame_ubo->size);
             end_mode_3d();
 
             rvk_raster_sampler_barrier(storage_tex.img.handle);
 
             /* draw command for screen space triangle (sst) */
             rvk_begin_render_pass(0.0f, 0.0f, 0.0f, 1.0f);
-                rvk_draw_sst(sst_gfx.pl, sst_gfx.pl_layout, sst_gfx.ds);
+                rvk_draw_sst(sst_gfx.pl, sst_gfx.pl_layout, sst_gfx.ds[rvk_get_frame_idx()]);
             rvk_end_render_pass();
         rvk_end_rec_gfx();
         rvk_submit_gfx();
@@ -623,7 +511,7 @@ int main(int argc, char **argv)
     free(frame.data);
     rvk_buff_destroy(pc.buff);
     rvk_buff_destroy(frame.buff);
-    rvk_buff_destroy(ubo.buff);
+    rvk_destroy_frame_buffer(ubo.buff);
     rvk_destroy_ds_pool(pool);
     rvk_destroy_descriptor_set_layout(comp_mix.ds_layout.handle);
     rvk_destroy_descriptor_set_layout(comp_render.ds_layout.handle);
@@ -636,10 +524,7 @@ int main(int argc, char **argv)
     rvk_destroy_pl_res(sst_gfx.pl, sst_gfx.pl_layout);
     rvk_destroy_pl_res(prepass_gfx.pl, prepass_gfx.pl_layout);
     rvk_unload_texture(storage_tex);
-    rvk_unload_texture(prepass.depth);
-    rvk_unload_texture(prepass.color);
-    rvk_destroy_frame_buff(prepass.frame_buff);
-    rvk_destroy_render_pass(prepass.rp);
+    rvk_destroy_render_texture(prepass);
     close_window();
     return 0;
 }
@@ -0,0 +1,54 @@
+#include "cvr.h"
+
+#define GRID_SIZE 200 // 40000 draws
+#define THREAD_COUNT 8
+
+/* every thread records its own band of rows, one draw per cube */
+static void record_rows(uint32_t idx, uint32_t thread_count, void *data)
+{
+    float time = *(float *)data;
+    int first = GRID_SIZE * idx / thread_count;
+    int last = GRID_SIZE * (idx + 1) / thread_count;
+    for (int i = first; i < last; i++) {
+        for (int j = 0; j < GRID_SIZE; j++) {
+            push_matrix();
+                translate((i - GRID_SIZE / 2) * 2.0f, sinf(time + (i + j) * 0.1f), (j - GRID_SIZE / 2) * 2.0f);
+                rotate_y(time + i * 0.05f);
+                draw_shape(((i + j) % 2) ? SHAPE_CUBE : SHAPE_TETRAHEDRON);
+            pop_matrix();
+        }
+    }
+}
+
+int main()
+{
+    Camera camera = {
+        .position   = {0.0f, 30.0f, 60.0f},
+        .target     = {0.0f, 0.0f, 0.0f},
+        .up         = {0.0f, 1.0f, 0.0f},
+        .fovy       = 45.0f,
+        .projection = PERSPECTIVE,
+    };
+
+    init_window(800, 800, "Parallel Draw");
+
+    uint32_t thread_count = THREAD_COUNT;
+    while (!window_should_close()) {
+        update_camera_free(&camera);
+        if (is_key_pressed(KEY_F)) log_fps();
+        if (is_key_pressed(KEY_T)) {
+            thread_count = (thread_count == 1) ? THREAD_COUNT : 1;
+            rvk_log(RVK_INFO, "recording on %u thread(s)", thread_count);
+        }
+
+        float time = get_time();
+        begin_drawing_parallel(BLUE);
+            begin_mode_3d(camera);
+                record_parallel(thread_count, record_rows, &time);
+            end_mode_3d();
+        end_drawing();
+    }
+
+    close_window();
+    return 0;
+}
@@ -1,8 +1,16 @@
 #include "cvr.h"
 
 #define NUM_POINTS 1000*1000*10
-#define WORKGROUP_SZ 1024
+#define MAX_WORKGROUP_SZ 1024
+#define IMG_WORKGROUP_SZ 16
 #define NUM_BATCHES 8
+#define IMG_WIDTH  1600
+#define IMG_HEIGHT 900
+
+/* picked from the device limits and handed to the shaders as specialization constants */
+static uint32_t workgroup_sz = MAX_WORKGROUP_SZ;
+static Rvk_Spec_Constants render_spec = {0};
+static Rvk_Spec_Constants resolve_spec = {0};
 
 typedef unsigned int uint;
 typedef struct {
@@ -29,7 +37,7 @@ typedef struct {
 } UBO_Data;
 
 typedef struct {
-    Rvk_Buffer buff;
+    Rvk_Frame_Buffer buff; // one ubo per frame in flight
     UBO_Data data;
 } Point_Cloud_UBO;
 
@@ -39,7 +47,8 @@ typedef struct {
     VkPipelineLayout layout;
     VkPipeline pl;
     Rvk_Descriptor_Set_Layout ds_layout;
-    VkDescriptorSet ds;
+    Rvk_Ds_Template ds_tmpl;
+    VkDescriptorSet ds[RVK_MAX_FRAMES_IN_FLIGHT];
 } Pipeline;
 
 Pipeline cs_render = {0};
@@ -76,7 +85,7 @@ void gen_points(size_t num_points, Point_Cloud *pc)
 Frame_Buffer alloc_frame_buff()
 {
     Frame_Buffer frame = {0};
-    frame.buff.count = 1600 * 900;
+    frame.buff.count = IMG_WIDTH * IMG_HEIGHT;
     frame.buff.size  = sizeof(uint64_t) * frame.buff.count;
     frame.data = malloc(frame.buff.size);
     return frame;
@@ -138,78 +147,46 @@ void setup_ds_layouts()
         .stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT,
     };
     rvk_ds_layout_init(&gfx_binding, 1, &gfx.ds_layout);
+
+    /* the sets are rewritten from packed infos rather than write arrays */
+    rvk_ds_template_init(&cs_render.ds_layout,  &cs_render.ds_tmpl);
+    rvk_ds_template_init(&cs_resolve.ds_layout, &cs_resolve.ds_tmpl);
+    rvk_ds_template_init(&gfx.ds_layout,        &gfx.ds_tmpl);
 }
 
-bool setup_ds_sets(Rvk_Buffer ubo, Rvk_Buffer point_cloud, Rvk_Buffer frame_buff, Rvk_Texture storage_tex)
+bool setup_frame_ds_sets(uint32_t frame, Rvk_Buffer ubo, Rvk_Buffer point_cloud, Rvk_Buffer frame_buff, Rvk_Texture storage_tex)
 {
     /* allocate descriptor sets based on layouts */
-    rvk_descriptor_pool_arena_alloc_set(&arena, &cs_render.ds_layout,  &cs_render.ds);
-    rvk_descriptor_pool_arena_alloc_set(&arena, &cs_resolve.ds_layout, &cs_resolve.ds);
-    rvk_descriptor_pool_arena_alloc_set(&arena, &gfx.ds_layout,     &gfx.ds);
-
-    /* update descriptor sets */
-    VkWriteDescriptorSet writes[] = {
-        /* render.comp */
-        {
-            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .dstBinding = 0,
-            .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-            .descriptorCount = 1,
-            .dstSet = cs_render.ds,
-            .pBufferInfo = &ubo.info,
-        },
-        {
-            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .dstBinding = 1,
-            .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-            .descriptorCount = 1,
-            .dstSet = cs_render.ds,
-            .pBufferInfo = &point_cloud.info,
-        },
-        {
-            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .dstBinding = 2,
-            .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-            .descriptorCount = 1,
-            .dstSet = cs_render.ds,
-            .pBufferInfo = &frame_buff.info,
-        },
-        /* resolve.comp */
-        {
-            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .dstBinding = 0,
-            .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-            .descriptorCount = 1,
-            .dstSet = cs_resolve.ds,
-            .pBufferInfo = &ubo.info,
-        },
-        {
-            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .dstBinding = 1,
-            .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-            .descriptorCount = 1,
-            .dstSet = cs_resolve.ds,
-            .pBufferInfo = &frame_buff.info,
-        },
-        {
-            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .dstBinding = 2,
-            .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
-            .descriptorCount = 1,
-            .dstSet = cs_resolve.ds,
-            .pImageInfo = &storage_tex.info,
-        },
-        /* default.frag */
-        {
-            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .dstBinding = 0,
-            .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            .descriptorCount = 1,
-            .dstSet = gfx.ds,
-            .pImageInfo = &storage_tex.info,
-        },
+    rvk_descriptor_pool_arena_alloc_set(&arena, &cs_render.ds_layout,  &cs_render.ds[frame]);
+    rvk_descriptor_pool_arena_alloc_set(&arena, &cs_resolve.ds_layout, &cs_resolve.ds[frame]);
+    rvk_descriptor_pool_arena_alloc_set(&arena, &gfx.ds_layout,        &gfx.ds[frame]);
+
+    /* update descriptor sets, one info per binding in layout order */
+    Rvk_Descriptor_Info render_infos[] = {
+        {.buff = ubo.info},
+        {.buff = point_cloud.info},
+        {.buff = frame_buff.info},
     };
-    rvk_update_ds(RVK_ARRAY_LEN(writes), writes);
+    Rvk_Descriptor_Info resolve_infos[] = {
+        {.buff = ubo.info},
+        {.buff = frame_buff.info},
+        {.img  = storage_tex.info},
+    };
+    Rvk_Descriptor_Info gfx_infos[] = {
+        {.img = storage_tex.info},
+    };
+    rvk_update_ds_with_template(&cs_render.ds_tmpl,  cs_render.ds[frame],  render_infos);
+    rvk_update_ds_with_template(&cs_resolve.ds_tmpl, cs_resolve.ds[frame], resolve_infos);
+    rvk_update_ds_with_template(&gfx.ds_tmpl,        gfx.ds[frame],        gfx_infos);
+
+    return true;
+}
+
+bool setup_ds_sets(Rvk_Frame_Buffer *ubo, Rvk_Buffer point_cloud, Rvk_Buffer *frame_buffs, Rvk_Texture *storage_texs)
+{
+    /* each frame in flight gets its own sets, since they point to that frame's ubo, frame buffer and image */
+    for (uint32_t i = 0; i < ubo->count; i++)
+        if (!setup_frame_ds_sets(i, ubo->buffs[i], point_cloud, frame_buffs[i], storage_texs[i])) return false;
 
     return true;
 }
@@ -217,22 +194,23 @@ bool setup_ds_sets(Rvk_Buffer ubo, Rvk_Buffer point_cloud, Rvk_Buffer frame_buff
 void build_compute_cmds(size_t point_cloud_count)
 {
     size_t group_x = 1; size_t group_y = 1; size_t group_z = 1;
+    uint32_t frame = rvk_get_frame_idx();
 
     /* submit batches of points to render-compute shader */
-    group_x = ceilf((float)point_cloud_count / WORKGROUP_SZ);
+    group_x = ceilf((float)point_cloud_count / workgroup_sz);
     size_t batch_size = ceilf((float)group_x / NUM_BATCHES);
     for (size_t i = 0; i < NUM_BATCHES; i++) {
-        uint32_t offset = i * batch_size * WORKGROUP_SZ;
+        uint32_t offset = i * batch_size * workgroup_sz;
         rvk_push_const(cs_render.layout, VK_SHADER_STAGE_COMPUTE_BIT, sizeof(uint32_t), &offset);
-        rvk_dispatch(cs_render.pl , cs_render.layout, cs_render.ds, batch_size, group_y, group_z);
+        rvk_dispatch(cs_render.pl , cs_render.layout, cs_render.ds[frame], batch_size, group_y, group_z);
     }
 
     rvk_compute_pl_barrier();
 
     /* resolve the frame buffer */
-    group_x = ceilf(1600 / 16.0f);
-    group_y = ceilf(900 / 16.0f);
-    rvk_dispatch(cs_resolve.pl, cs_resolve.layout, cs_resolve.ds, group_x, group_y, group_z);
+    group_x = ceilf((float)IMG_WIDTH / IMG_WORKGROUP_SZ);
+    group_y = ceilf((float)IMG_HEIGHT / IMG_WORKGROUP_SZ);
+    rvk_dispatch(cs_resolve.pl, cs_resolve.layout, cs_resolve.ds[frame], group_x, group_y, group_z);
 }
 
 void create_pipelines()
@@ -246,14 +224,20 @@ void create_pipelines()
         .push_constant_range_count = 1,
         .p_set_layouts = &cs_render.ds_layout.handle
     );
-    rvk_compute_pl_init("./res/render.comp.glsl.spv", cs_render.layout, &cs_render.pl);
+    uint32_t max_workgroup_sz = rvk_max_compute_workgroup_size();
+    if (max_workgroup_sz < workgroup_sz) workgroup_sz = max_workgroup_sz;
+    uint32_t render_consts[] = {workgroup_sz, IMG_WIDTH, IMG_HEIGHT};
+    const VkSpecializationInfo *render_spec_info = rvk_spec_constants(&render_spec, render_consts, RVK_ARRAY_LEN(render_consts));
+    rvk_compute_pl_init_spec("./res/render.comp.glsl.spv", cs_render.layout, render_spec_info, &cs_render.pl);
 
     /* compute shader resolve pipeline */
     rvk_create_pipeline_layout(
         &cs_resolve.layout,
         .p_set_layouts = &cs_resolve.ds_layout.handle
     );
-    rvk_compute_pl_init("./res/resolve.comp.glsl.spv", cs_resolve.layout, &cs_resolve.pl);
+    uint32_t resolve_consts[] = {IMG_WORKGROUP_SZ, IMG_WORKGROUP_SZ};
+    const VkSpecializationInfo *resolve_spec_info = rvk_spec_constants(&resolve_spec, resolve_consts, RVK_ARRAY_LEN(resolve_consts));
+    rvk_compute_pl_init_spec("./res/resolve.comp.glsl.spv", cs_resolve.layout, resolve_spec_info, &cs_resolve.pl);
 
     /* screen space triangle + frag image sampler for raster display */
     rvk_create_pipeline_layout(
@@ -266,8 +250,12 @@ void create_pipelines()
 int main()
 {
     Point_Cloud pc = {0};
-    Rvk_Texture storage_tex = {.img.extent = {1600, 900}};
     Frame_Buffer frame = alloc_frame_buff();
+
+    /* compute writes the frame buffer and storage image while the previous frame's graphics
+     * may still sample its own, so each frame in flight gets a copy */
+    Rvk_Buffer frame_buffs[RVK_MAX_FRAMES_IN_FLIGHT] = {0};
+    Rvk_Texture storage_texs[RVK_MAX_FRAMES_IN_FLIGHT] = {0};
     Point_Cloud_UBO ubo = {0};
 
     /* generate initial point cloud */
@@ -275,7 +263,7 @@ int main()
 
     /* initialize window and Vulkan */
     rvk_enable_atomic_features();
-    init_window(1600, 900, "compute based rasterization for a point cloud");
+    init_window(IMG_WIDTH, IMG_HEIGHT, "compute based rasterization for a point cloud");
     Camera camera = {
         .position   = {10.0f, 10.0f, 10.0f},
         .up         = {0.0f, 1.0f, 0.0f},
@@ -286,14 +274,16 @@ int main()
 
     /* upload resources to GPU */
     pc.buff    = rvk_upload_compute_buff(pc.buff.size, pc.buff.count, pc.items);
-    frame.buff = rvk_upload_compute_buff(frame.buff.size, frame.buff.count, frame.data);
-    ubo.buff   = rvk_create_mapped_uniform_buff(sizeof(UBO_Data), &ubo.data);
-    rvk_storage_tex_init(&storage_tex, storage_tex.img.extent);
+    ubo.buff   = rvk_create_mapped_uniform_frame_buff(sizeof(UBO_Data), &ubo.data);
+    for (uint32_t i = 0; i < ubo.buff.count; i++) {
+        frame_buffs[i] = rvk_upload_compute_buff(frame.buff.size, frame.buff.count, frame.data);
+        rvk_storage_tex_init(&storage_texs[i], (VkExtent2D){IMG_WIDTH, IMG_HEIGHT});
+    }
 
     /* setup descriptors */
     rvk_descriptor_pool_arena_init(&arena);
     setup_ds_layouts();
-    setup_ds_sets(ubo.buff, pc.buff, frame.buff, storage_tex);
+    setup_ds_sets(&ubo.buff, pc.buff, frame_buffs, storage_texs);
 
     /* create pipelines */
     create_pipelines();
@@ -308,15 +298,18 @@ int main()
         begin_mode_3d(camera);
             rotate_y(get_time() * 0.5);
             get_mvp_float16(&ubo.data.mvp);
-            memcpy(ubo.buff.mapped, &ubo.data, ubo.buff.size);
-            build_compute_cmds(pc.count);
+            Rvk_Buffer *frame_ubo = rvk_frame_buff_get(&ubo.buff);
+            memcpy(frame_ubo->mapped, &ubo.data, frame_ubo->size);
+            begin_compute();
+                build_compute_cmds(pc.count);
+            end_compute();
         end_mode_3d();
 
-        rvk_raster_sampler_barrier(storage_tex.img.handle);
+        rvk_raster_sampler_barrier(storage_texs[rvk_get_frame_idx()].img.handle);
 
         /* draw command for screen space triangle (sst) */
         rvk_begin_render_pass(0.0f, 0.0f, 0.0f, 1.0f);
-            rvk_draw_sst(gfx.pl, gfx.layout, gfx.ds);
+            rvk_draw_sst(gfx.pl, gfx.layout, gfx.ds[rvk_get_frame_idx()]);
         end_drawing(); // ends gfx rec commands and render pass
     }
 
@@ -324,16 +317,21 @@ int main()
     free(pc.items);
     free(frame.data);
     rvk_buff_destroy(pc.buff);
-    rvk_buff_destroy(frame.buff);
-    rvk_buff_destroy(ubo.buff);
+    for (uint32_t i = 0; i < ubo.buff.count; i++) {
+        rvk_buff_destroy(frame_buffs[i]);
+        rvk_unload_texture(storage_texs[i]);
+    }
+    rvk_destroy_frame_buffer(ubo.buff);
     rvk_descriptor_pool_arena_destroy(arena);
     rvk_destroy_descriptor_set_layout(cs_render.ds_layout.handle);
     rvk_destroy_descriptor_set_layout(cs_resolve.ds_layout.handle);
     rvk_destroy_descriptor_set_layout(gfx.ds_layout.handle);
+    rvk_destroy_ds_template(cs_render.ds_tmpl);
+    rvk_destroy_ds_template(cs_resolve.ds_tmpl);
+    rvk_destroy_ds_template(gfx.ds_tmpl);
     rvk_destroy_pl_res(cs_render.pl, cs_render.layout);
     rvk_destroy_pl_res(cs_resolve.pl, cs_resolve.layout);
     rvk_destroy_pl_res(gfx.pl, gfx.layout);
-    rvk_unload_texture(storage_tex);
     close_window();
     return 0;
 }
@@ -25,7 +25,10 @@ layout(std430, binding = 2) buffer frame_data {
    uint64_t frame_buff[ ];
 };
 
-layout(local_size_x = 1024, local_size_y = 1, local_size_z = 1) in;
+/* set at pipeline creation, the defaults only apply when no specialization info is given */
+layout(local_size_x_id = 0, local_size_y = 1, local_size_z = 1) in;
+layout(constant_id = 1) const int IMG_WIDTH  = 1600;
+layout(constant_id = 2) const int IMG_HEIGHT = 900;
 
 void main()
 {
@@ -36,7 +39,7 @@ void main()
     if (pos.w <= 0 || ndc.x < -1.0 || ndc.x > 1.0 || ndc.y < -1.0 || ndc.y > 1.0)
         return;
 
-    ivec2 img_size = ivec2(1600, 900);
+    ivec2 img_size = ivec2(IMG_WIDTH, IMG_HEIGHT);
     vec2 img_pos = (ndc.xy * 0.5 + 0.5) * img_size;
 
     ivec2 pixel_coords = ivec2(img_pos);
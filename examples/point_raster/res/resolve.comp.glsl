@@ -17,14 +17,14 @@ layout(std430, binding = 1) buffer frame_data {
 
 layout(rgba8, binding = 2) uniform image2D out_img;
 
-layout(local_size_x = 16, local_size_y = 16, local_size_z = 1) in;
+layout(local_size_x_id = 0, local_size_y_id = 1, local_size_z = 1) in;
 
 void main()
 {
     uvec2 id = gl_GlobalInvocationID.xy;
 
     ivec2 img_size  = imageSize(out_img);
-    if (id.x >= img_size.x) return;
+    if (id.x >= img_size.x || id.y >= img_size.y) return;
 
     ivec2 pixel_coords = ivec2(id);
     int pixel_id = pixel_coords.x + pixel_coords.y * img_size.x;
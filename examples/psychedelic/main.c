@@ -12,10 +12,12 @@ int main()
         .projection = PERSPECTIVE,
     };
 
+    enable_instancing();
     init_window(800, 600, "Psychedelic");
 
     while (!window_should_close()) {
         if (is_key_pressed(KEY_SPACE)) shape = (shape + 1) % SHAPE_COUNT;
+        if (is_key_pressed(KEY_S)) rvk_log_cmd_stats();
 
         begin_drawing(BLUE);
             begin_mode_3d(camera);
@@ -0,0 +1,15 @@
+#version 450
+
+/* mvp per instance, a mat4 attribute takes up locations 3 through 6 */
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec3 inColor;
+layout(location = 2) in vec2 inUv;
+layout(location = 3) in mat4 inMvp;
+
+layout(location = 0) out vec3 fragColor;
+
+void main()
+{
+    gl_Position = inMvp * vec4(inPosition, 1.0);
+    fragColor = inColor;
+}
@@ -60,7 +60,7 @@ void create_sample_tex_pipeline(Pipeline *pl, VkDescriptorSetLayout *ds_layout)
     );
 }
 
-void create_render_tex_pipeline(Pipeline *pl, VkRenderPass rp)
+void create_render_tex_pipeline(Pipeline *pl, const Rvk_Render_Texture *render_tex)
 {
     VkPushConstantRange pk_range = {.stageFlags = VK_SHADER_STAGE_VERTEX_BIT, .size = sizeof(float)*16};
     rvk_create_pipeline_layout(
@@ -91,7 +91,7 @@ void create_render_tex_pipeline(Pipeline *pl, VkRenderPass rp)
         .fragment_shader_name = "res/render_texture.frag.glsl.spv",
         .p_vertex_input_state = &vertex_input_ci,
         .layout = pl->layout,
-        .render_pass = rp, 
+        .render_texture = render_tex,
     );
 }
 
@@ -113,6 +113,8 @@ int main()
     Camera cams[CAMERA_TYPE_COUNT] = {camera, camera};
     int cam_idx = 0;
 
+    /* offscreen target is just images and views, no render pass or framebuffer */
+    rvk_enable_dynamic_rendering();
     init_window(500, 500, "render texture");
     Rvk_Descriptor_Pool_Arena arena = {0};
     rvk_descriptor_pool_arena_init(&arena);
@@ -121,7 +123,7 @@ int main()
     VkExtent2D extent = {.width = 500, .height = 500};
     Rvk_Render_Texture render_tex = rvk_create_render_texture(extent);
     Pipeline render_tex_pl = {0};
-    create_render_tex_pipeline(&render_tex_pl, render_tex.rp);
+    create_render_tex_pipeline(&render_tex_pl, &render_tex);
     VkDescriptorSet tex_sample_ds;
     Rvk_Descriptor_Set_Layout tex_sample_layout = {0};
     VkDescriptorSetLayoutBinding binding = {
@@ -149,7 +151,7 @@ int main()
         rvk_begin_rec_gfx();
 
         begin_mode_3d(cams[CAMERA_TYPE_VIRTUAL]);
-        rvk_begin_offscreen_render_pass(0.0, 0.0, 0.0, 1.0, render_tex.rp, render_tex.fb, render_tex.extent);
+        rvk_begin_render_texture(render_tex, 0.0, 0.0, 0.0, 1.0);
             rotate_y(t);
             draw_shape_ex(render_tex_pl.handle, render_tex_pl.layout, NULL, SHAPE_CUBE);
         rvk_end_render_pass();
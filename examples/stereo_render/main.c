@@ -7,7 +7,7 @@ typedef struct {
     VkPipeline pl;
     VkPipelineLayout pl_layout;
     Rvk_Descriptor_Set_Layout ds_layout;
-    VkDescriptorSet ds;
+    VkDescriptorSet ds[RVK_MAX_FRAMES_IN_FLIGHT]; // one per frame in flight when it points to per-frame data, [0] otherwise
 } Pipeline;
 
 typedef struct {
@@ -29,7 +29,7 @@ typedef struct {
 } Uniform_Data;
 
 typedef struct {
-    Rvk_Buffer buffer;
+    Rvk_Frame_Buffer buffer; // one ubo per frame in flight
     Uniform_Data data;
 } Uniform;
 
@@ -56,33 +56,35 @@ void setup_ds_layouts()
     rvk_ds_layout_init(viewdisplay_bindings, RVK_ARRAY_LEN(viewdisplay_bindings), &viewdisplay.ds_layout);
 }
 
-void update_ds(Rvk_Buffer uniform_buffer, Rvk_Texture render_texture)
+void update_ds(Rvk_Frame_Buffer *uniform_buffer, Rvk_Texture render_texture)
 {
-    rvk_descriptor_pool_arena_alloc_set(&arena, &multiview.ds_layout,  &multiview.ds);
-    rvk_descriptor_pool_arena_alloc_set(&arena, &viewdisplay.ds_layout,  &viewdisplay.ds);
-
-    VkWriteDescriptorSet writes[] = {
-        { /* multiview.vert.glsl */
+    /* each frame in flight gets its own multiview set, since they point to that frame's ubo */
+    for (uint32_t i = 0; i < uniform_buffer->count; i++) {
+        rvk_descriptor_pool_arena_alloc_set(&arena, &multiview.ds_layout,  &multiview.ds[i]);
+        VkWriteDescriptorSet write = { /* multiview.vert.glsl */
             .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
             .dstBinding = 0,
             .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
             .descriptorCount = 1,
-            .dstSet = multiview.ds,
-            .pBufferInfo = &uniform_buffer.info,
-        },
-        { /* viewdisplay.vert.glsl */
-            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .dstBinding = 0,
-            .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            .descriptorCount = 1,
-            .dstSet = viewdisplay.ds,
-            .pImageInfo = &render_texture.info,
-        },
+            .dstSet = multiview.ds[i],
+            .pBufferInfo = &uniform_buffer->buffs[i].info,
+        };
+        rvk_update_ds(1, &write);
+    }
+
+    rvk_descriptor_pool_arena_alloc_set(&arena, &viewdisplay.ds_layout,  &viewdisplay.ds[0]);
+    VkWriteDescriptorSet write = { /* viewdisplay.vert.glsl */
+        .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+        .dstBinding = 0,
+        .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+        .descriptorCount = 1,
+        .dstSet = viewdisplay.ds[0],
+        .pImageInfo = &render_texture.info,
     };
-    rvk_update_ds(RVK_ARRAY_LEN(writes), writes);
+    rvk_update_ds(1, &write);
 }
 
-void create_multiview_pl(VkRenderPass rp)
+void create_multiview_pl(const Rvk_Render_Texture *render_texture)
 {
     rvk_create_pipeline_layout(&multiview.pl_layout, .p_set_layouts = &multiview.ds_layout.handle);
     VkVertexInputAttributeDescription vert_attrs[] = {
@@ -104,7 +106,7 @@ void create_multiview_pl(VkRenderPass rp)
     rvk_create_graphics_pipelines(
         &multiview.pl,
         .layout = multiview.pl_layout,
-        .render_pass = rp,
+        .render_texture = render_texture,
         .p_vertex_input_state = &vertex_input_ci,
         .vertex_shader_name = "res/multiview.vert.glsl.spv",
         .fragment_shader_name = "res/multiview.frag.glsl.spv",
@@ -131,9 +133,9 @@ void create_viewdisplay_pl()
     );
 }
 
-void create_pipelines(VkRenderPass multiview_rp)
+void create_pipelines(const Rvk_Render_Texture *render_texture)
 {
-    create_multiview_pl(multiview_rp);
+    create_multiview_pl(render_texture);
     create_viewdisplay_pl();
 }
 
@@ -146,20 +148,20 @@ void update_uniform(Uniform *uniform, Camera camera)
     uniform->data.model_view[0] = MatrixToFloatV(view);
     uniform->data.projection[1] = MatrixToFloatV(projection);
     uniform->data.model_view[1] = MatrixToFloatV(view);
-    memcpy(uniform->buffer.mapped, &uniform->data, sizeof(uniform->data));
+    memcpy(rvk_frame_buff_get(&uniform->buffer)->mapped, &uniform->data, sizeof(uniform->data));
 }
 
 void draw_shape_multiview(VkPipeline pl, VkPipelineLayout pl_layout, VkDescriptorSet ds, Shape_Type shape)
 {
-    Rvk_Buffer vtx_buff = get_shape_vertex_buffer(shape);
-    Rvk_Buffer idx_buff = get_shape_index_buffer(shape);
+    Rvk_Buffer vtx_buff = get_shape_vertex_buffer();
+    Rvk_Buffer idx_buff = get_shape_index_buffer();
     rvk_cmd_bind_pipeline(pl, VK_PIPELINE_BIND_POINT_GRAPHICS);
     rvk_cmd_bind_descriptor_sets(pl_layout, VK_PIPELINE_BIND_POINT_GRAPHICS, &ds);
     VkViewport viewport = { .width  = WINDOW_HEIGHT, .height = WINDOW_HEIGHT, .maxDepth = 1.0f };
     VkRect2D scissor = { .extent = {.width = WINDOW_HEIGHT, .height = WINDOW_HEIGHT}};
     rvk_cmd_set_viewport(viewport);
     rvk_cmd_set_scissor(scissor);
-    rvk_draw_buffers(vtx_buff, idx_buff);
+    rvk_draw_buffers_range(vtx_buff, idx_buff, get_shape_range(shape));
 }
 
 int main()
@@ -178,12 +180,12 @@ int main()
     VkExtent2D extent = {WINDOW_HEIGHT, WINDOW_HEIGHT};
     Rvk_Render_Texture render_texture = rvk_create_multiview_render_texture(extent, 2);
     Uniform uniform = {0};
-    uniform.buffer = rvk_create_mapped_uniform_buff(sizeof(uniform.data), &uniform.data);
+    uniform.buffer = rvk_create_mapped_uniform_frame_buff(sizeof(uniform.data), &uniform.data);
 
     arena = rvk_create_descriptor_pool_arena();
     setup_ds_layouts();
-    update_ds(uniform.buffer, render_texture.color);
-    create_pipelines(render_texture.rp);
+    update_ds(&uniform.buffer, render_texture.color);
+    create_pipelines(&render_texture);
 
     set_target_fps(120);
     Color color = BLUE;
@@ -191,20 +193,18 @@ int main()
         update_camera_free(&camera);
 
         begin_frame();
-            rvk_begin_offscreen_render_pass(
-                color.r / 255.0f, color.g / 255.0f, color.b / 255.0f, color.a / 255.0f,
-                render_texture.rp,
-                render_texture.fb,
-                render_texture.extent);
+            rvk_begin_render_texture(
+                render_texture,
+                color.r / 255.0f, color.g / 255.0f, color.b / 255.0f, color.a / 255.0f);
                 begin_mode_3d(camera);
                     update_uniform(&uniform, camera);
-                    draw_shape_multiview(multiview.pl, multiview.pl_layout, multiview.ds, SHAPE_CUBE);
+                    draw_shape_multiview(multiview.pl, multiview.pl_layout, multiview.ds[rvk_get_frame_idx()], SHAPE_CUBE);
                 end_mode_3d();
             rvk_end_render_pass();
 
             rvk_begin_render_pass(0.0f, 0.0f, 0.0f, 1.0f);
                 rvk_cmd_bind_pipeline(viewdisplay.pl, VK_PIPELINE_BIND_POINT_GRAPHICS);
-                rvk_cmd_bind_descriptor_sets(viewdisplay.pl_layout, VK_PIPELINE_BIND_POINT_GRAPHICS, &viewdisplay.ds);
+                rvk_cmd_bind_descriptor_sets(viewdisplay.pl_layout, VK_PIPELINE_BIND_POINT_GRAPHICS, &viewdisplay.ds[0]);
 
                 VkViewport viewport = {
                     .width    = WINDOW_WIDTH/2.0f,
@@ -234,7 +234,7 @@ int main()
 
     rvk_wait_idle();
 
-    rvk_buff_destroy(uniform.buffer);
+    rvk_destroy_frame_buffer(uniform.buffer);
     rvk_destroy_descriptor_set_layout(multiview.ds_layout.handle);
     rvk_destroy_descriptor_set_layout(viewdisplay.ds_layout.handle);
     rvk_descriptor_pool_arena_destroy(arena);
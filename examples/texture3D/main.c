@@ -10,32 +10,19 @@ typedef struct {
 } Texture_Vertex; 
 
 
-// TODO: could this be promoted to an API function?
-void update_texture(Rvk_Texture tex, VkDescriptorSet ds)
+void create_pipeline()
 {
-    VkWriteDescriptorSet write = {
-        .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-        .dstSet = ds,
-        .dstBinding = 0,
-        .descriptorCount = 1,
-        .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-        .pImageInfo = &tex.info,
+    /* create pipeline layout, set 0 is the bindless table and the push constant picks the texture */
+    VkPushConstantRange pk_range = {
+        .stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+        .size = sizeof(Bindless_Push_Const),
     };
-    rvk_update_ds(1, &write);
-}
-
-void create_pipeline(VkDescriptorSetLayout *ds_layout)
-{
-    /* create pipeline layout */
-    VkPushConstantRange pk_range = {.stageFlags = VK_SHADER_STAGE_VERTEX_BIT, .size = sizeof(float16)};
-    VkPipelineLayoutCreateInfo layout_ci = {
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
-        .setLayoutCount = 1,
-        .pSetLayouts = ds_layout,
-        .pushConstantRangeCount = 1,
-        .pPushConstantRanges = &pk_range,
-    };
-    rvk_pl_layout_init(layout_ci, &gfx_pl_layout);
+    VkDescriptorSetLayout bindless_layout = rvk_bindless_layout();
+    rvk_create_pipeline_layout(
+        &gfx_pl_layout,
+        .p_set_layouts = &bindless_layout,
+        .p_push_constant_ranges = &pk_range,
+    );
 
     /* create pipeline */
     VkVertexInputAttributeDescription vert_attrs[] = {
@@ -82,45 +69,32 @@ int main()
         .projection = PERSPECTIVE,
     };
 
+    rvk_enable_bindless();
     init_window(500, 500, "Load texture");
 
     Rvk_Texture matrix = load_texture_from_image("res/matrix.png");
     Rvk_Texture statue = load_texture_from_image("res/statue.jpg");
 
-    /* setup descriptors */
-    VkDescriptorSet matrix_ds, statue_ds;
-    Rvk_Descriptor_Set_Layout texture_layout = {0};
-    Rvk_Descriptor_Pool_Arena arena = {0};
-    rvk_descriptor_pool_arena_init(&arena);
-
-    VkDescriptorSetLayoutBinding binding = {
-        .binding = 0,
-        .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-        .descriptorCount = 1,
-        .stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT,
-    };
-    rvk_ds_layout_init(&binding, 1, &texture_layout);
-
-    rvk_descriptor_pool_arena_alloc_set(&arena, &texture_layout, &matrix_ds);
-    rvk_descriptor_pool_arena_alloc_set(&arena, &texture_layout, &statue_ds);
-    update_texture(matrix, matrix_ds);
-    update_texture(statue, statue_ds);
-    create_pipeline(&texture_layout.handle);
+    /* textures go in the bindless table, draws refer to them by index */
+    uint32_t matrix_idx = rvk_bindless_add_texture(matrix);
+    uint32_t statue_idx = rvk_bindless_add_texture(statue);
+    create_pipeline();
 
     float time = 0.0f;
     while(!window_should_close()) {
         time = get_time();
         begin_drawing(BLACK);
         begin_mode_3d(camera);
+            rvk_bind_bindless(gfx_pl_layout, VK_PIPELINE_BIND_POINT_GRAPHICS);
             rotate_y(time);
             push_matrix();
                 scale(matrix.img.extent.width/(float)matrix.img.extent.height, 1.0f, 1.0f);
-                draw_shape_ex(gfx_pl, gfx_pl_layout, matrix_ds, SHAPE_QUAD);
+                draw_shape_bindless(gfx_pl, gfx_pl_layout, matrix_idx, SHAPE_QUAD);
             pop_matrix();
 
             scale(statue.img.extent.width/(float)statue.img.extent.height, 1.0f, 1.0f);
             translate(0.0f, 0.0f, 1.0f);
-                draw_shape_ex(gfx_pl, gfx_pl_layout, statue_ds, SHAPE_QUAD);
+                draw_shape_bindless(gfx_pl, gfx_pl_layout, statue_idx, SHAPE_QUAD);
             rotate_x(time);
             draw_shape_wireframe(SHAPE_CUBE);
         end_mode_3d();
@@ -128,8 +102,6 @@ int main()
     }
 
     rvk_wait_idle();
-    rvk_destroy_descriptor_set_layout(texture_layout.handle);
-    rvk_descriptor_pool_arena_destroy(arena);
     rvk_unload_texture(matrix);
     rvk_unload_texture(statue);
     rvk_destroy_pl_res(gfx_pl, gfx_pl_layout);
@@ -1,12 +1,20 @@
 #version 450
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout(push_constant) uniform constants
+{
+    mat4 mvp;
+    uint tex_idx;
+} push_const;
 
 layout(location = 0) in vec2 uv;
 
-layout(binding = 0) uniform sampler2D tex_sampler;
+/* bindless table, every texture lives in one array */
+layout(set = 0, binding = 0) uniform sampler2D textures[];
 
 layout(location = 0) out vec4 out_color;
 
 void main()
 {
-    out_color = texture(tex_sampler, uv);
+    out_color = texture(textures[push_const.tex_idx], uv);
 }
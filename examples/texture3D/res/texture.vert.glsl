@@ -3,6 +3,7 @@
 layout(push_constant) uniform constants
 {
     mat4 mvp;
+    uint tex_idx;
 } push_const;
 
 layout(location = 0) in vec3 position;
@@ -39,7 +39,7 @@ typedef struct {
 
 typedef struct {
     UBO_Data data;
-    Rvk_Buffer buff;
+    Rvk_Frame_Buffer buff; // one ubo per frame in flight
 } UBO;
 
 #define OFFSET_COUNT 25
@@ -346,10 +346,8 @@ int main(int argc, char **argv)
     }
 
     UBO ubo = {0};
-    rvk_uniform_buff_init(sizeof(UBO_Data), &ubo.data, &ubo.buff);
-    rvk_buff_map(&ubo.buff);
     ubo.data.tiles_per_side = meshes[mesh_idx].tiles_per_side;
-    memcpy(ubo.buff.mapped, &ubo.data, sizeof(UBO_Data));
+    ubo.buff = rvk_create_mapped_uniform_frame_buff(sizeof(UBO_Data), &ubo.data);
 
     SSBO ssbo = {0};
     if (cfg_file) {
@@ -360,10 +358,7 @@ int main(int argc, char **argv)
     rvk_buff_staged_upload(ssbo.buff);
     Rvk_Buffer copied_buff = {0};
 
-    VkDescriptorSet ds;
     Rvk_Descriptor_Set_Layout ds_layout = {0};
-    Rvk_Descriptor_Pool_Arena arena = {0};
-    rvk_descriptor_pool_arena_init(&arena);
     VkDescriptorSetLayoutBinding bindings[] = {
         {
             .binding = 0,
@@ -385,34 +380,6 @@ int main(int argc, char **argv)
         },
     };
     rvk_ds_layout_init(bindings, RVK_ARRAY_LEN(bindings), &ds_layout);
-    rvk_descriptor_pool_arena_alloc_set(&arena, &ds_layout, &ds);
-    VkWriteDescriptorSet writes[] = {
-        {
-            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .dstSet = ds,
-            .dstBinding = 0,
-            .descriptorCount = 1,
-            .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-            .pBufferInfo = &ubo.buff.info,
-        },
-        {
-            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .dstSet = ds,
-            .dstBinding = 1,
-            .descriptorCount = 1,
-            .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-            .pBufferInfo = &ssbo.buff.info,
-        },
-        {
-            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .dstSet = ds,
-            .dstBinding = 2,
-            .descriptorCount = 1,
-            .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            .pImageInfo = &tex.info,
-        },
-    };
-    rvk_update_ds(RVK_ARRAY_LEN(writes), writes);
 
     Pipeline pl = {0};
     create_pipeline(&pl, &ds_layout.handle);
@@ -475,9 +442,39 @@ int main(int argc, char **argv)
 
         // handle drawing
         begin_drawing(BLACK);
+            /* transient set from the frame's arena, pointing at this frame's ubo */
+            VkDescriptorSet ds;
+            rvk_frame_alloc_set(&ds_layout, &ds);
+            VkWriteDescriptorSet writes[] = {
+                {
+                    .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                    .dstSet = ds,
+                    .dstBinding = 0,
+                    .descriptorCount = 1,
+                    .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+                    .pBufferInfo = &rvk_frame_buff_get(&ubo.buff)->info,
+                },
+                {
+                    .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                    .dstSet = ds,
+                    .dstBinding = 1,
+                    .descriptorCount = 1,
+                    .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                    .pBufferInfo = &ssbo.buff.info,
+                },
+                {
+                    .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                    .dstSet = ds,
+                    .dstBinding = 2,
+                    .descriptorCount = 1,
+                    .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                    .pImageInfo = &tex.info,
+                },
+            };
+            rvk_update_ds(RVK_ARRAY_LEN(writes), writes);
             rvk_bind_gfx(pl.handle, pl.layout, &ds, 1);
             rvk_draw_buffers(meshes[mesh_idx].vtx_buff, meshes[mesh_idx].idx_buff);
-            memcpy(ubo.buff.mapped, &ubo.data, sizeof(UBO_Data));
+            memcpy(rvk_frame_buff_get(&ubo.buff)->mapped, &ubo.data, sizeof(UBO_Data));
         end_drawing();
     }
 
@@ -486,12 +483,11 @@ int main(int argc, char **argv)
         rvk_buff_destroy(meshes[i].vtx_buff);
         rvk_buff_destroy(meshes[i].idx_buff);
     }
-    rvk_buff_destroy(ubo.buff);
+    rvk_destroy_frame_buffer(ubo.buff);
     rvk_buff_destroy(ssbo.buff);
     rvk_buff_destroy(copied_buff);
     rvk_unload_texture(tex);
     rvk_destroy_descriptor_set_layout(ds_layout.handle);
-    rvk_descriptor_pool_arena_destroy(arena);
     rvk_destroy_pl_res(pl.handle, pl.layout);
     close_window();
     return 0;
@@ -0,0 +1,148 @@
+#include "cvr.h"
+#include <stdio.h>
+#include <time.h>
+#include <pthread.h>
+
+/* compares the affine transform stack against the previous implementation, a global Matrix[1024*1024]
+ * where every transform was a full 4x4 MatrixMultiply. no window or vulkan context is needed */
+
+#define ITERATIONS 2000000
+#define OLD_MAX_MAT_STACK (1024 * 1024)
+#define THREAD_COUNT 4
+
+/* the previous stack, shallow here, its real footprint is reported from OLD_MAX_MAT_STACK */
+static Matrix old_stack[MAT_STACK_DEFAULT_DEPTH];
+static size_t old_stack_p = 0;
+
+static double now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void old_push() { old_stack[old_stack_p] = (old_stack_p) ? old_stack[old_stack_p - 1] : MatrixIdentity(); old_stack_p++; }
+static void old_pop() { old_stack_p--; }
+static void old_translate(float x, float y, float z) { old_stack[old_stack_p - 1] = MatrixMultiply(MatrixTranslate(x, y, z), old_stack[old_stack_p - 1]); }
+static void old_rotate_y(float angle) { old_stack[old_stack_p - 1] = MatrixMultiply(MatrixRotateY(angle), old_stack[old_stack_p - 1]); }
+static void old_scale(float x, float y, float z) { old_stack[old_stack_p - 1] = MatrixMultiply(MatrixScale(x, y, z), old_stack[old_stack_p - 1]); }
+static void old_rotate_xyz(Vector3 angle) { old_stack[old_stack_p - 1] = MatrixMultiply(MatrixRotateXYZ(angle), old_stack[old_stack_p - 1]); }
+static void old_look_at(Camera camera)
+{
+    Matrix inv = MatrixInvert(MatrixLookAt(camera.position, camera.target, camera.up));
+    old_stack[old_stack_p - 1] = MatrixMultiply(old_stack[old_stack_p - 1], inv);
+}
+
+/* the same work a scene like waves does per object */
+static float run_old()
+{
+    float sink = 0.0f;
+    old_push();
+    for (int i = 0; i < ITERATIONS; i++) {
+        old_push();
+        old_translate(i * 0.001f, 1.0f, -i * 0.001f);
+        old_rotate_y(i * 0.01f);
+        old_scale(1.0f, 1.5f, 1.0f);
+        sink += old_stack[old_stack_p - 1].m12;
+        old_pop();
+    }
+    old_pop();
+    return sink;
+}
+
+static float run_new()
+{
+    float sink = 0.0f;
+    Matrix tos;
+    push_matrix();
+    for (int i = 0; i < ITERATIONS; i++) {
+        push_matrix();
+        translate(i * 0.001f, 1.0f, -i * 0.001f);
+        rotate_y(i * 0.01f);
+        scale(1.0f, 1.5f, 1.0f);
+        get_matrix_tos(&tos);
+        sink += tos.m12;
+        pop_matrix();
+    }
+    pop_matrix();
+    return sink;
+}
+
+/* largest difference between the two stacks over a mixed sequence, the general transforms
+ * included. both sides round differently, so the results agree closely but not bit for bit */
+static float check_mixed()
+{
+    Camera camera = {
+        .position = {3.0f, 2.0f, -4.0f},
+        .target   = {0.5f, 0.0f, 1.0f},
+        .up       = {0.0f, 1.0f, 0.0f},
+    };
+    Vector3 angles = {0.3f, -1.1f, 0.7f};
+
+    old_push();
+    old_translate(1.0f, -2.0f, 0.5f);
+    old_rotate_y(0.8f);
+    old_look_at(camera);
+    old_rotate_xyz(angles);
+    old_scale(2.0f, 0.5f, 1.5f);
+    old_translate(-0.25f, 3.0f, 1.0f);
+    Matrix old_tos = old_stack[old_stack_p - 1];
+    old_pop();
+
+    Matrix new_tos;
+    push_matrix();
+    translate(1.0f, -2.0f, 0.5f);
+    rotate_y(0.8f);
+    look_at(camera);
+    rotate_xyz(angles);
+    scale(2.0f, 0.5f, 1.5f);
+    translate(-0.25f, 3.0f, 1.0f);
+    get_matrix_tos(&new_tos);
+    pop_matrix();
+
+    float16 a = MatrixToFloatV(old_tos);
+    float16 b = MatrixToFloatV(new_tos);
+    float max_diff = 0.0f;
+    for (int i = 0; i < 16; i++) max_diff = fmaxf(max_diff, fabsf(a.v[i] - b.v[i]));
+    return max_diff;
+}
+
+static void *worker(void *arg)
+{
+    float *sink = arg;
+    *sink = run_new();
+    free_matrix_stack();
+    return NULL;
+}
+
+int main()
+{
+    double start = now();
+    float old_sink = run_old();
+    double old_secs = now() - start;
+
+    start = now();
+    float new_sink = run_new();
+    double new_secs = now() - start;
+
+    /* 3 transforms per iteration */
+    printf("old stack: %8.2f MB, %6.2f ns per transform\n",
+           OLD_MAX_MAT_STACK * sizeof(Matrix) / (1024.0 * 1024.0), old_secs * 1e9 / (3.0 * ITERATIONS));
+    printf("new stack: %8.2f KB per thread, %6.2f ns per transform (includes reading the top back)\n",
+           MAT_STACK_DEFAULT_DEPTH * 12 * sizeof(float) / 1024.0, new_secs * 1e9 / (3.0 * ITERATIONS));
+    printf("results %s (%f vs %f)\n", (fabsf(old_sink - new_sink) <= 1e-3f * fabsf(old_sink)) ? "match" : "differ", old_sink, new_sink);
+    float max_diff = check_mixed();
+    printf("mixed sequence with look_at %s (max element difference %g)\n", (max_diff <= 1e-4f) ? "matches" : "differs", max_diff);
+
+    /* each thread records into its own stack */
+    pthread_t threads[THREAD_COUNT];
+    float sinks[THREAD_COUNT];
+    start = now();
+    for (int i = 0; i < THREAD_COUNT; i++) pthread_create(&threads[i], NULL, worker, &sinks[i]);
+    for (int i = 0; i < THREAD_COUNT; i++) pthread_join(threads[i], NULL);
+    double mt_secs = now() - start;
+    printf("%d threads: %6.2f ns per transform overall\n", THREAD_COUNT, mt_secs * 1e9 / (3.0 * ITERATIONS * THREAD_COUNT));
+
+    free_matrix_stack();
+    return 0;
+}
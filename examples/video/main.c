@@ -45,7 +45,6 @@ typedef enum {
 
 typedef struct {
     Rvk_Texture planes[VIDEO_IDX_COUNT * VIDEO_PLANE_COUNT];
-    Rvk_Buffer stg_buffs[VIDEO_IDX_COUNT * VIDEO_PLANE_COUNT];
     plm_t *plms[VIDEO_IDX_COUNT];
     float aspects[VIDEO_IDX_COUNT];
     plm_frame_t initial_frames[VIDEO_IDX_COUNT];
@@ -165,13 +164,16 @@ bool video_dequeue()
         if (video_queue.size == 0)
             pthread_cond_wait(&video_queue.not_empty, &video_queue.mutex);
 
-        /* dequeue the next four video frames */
+        /* dequeue the next four video frames, all planes go out in a single submission */
+        Rvk_Upload_Batch batch = {0};
+        rvk_begin_upload_batch(&batch);
         for (size_t i = 0; i < VIDEO_IDX_COUNT; i++) {
             plm_frame_t *saved = &video_queue.frames[i + video_queue.tail * VIDEO_IDX_COUNT];
             update_video_texture(saved->y.data, i, VIDEO_PLANE_Y);
             update_video_texture(saved->cb.data, i, VIDEO_PLANE_CB);
             update_video_texture(saved->cr.data, i, VIDEO_PLANE_CR);
         }
+        rvk_end_upload_batch(&batch);
         video_queue.tail = (video_queue.tail + 1) % MAX_QUEUED_FRAMES;
         video_queue.size--;
         pthread_cond_signal(&video_queue.not_full);
@@ -259,13 +261,6 @@ void setup_ds_sets()
 
 void init_video_texture(void *data, int width, int height, size_t vid_idx, Video_Plane_Type vid_plane_type)
 {
-    /* create staging buffer for image */
-    Rvk_Buffer *stg_buff = &video_textures.stg_buffs[vid_plane_type + vid_idx * VIDEO_PLANE_COUNT];
-    size_t size  = width * height * rvk_format_to_size(VK_FORMAT_R8_UNORM);
-    size_t count = width * height;
-    rvk_stage_buff_init(size, count, data, stg_buff);
-    rvk_buff_map(stg_buff);
-
     /* create the image */
     Rvk_Image rvk_img = {
         .extent  = {width, height},
@@ -283,7 +278,7 @@ void init_video_texture(void *data, int width, int height, size_t vid_idx, Video
         VK_IMAGE_LAYOUT_UNDEFINED,
         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
     );
-    rvk_img_copy(rvk_img.handle, stg_buff->handle, rvk_img.extent);
+    rvk_img_upload(rvk_img.handle, rvk_img.extent, VK_FORMAT_R8_UNORM, data);
     rvk_transition_img_layout(
         rvk_img.handle,
         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
@@ -312,17 +307,14 @@ void init_video_texture(void *data, int width, int height, size_t vid_idx, Video
 
 void update_video_texture(void *data, size_t vid_idx, Video_Plane_Type vid_plane_type)
 {
-    /* create staging buffer for image */
-    Rvk_Buffer *stg_buff = &video_textures.stg_buffs[vid_plane_type + vid_idx * VIDEO_PLANE_COUNT];
-    memcpy(stg_buff->mapped, data, stg_buff->size);
-
+    /* plane data goes through the staging ring, no per-frame allocations */
     Rvk_Image rvk_img = video_textures.planes[vid_plane_type + vid_idx * VIDEO_PLANE_COUNT].img;
     rvk_transition_img_layout(
         rvk_img.handle,
         VK_IMAGE_LAYOUT_UNDEFINED,
         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
     );
-    rvk_img_copy(rvk_img.handle, stg_buff->handle, rvk_img.extent);
+    rvk_img_upload(rvk_img.handle, rvk_img.extent, VK_FORMAT_R8_UNORM, data);
     rvk_transition_img_layout(
         rvk_img.handle,
         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
@@ -461,9 +453,12 @@ int main()
                 return 1;
             }
 #else // On the fly decode, i.e. decode now on this thread
+            Rvk_Upload_Batch batch = {0};
+            rvk_begin_upload_batch(&batch);
             for (size_t i = 0; i < VIDEO_IDX_COUNT; i++) {
                 plm_frame_t *frame = plm_decode_video(video_textures.plms[i]);
                 if (!frame) {
+                    rvk_end_upload_batch(&batch);
                     playback_finished = true;
                     rvk_log(RVK_INFO, "playback finished!");
                     return 1;
@@ -473,6 +468,7 @@ int main()
                 update_video_texture(frame->cb.data, i, VIDEO_PLANE_CB);
                 update_video_texture(frame->cr.data, i, VIDEO_PLANE_CR);
             }
+            rvk_end_upload_batch(&batch);
             vid_update_time = 0.0f;
 #endif
         }
@@ -505,7 +501,6 @@ int main()
         free(video_textures.initial_frames[i].cb.data);
         free(video_textures.initial_frames[i].cr.data);
         for (size_t j = 0; j < VIDEO_PLANE_COUNT; j++) {
-            rvk_buff_destroy(video_textures.stg_buffs[j + i * VIDEO_PLANE_COUNT]);
             rvk_unload_texture(video_textures.planes[j + i * VIDEO_PLANE_COUNT]);
         }
     }
@@ -12,6 +12,9 @@ int main()
         .projection = PERSPECTIVE,
     };
 
+    /* solid and wireframe shapes alternate in the grid, the draw list records the solid ones
+     * nearest first, then the wireframes grouped by pipeline */
+    enable_draw_list();
     init_window(800, 800, "Waves");
 
     while (!window_should_close()) {
@@ -27,7 +30,13 @@ int main()
                         translate(i, 1.0f, j);
                         scale(1.0f, sin(2 * time + i / 2.0f) + 1.0f, 1.0f);
                         scale(1.0f, cos(2 * time + j / 2.0f) + 1.0f, 1.0f);
-                        draw_shape_wireframe(shape);
+                        if ((i + j) & 1) {
+                            set_draw_pass(1, DRAW_ORDER_STATE);
+                            draw_shape_wireframe(shape);
+                        } else {
+                            set_draw_pass(0, DRAW_ORDER_FRONT_TO_BACK);
+                            draw_shape(shape);
+                        }
                         pop_matrix();
                     }
                 }
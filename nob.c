@@ -20,12 +20,14 @@ typedef struct {
 typedef enum {
     TARGET_LINUX,
     TARGET_WINDOWS,
+    TARGET_LINUX_HEADLESS,
     TARGET_COUNT,
 } Target;
 
 const char *target_names[TARGET_COUNT] = {
     "linux",
     "windows",
+    "linux-headless",
 };
 
 typedef enum {
@@ -65,6 +67,7 @@ typedef struct {
 } Example;
 
 static const char *default_shader_names[] = {"default.vert.glsl", "default.frag.glsl"};
+static const char *instanced_shader_names[] = {"default.vert.glsl", "default.frag.glsl", "default_instanced.vert.glsl"};
 static const char *default_c_file_names[] = {"main"};
 
 static Example examples[] = {
@@ -90,6 +93,17 @@ static Example examples[] = {
             .count = NOB_ARRAY_LEN(default_c_file_names)
         },
     },
+    {
+        .name = "psychedelic",
+        .shaders = {
+            .names = instanced_shader_names,
+            .count = NOB_ARRAY_LEN(instanced_shader_names)
+        },
+        .c_files = {
+            .names = default_c_file_names,
+            .count = NOB_ARRAY_LEN(default_c_file_names)
+        },
+    },
     {
         .name = "texture3D",
         .shaders = {
@@ -135,6 +149,48 @@ static Example examples[] = {
             .count = NOB_ARRAY_LEN(default_c_file_names)
         },
     },
+    {
+        .name = "gpu_culling",
+        .shaders = {
+            .names = (const char *[]) {
+                "gpu_cull.comp.glsl",
+                "gpu_scene.vert.glsl",
+                "default.frag.glsl",
+            },
+            .count = 3,
+        },
+        .c_files = {
+            .names = default_c_file_names,
+            .count = NOB_ARRAY_LEN(default_c_file_names)
+        },
+    },
+    {
+        .name = "parallel_draw",
+        .shaders = {
+            .names = default_shader_names,
+            .count = NOB_ARRAY_LEN(default_shader_names)
+        },
+        .c_files = {
+            .names = default_c_file_names,
+            .count = NOB_ARRAY_LEN(default_c_file_names)
+        },
+    },
+    {
+        .name = "transform_bench",
+        .shaders = {0},
+        .c_files = {
+            .names = default_c_file_names,
+            .count = NOB_ARRAY_LEN(default_c_file_names)
+        },
+    },
+    {
+        .name = "mat_bench",
+        .shaders = {0},
+        .c_files = {
+            .names = default_c_file_names,
+            .count = NOB_ARRAY_LEN(default_c_file_names)
+        },
+    },
     {
         .name = "point_raster",
         .shaders = {
@@ -295,7 +351,7 @@ void log_usage(const char *program)
     nob_log(NOB_INFO, "    -h help (log usage)");
     nob_log(NOB_INFO, "    -c clean build");
     nob_log(NOB_INFO, "    -l list available examples");
-    nob_log(NOB_INFO, "    -t specify build target (linux, windows, quest)");
+    nob_log(NOB_INFO, "    -t specify build target (linux, windows, linux-headless, quest)");
     nob_log(NOB_INFO, "    -g debug launch (gf2)"); // https://github.com/nakst/gf
     nob_log(NOB_INFO, "    -r renderdoc launch");
     nob_log(NOB_INFO, "    -a forward command line args (e.g. -a 'arg1 arg2 ...')");
@@ -458,6 +514,8 @@ bool build_glfw(Config config, const char *platform_path)
 {
     if (config.target == TARGET_LINUX) {
         return build_glfw_linux(platform_path);
+    } else if (config.target == TARGET_LINUX_HEADLESS) {
+        return true; // no window, so no glfw
     } else if (config.target == TARGET_WINDOWS && config.host == HOST_LINUX) {
         return build_glfw_win(platform_path);
     } else {
@@ -470,7 +528,7 @@ static const char *cvr[] = {
     "core",
 };
 
-bool build_cvr_linux(const char *platform_path)
+bool build_cvr_linux(const char *platform_path, bool headless)
 {
     bool result = true;
     Nob_Cmd cmd = {0};
@@ -489,7 +547,7 @@ bool build_cvr_linux(const char *platform_path)
             nob_needs_rebuild(output_path, &header_path, 1)) {
             cmd.count = 0;
             nob_cmd_append(&cmd, "cc");
-            nob_cmd_append(&cmd, "-DPLATFORM_DESKTOP_GLFW");
+            nob_cmd_append(&cmd, (headless) ? "-DPLATFORM_HEADLESS" : "-DPLATFORM_DESKTOP_GLFW");
             nob_cmd_append(&cmd, "-Werror", "-Wall", "-Wextra", "-g");
             nob_cmd_append(&cmd, "-I./external");
             nob_cmd_append(&cmd, "-I./external/raylib-5.0/glfw/include");
@@ -512,7 +570,7 @@ bool build_cvr_linux(const char *platform_path)
             const char *input_path = nob_temp_sprintf("%s/%s.o", build_path, cvr[i]);
             nob_cmd_append(&cmd, input_path);
         }
-        nob_cmd_append(&cmd, nob_temp_sprintf("%s/glfw/glfw.o", platform_path));
+        if (!headless) nob_cmd_append(&cmd, nob_temp_sprintf("%s/glfw/glfw.o", platform_path));
         if (!nob_cmd_run_sync(cmd)) nob_return_defer(false);
     }
 
@@ -579,8 +637,8 @@ defer:
 
 bool build_cvr(Config *config, const char *platform_path)
 {
-    if (config->target == TARGET_LINUX) {
-        return build_cvr_linux(platform_path);
+    if (config->target == TARGET_LINUX || config->target == TARGET_LINUX_HEADLESS) {
+        return build_cvr_linux(platform_path, config->target == TARGET_LINUX_HEADLESS);
     } else if (config->target == TARGET_WINDOWS && config->host == HOST_LINUX) {
         return build_cvr_win(platform_path);
     } else {
@@ -664,7 +722,9 @@ bool build_example_linux(Config config, const char *build_path)
         nob_cmd_append(&cmd, nob_temp_sprintf("%s/main.c", example_path));
         const char *cvr_path = nob_temp_sprintf("-L./build/%s/cvr", target_names[config.target]);
         nob_cmd_append(&cmd, cvr_path, "-l:libcvr.a");
-        nob_cmd_append(&cmd, "-lvulkan", "-ldl", "-lpthread", "-lX11", "-lXxf86vm", "-lXrandr", "-lXi", "-lm");
+        nob_cmd_append(&cmd, "-lvulkan", "-ldl", "-lpthread", "-lm");
+        if (config.target != TARGET_LINUX_HEADLESS)
+            nob_cmd_append(&cmd, "-lX11", "-lXxf86vm", "-lXrandr", "-lXi");
         if (!nob_cmd_run_sync(cmd)) nob_return_defer(false);
     }
 
@@ -731,7 +791,7 @@ defer:
 
 bool build_example(const char *example_build_path, Config config)
 {
-    if (config.target == TARGET_LINUX) {
+    if (config.target == TARGET_LINUX || config.target == TARGET_LINUX_HEADLESS) {
         return build_example_linux(config, example_build_path);
     } else if (config.target == TARGET_WINDOWS && config.host == HOST_LINUX) {
         return build_example_win(config, example_build_path);
@@ -903,6 +963,7 @@ bool run(Config config, const char *example_build_path)
 
     switch (config.target) {
     case TARGET_LINUX:
+    case TARGET_LINUX_HEADLESS:
         if (!run_example_linux(config, example_build_path)) return false;
         break;
     case TARGET_WINDOWS:
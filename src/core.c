@@ -12,6 +12,9 @@
 #define GEOMETRY_IMPLEMENTATION
 #include "geometry.h"
 
+#define MAT_SIMD_IMPLEMENTATION
+#include "mat_simd.h"
+
 #if defined(_WIN32)
 #include <windows.h>
 #endif
@@ -70,12 +73,12 @@ typedef struct {
     size_t frame_count;
 } Time;
 
+/* every primitive packed into one vertex and one index buffer, so switching shapes needs no rebinds */
 typedef struct {
     Rvk_Buffer vtx_buff;
     Rvk_Buffer idx_buff;
-    const Vertex *verts;
-    const uint16_t *idxs;
-} Shape;
+    Rvk_Draw_Range ranges[SHAPE_COUNT];
+} Shape_Geometry;
 
 typedef struct {
     Rvk_Buffer *items;
@@ -92,6 +95,8 @@ typedef struct {
 typedef enum {
     DEFAULT_PL_FILL,
     DEFAULT_PL_WIREFRAME,
+    DEFAULT_PL_FILL_INSTANCED,
+    DEFAULT_PL_WIREFRAME_INSTANCED,
     DEFAULT_PL_COUNT,
 } Default_Pipeline;
 
@@ -100,15 +105,137 @@ typedef struct {
     VkPipelineLayout layouts[DEFAULT_PL_COUNT];
 } Default_Pipelines;
 
+/* model matrices, turned into mvps in one batch at flush time */
+typedef struct {
+    Matrix *items;
+    size_t count;
+    size_t capacity;
+} Instance_Batch;
+
+#define INSTANCE_BUFF_MIN_COUNT 1024
+typedef struct {
+    Rvk_Buffer buff;  // per-instance mvps, count is the capacity in instances
+    size_t used;      // instances written this frame
+} Instance_Frame;
+
+typedef struct {
+    bool enabled;
+    Instance_Batch batches[2][SHAPE_COUNT]; // fill then wireframe
+    Instance_Frame frames[RVK_MAX_FRAMES_IN_FLIGHT];
+} Instancing;
+
+/* a deferred draw, shape draws keep the shape type and points keep their vertex buffer */
+#define DRAW_CMD_MAX_SETS 4
+typedef struct {
+    float16 mvp;
+    VkPipeline pl;
+    VkPipelineLayout pl_layout;
+    VkDescriptorSet ds[DRAW_CMD_MAX_SETS];
+    uint32_t ds_count;
+    Shape_Type shape;   // SHAPE_COUNT for points
+    VkBuffer vtx_buff;  // points only
+    uint32_t vtx_count; // points only
+} Draw_Cmd;
+
+typedef struct {
+    Draw_Cmd *items;
+    size_t count;
+    size_t capacity;
+} Draw_Cmds;
+
+typedef struct {
+    uint64_t key;
+    uint32_t idx;
+} Draw_Key;
+
+typedef struct {
+    Draw_Key *items;
+    size_t count;
+    size_t capacity;
+} Draw_Keys;
+
+typedef struct {
+    bool enabled;
+    uint32_t pass;
+    Draw_Order order;
+    Draw_Cmds cmds;
+    Draw_Keys keys;
+    Draw_Keys tmp; // radix sort scratch
+} Draw_List;
+
+/* top three rows of an affine 4x4 in raymath's convention (column vectors, translation in
+ * column 3), m[row][col]. the transform functions multiply on the right, so translate, rotate,
+ * and scale act in the local space of what is already on the stack */
+typedef struct {
+    float m[3][4];
+} Affine;
+
+typedef struct {
+    Affine *items;
+    size_t count;
+    size_t capacity; // the stack's depth, never grows
+} Mat_Stack;
+
+#if defined(_MSC_VER)
+    #define CVR_THREAD_LOCAL __declspec(thread)
+#else
+    #define CVR_THREAD_LOCAL _Thread_local
+#endif
+
+/* matches the std430 Object in gpu_cull.comp.glsl and gpu_scene.vert.glsl */
+typedef struct {
+    float16 model;
+    Vector4 bounds; // object space bounding sphere, center then radius
+    uint32_t shape;
+    uint32_t pad[3];
+} Gpu_Object;
+
+typedef struct {
+    Gpu_Object *items;
+    size_t count;
+    size_t capacity;
+} Gpu_Objects;
+
+/* the shape arrays are read as uvec4/ivec4 in gpu_cull.comp.glsl */
+typedef struct {
+    float16 view_proj;
+    uint32_t first_idx[SHAPE_COUNT];
+    uint32_t idx_count[SHAPE_COUNT];
+    int32_t vtx_offset[SHAPE_COUNT];
+    uint32_t object_count;
+} Gpu_Cull_Push_Const;
+_Static_assert(SHAPE_COUNT == 4, "gpu_cull.comp.glsl reads the shape arrays of Gpu_Cull_Push_Const as uvec4/ivec4");
+
+typedef struct {
+    bool enabled;
+    bool culled;                      // cull pass was recorded this frame
+    uint32_t max_objects;
+    Gpu_Objects objects;              // cpu copy of obj_buff
+    size_t dirty_start, dirty_end;    // objects changed since the last upload
+    uint32_t draw_max;                // object count of the last cull pass
+    Rvk_Buffer obj_buff;
+    Rvk_Buffer cmd_buff;              // a VkDrawIndexedIndirectCommand per visible object
+    Rvk_Buffer count_buff;            // visible objects
+    Rvk_Descriptor_Pool_Arena arena;
+    Rvk_Descriptor_Set_Layout ds_layout;
+    VkDescriptorSet ds;
+    VkPipelineLayout cull_pl_layout;
+    VkPipeline cull_pl;
+    VkPipelineLayout draw_pl_layout;
+    VkPipeline draw_pl;
+} Gpu_Scene;
+
 /* core state global to all platforms */
 /* TODO: put the core inside of a struct */
-#define MAX_MAT_STACK 1024 * 1024
-Matrix mat_stack[MAX_MAT_STACK];
-size_t mat_stack_p = 0;
-Shape shapes[SHAPE_COUNT];
+CVR_THREAD_LOCAL Mat_Stack mat_stack = {0};
+size_t mat_stack_depth = MAT_STACK_DEFAULT_DEPTH;
+Shape_Geometry geometry = {0};
 
 #ifndef PLATFORM_QUEST
     Default_Pipelines pipelines = {0};
+    Instancing instancing = {0};
+    Draw_List draw_list = {0};
+    Gpu_Scene gpu_scene = {0};
     Matrices matrices = {0};
     Point_Clouds point_clouds = {0};
     Keyboard keyboard = {0};
@@ -119,6 +246,9 @@ Shape shapes[SHAPE_COUNT];
     bool full_screen = false;
 #else // clang I hate you
     Default_Pipelines pipelines = {};
+    Instancing instancing = {};
+    Draw_List draw_list = {};
+    Gpu_Scene gpu_scene = {};
     Matrices matrices = {};
     Point_Clouds point_clouds = {};
     Keyboard keyboard = {};
@@ -130,14 +260,19 @@ Shape shapes[SHAPE_COUNT];
 #endif
 const char *core_title;
 
-void alloc_shape_res(Shape_Type shape_type);
-bool is_shape_res_alloc(Shape_Type shape_type);
+void shape_res_init();
 void destroy_shape_res();
+void destroy_instancing_res();
+void push_draw_cmd(Draw_Cmd cmd);
+Matrix affine_to_matrix(const Affine *a);
+void destroy_gpu_scene_res();
 
 #if defined(PLATFORM_DESKTOP_GLFW)
     #include "platform_desktop.c"
 #elif defined(PLATFORM_ANDROID_QUEST)
     #include "platform_quest.c"
+#elif defined(PLATFORM_HEADLESS)
+    #include "platform_headless.c"
 #else
     /* alternative backend here */
 #endif
@@ -151,7 +286,9 @@ void init_window(int width, int height, const char *title)
     if (!init_platform())
         assert(0 && "failed to initialize platform");
 
-    rvk_init();
+    /* the size is only used by platforms that don't create their own window (i.e. headless) */
+    rvk_init(.width = win_size.width, .height = win_size.height, .title = title);
+    shape_res_init();
 }
 
 void close_window()
@@ -162,6 +299,12 @@ void close_window()
         rvk_destroy_pl_res(pipelines.handles[i], pipelines.layouts[i]);
 
     destroy_shape_res();
+    destroy_instancing_res();
+    rvk_da_free(draw_list.cmds);
+    rvk_da_free(draw_list.keys);
+    rvk_da_free(draw_list.tmp);
+    destroy_gpu_scene_res();
+    free_matrix_stack();
     rvk_destroy();
     close_platform();
 }
@@ -172,6 +315,40 @@ void enable_full_screen()
     rvk_log(RVK_INFO, "fullscreen mode enabled");
 }
 
+void enable_instancing()
+{
+    instancing.enabled = true;
+    rvk_log(RVK_INFO, "instancing enabled");
+}
+
+void enable_draw_list()
+{
+    draw_list.enabled = true;
+    rvk_log(RVK_INFO, "draw list enabled");
+}
+
+void enable_gpu_scene(uint32_t max_objects)
+{
+    if (rvk_ctx.device) {
+        rvk_log(RVK_ERROR, "enable_gpu_scene must be called before init_window");
+        return;
+    }
+    gpu_scene.enabled = true;
+    gpu_scene.max_objects = max_objects;
+    rvk_enable_draw_indirect();
+    rvk_log(RVK_INFO, "gpu scene enabled for %u objects", max_objects);
+}
+
+void set_draw_pass(uint32_t pass, Draw_Order order)
+{
+    if (pass > 0xf) {
+        rvk_log(RVK_WARNING, "draw pass %u clamped to 15", pass);
+        pass = 0xf;
+    }
+    draw_list.pass = pass;
+    draw_list.order = order;
+}
+
 void default_pl_fill_init()
 {
     /* create pipeline layout */
@@ -224,50 +401,79 @@ void default_pl_fill_init()
 bool draw_shape(Shape_Type shape_type)
 {
     /* create basic shape pipeline if it hasn't been created */
-    if (!pipelines.handles[DEFAULT_PL_FILL]) default_pl_fill_init();
-    if (!is_shape_res_alloc(shape_type)) alloc_shape_res(shape_type);
+    if (!instancing.enabled && !pipelines.handles[DEFAULT_PL_FILL]) default_pl_fill_init();
 
     Matrix model = {0};
-    if (mat_stack_p) {
-        model = mat_stack[mat_stack_p - 1];
+    if (mat_stack.count) {
+        model = affine_to_matrix(&mat_stack.items[mat_stack.count - 1]);
     } else {
         rvk_log(RVK_ERROR, "No matrix stack, cannot draw.");
         return false;
     }
 
-    Rvk_Buffer vtx_buff = shapes[shape_type].vtx_buff;
-    Rvk_Buffer idx_buff = shapes[shape_type].idx_buff;
-    Matrix mvp = MatrixMultiply(model, matrices.view_proj);
-    float16 f16_mvp = MatrixToFloatV(mvp);
+    if (instancing.enabled) {
+        rvk_da_append(&instancing.batches[0][shape_type], model);
+        return true;
+    }
+    float16 f16_mvp = mat_mul_float16(model, matrices.view_proj);
+    if (draw_list.enabled) {
+        push_draw_cmd((Draw_Cmd){
+            .mvp = f16_mvp,
+            .pl = pipelines.handles[DEFAULT_PL_FILL],
+            .pl_layout = pipelines.layouts[DEFAULT_PL_FILL],
+            .shape = shape_type,
+        });
+        return true;
+    }
 
     rvk_bind_gfx(pipelines.handles[DEFAULT_PL_FILL], pipelines.layouts[DEFAULT_PL_FILL], NULL, 0);
     rvk_push_const(pipelines.layouts[DEFAULT_PL_FILL], VK_SHADER_STAGE_VERTEX_BIT, sizeof(float16), &f16_mvp);
-    rvk_draw_buffers(vtx_buff, idx_buff);
+    rvk_draw_buffers_range(geometry.vtx_buff, geometry.idx_buff, geometry.ranges[shape_type]);
 
     return true;
 }
 
 void draw_shape_ex(VkPipeline pl, VkPipelineLayout pl_layout, VkDescriptorSet ds, Shape_Type shape)
 {
-    if (!is_shape_res_alloc(shape)) alloc_shape_res(shape);
-
     Matrix model = {0};
-    if (mat_stack_p) {
-        model = mat_stack[mat_stack_p - 1];
+    if (mat_stack.count) {
+        model = affine_to_matrix(&mat_stack.items[mat_stack.count - 1]);
     } else {
         rvk_log(RVK_ERROR, "No matrix stack, cannot draw.");
         return;
     }
 
-    Matrix mvp = MatrixMultiply(model, matrices.view_proj);
-    float16 f16_mvp = MatrixToFloatV(mvp);
-    Rvk_Buffer vtx_buff = shapes[shape].vtx_buff;
-    Rvk_Buffer idx_buff = shapes[shape].idx_buff;
+    float16 f16_mvp = mat_mul_float16(model, matrices.view_proj);
+    if (draw_list.enabled) {
+        push_draw_cmd((Draw_Cmd){
+            .mvp = f16_mvp,
+            .pl = pl,
+            .pl_layout = pl_layout,
+            .ds = {ds},
+            .ds_count = (ds) ? 1 : 0,
+            .shape = shape,
+        });
+        return;
+    }
 
     if (ds) rvk_bind_gfx(pl, pl_layout, &ds, 1);
     else rvk_bind_gfx(pl, pl_layout, NULL, 0);
     rvk_push_const(pl_layout, VK_SHADER_STAGE_VERTEX_BIT, sizeof(float16), &f16_mvp);
-    rvk_draw_buffers(vtx_buff, idx_buff);
+    rvk_draw_buffers_range(geometry.vtx_buff, geometry.idx_buff, geometry.ranges[shape]);
+}
+
+void draw_shape_bindless(VkPipeline pl, VkPipelineLayout pl_layout, uint32_t idx, Shape_Type shape)
+{
+    if (!mat_stack.count) {
+        rvk_log(RVK_ERROR, "No matrix stack, cannot draw.");
+        return;
+    }
+
+    Matrix model = affine_to_matrix(&mat_stack.items[mat_stack.count - 1]);
+    Bindless_Push_Const pk = {.mvp = mat_mul_float16(model, matrices.view_proj), .idx = idx};
+    rvk_bind_gfx(pl, pl_layout, NULL, 0);
+    rvk_push_const(pl_layout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, sizeof(pk), &pk);
+    rvk_draw_buffers_range(geometry.vtx_buff, geometry.idx_buff, geometry.ranges[shape]);
 }
 
 void default_pl_wireframe_init()
@@ -322,29 +528,469 @@ void default_pl_wireframe_init()
 bool draw_shape_wireframe(Shape_Type shape_type)
 {
     /* create basic wireframe pipeline if it hasn't been created */
-    if (!pipelines.handles[DEFAULT_PL_WIREFRAME]) default_pl_wireframe_init();
-    if (!is_shape_res_alloc(shape_type)) alloc_shape_res(shape_type);
+    if (!instancing.enabled && !pipelines.handles[DEFAULT_PL_WIREFRAME]) default_pl_wireframe_init();
 
-    Rvk_Buffer vtx_buff = shapes[shape_type].vtx_buff;
-    Rvk_Buffer idx_buff = shapes[shape_type].idx_buff;
     Matrix model = {0};
-    if (mat_stack_p) {
-        model = mat_stack[mat_stack_p - 1];
+    if (mat_stack.count) {
+        model = affine_to_matrix(&mat_stack.items[mat_stack.count - 1]);
     } else {
         rvk_log(RVK_ERROR, "No matrix stack, cannot draw.");
         return false;
     }
 
-    Matrix mvp = MatrixMultiply(model, matrices.view_proj);
-    float16 f16_mvp = MatrixToFloatV(mvp);
+    if (instancing.enabled) {
+        rvk_da_append(&instancing.batches[1][shape_type], model);
+        return true;
+    }
+    float16 f16_mvp = mat_mul_float16(model, matrices.view_proj);
+    if (draw_list.enabled) {
+        push_draw_cmd((Draw_Cmd){
+            .mvp = f16_mvp,
+            .pl = pipelines.handles[DEFAULT_PL_WIREFRAME],
+            .pl_layout = pipelines.layouts[DEFAULT_PL_WIREFRAME],
+            .shape = shape_type,
+        });
+        return true;
+    }
 
     rvk_bind_gfx(pipelines.handles[DEFAULT_PL_WIREFRAME], pipelines.layouts[DEFAULT_PL_WIREFRAME], NULL, 0);
     rvk_push_const(pipelines.layouts[DEFAULT_PL_WIREFRAME], VK_SHADER_STAGE_VERTEX_BIT, sizeof(float16), &f16_mvp);
-    rvk_draw_buffers(vtx_buff, idx_buff);
+    rvk_draw_buffers_range(geometry.vtx_buff, geometry.idx_buff, geometry.ranges[shape_type]);
 
     return true;
 }
 
+void default_pl_instanced_init(Default_Pipeline pl, VkPolygonMode polygon_mode)
+{
+    /* the mvp comes from the instance buffer, so there are no push constants */
+    VkPipelineLayoutCreateInfo layout_ci = {.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO};
+    rvk_pl_layout_init(layout_ci, &pipelines.layouts[pl]);
+
+    /* create pipeline, the mat4 at location 3 takes up locations 3 through 6 */
+    VkVertexInputAttributeDescription vert_attrs[] = {
+        {.location = 0, .binding = 0, .format = VK_FORMAT_R32G32B32_SFLOAT,    .offset = offsetof(Vertex, pos)},
+        {.location = 1, .binding = 0, .format = VK_FORMAT_R32G32B32_SFLOAT,    .offset = offsetof(Vertex, color)},
+        {.location = 2, .binding = 0, .format = VK_FORMAT_R32G32_SFLOAT,       .offset = offsetof(Vertex, tex_coord)},
+        {.location = 3, .binding = 1, .format = VK_FORMAT_R32G32B32A32_SFLOAT, .offset = 0 * sizeof(Vector4)},
+        {.location = 4, .binding = 1, .format = VK_FORMAT_R32G32B32A32_SFLOAT, .offset = 1 * sizeof(Vector4)},
+        {.location = 5, .binding = 1, .format = VK_FORMAT_R32G32B32A32_SFLOAT, .offset = 2 * sizeof(Vector4)},
+        {.location = 6, .binding = 1, .format = VK_FORMAT_R32G32B32A32_SFLOAT, .offset = 3 * sizeof(Vector4)},
+    };
+    VkVertexInputBindingDescription vert_bindings[] = {
+        {.binding = 0, .inputRate = VK_VERTEX_INPUT_RATE_VERTEX,   .stride = sizeof(Vertex)},
+        {.binding = 1, .inputRate = VK_VERTEX_INPUT_RATE_INSTANCE, .stride = sizeof(float16)},
+    };
+    Pipeline_Config config = {
+        .pl_layout = pipelines.layouts[pl],
+        .vert = "./res/default_instanced.vert.glsl.spv",
+        .frag = "./res/default.frag.glsl.spv",
+        .topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST,
+        .polygon_mode = polygon_mode,
+        .vert_attrs = vert_attrs,
+        .vert_attr_count = RVK_ARRAY_LEN(vert_attrs),
+        .vert_bindings = vert_bindings,
+        .vert_binding_count = RVK_ARRAY_LEN(vert_bindings),
+    };
+    rvk_basic_pl_init(config, &pipelines.handles[pl]);
+}
+
+/* room for count more instances in this frame's instance buffer, returns the first instance */
+size_t reserve_instances(Instance_Frame *frame, size_t count)
+{
+    if (frame->used + count > frame->buff.count) {
+        /* earlier flushes this frame still point at the old buffer, rag_vk defers its destruction */
+        if (frame->buff.handle) rvk_buff_destroy(frame->buff);
+        size_t capacity = (frame->buff.count) ? frame->buff.count * 2 : INSTANCE_BUFF_MIN_COUNT;
+        while (capacity < count) capacity *= 2;
+        frame->buff = rvk_create_mapped_vertex_buff(capacity * sizeof(float16), capacity);
+        frame->used = 0;
+    }
+
+    size_t first = frame->used;
+    frame->used += count;
+    return first;
+}
+
+void flush_instances()
+{
+    static const Default_Pipeline instanced_pls[] = {DEFAULT_PL_FILL_INSTANCED, DEFAULT_PL_WIREFRAME_INSTANCED};
+    static const VkPolygonMode polygon_modes[] = {VK_POLYGON_MODE_FILL, VK_POLYGON_MODE_LINE};
+
+    Instance_Frame *frame = &instancing.frames[rvk_get_frame_idx()];
+    for (size_t i = 0; i < RVK_ARRAY_LEN(instanced_pls); i++) {
+        Default_Pipeline pl = instanced_pls[i];
+        for (size_t shape = 0; shape < SHAPE_COUNT; shape++) {
+            Instance_Batch *batch = &instancing.batches[i][shape];
+            if (!batch->count) continue;
+            if (!pipelines.handles[pl]) default_pl_instanced_init(pl, polygon_modes[i]);
+
+            size_t first = reserve_instances(frame, batch->count);
+            mat_mul_batch_float16(batch->items, matrices.view_proj, (float16 *)frame->buff.mapped + first, batch->count);
+
+            rvk_bind_gfx(pipelines.handles[pl], pipelines.layouts[pl], NULL, 0);
+            rvk_draw_buffers_instanced(
+                geometry.vtx_buff, geometry.idx_buff, geometry.ranges[shape],
+                frame->buff, first * sizeof(float16), batch->count
+            );
+            batch->count = 0;
+        }
+    }
+}
+
+/* the frame's fence has signaled, so its instance buffer is free to reuse */
+void reset_instances()
+{
+    instancing.frames[rvk_get_frame_idx()].used = 0;
+}
+
+/* folds a vulkan handle down to a 12 bit key field, collisions only cost grouping */
+uint64_t draw_key_id(uint64_t handle)
+{
+    return (handle * 0x9E3779B97F4A7C15ull) >> 52;
+}
+
+/* post projection depth of the model origin, quantized to 24 bits */
+uint64_t draw_key_depth(const float16 *mvp)
+{
+    float z = mvp->v[14];
+    float w = mvp->v[15];
+    float depth = (w != 0.0f) ? z / w : z;
+    depth = clamp(depth * 0.5f + 0.5f, 0.0f, 1.0f);
+    return (uint64_t)(depth * 0xffffff);
+}
+
+/* pass | pipeline | descriptor sets | buffers | depth, or with depth moved
+ * just below the pass when sorting by distance */
+void push_draw_cmd(Draw_Cmd cmd)
+{
+    uint64_t ds_hash = 0;
+    for (uint32_t i = 0; i < cmd.ds_count; i++)
+        ds_hash = ds_hash * 31 + (uint64_t)(uintptr_t)cmd.ds[i];
+    uint64_t buff = (cmd.shape == SHAPE_COUNT) ? (uint64_t)(uintptr_t)cmd.vtx_buff : (uint64_t)cmd.shape + 1;
+
+    uint64_t pass  = (uint64_t)draw_list.pass << 60;
+    uint64_t state = draw_key_id((uint64_t)(uintptr_t)cmd.pl) << 24 | draw_key_id(ds_hash) << 12 | draw_key_id(buff);
+    uint64_t depth = draw_key_depth(&cmd.mvp);
+
+    uint64_t key = 0;
+    switch (draw_list.order) {
+    case DRAW_ORDER_STATE:         key = pass | state << 24 | depth;              break;
+    case DRAW_ORDER_FRONT_TO_BACK: key = pass | depth << 36 | state;              break;
+    case DRAW_ORDER_BACK_TO_FRONT: key = pass | (0xffffff - depth) << 36 | state; break;
+    }
+
+    rvk_da_append(&draw_list.keys, ((Draw_Key){.key = key, .idx = draw_list.cmds.count}));
+    rvk_da_append(&draw_list.cmds, cmd);
+}
+
+/* lsd radix sort, one byte per pass, skipping bytes every key shares. it is stable,
+ * so draws with equal keys keep their call order */
+void sort_draw_keys(Draw_Keys *keys, Draw_Keys *tmp)
+{
+    size_t count = keys->count;
+    if (tmp->capacity < count) rvk_da_resize(tmp, count);
+    tmp->count = count;
+
+    Draw_Key *src = keys->items;
+    Draw_Key *dst = tmp->items;
+    for (uint32_t shift = 0; shift < 64; shift += 8) {
+        size_t offsets[256] = {0};
+        for (size_t i = 0; i < count; i++)
+            offsets[(src[i].key >> shift) & 0xff]++;
+        if (offsets[(src[0].key >> shift) & 0xff] == count) continue;
+
+        size_t total = 0;
+        for (size_t i = 0; i < 256; i++) {
+            size_t n = offsets[i];
+            offsets[i] = total;
+            total += n;
+        }
+        for (size_t i = 0; i < count; i++)
+            dst[offsets[(src[i].key >> shift) & 0xff]++] = src[i];
+
+        Draw_Key *swap = src;
+        src = dst;
+        dst = swap;
+    }
+
+    if (src != keys->items) memcpy(keys->items, src, count * sizeof(*src));
+}
+
+void flush_draw_list()
+{
+    if (!draw_list.cmds.count) return;
+
+    /* the state tracker in rag_vk drops the binds that repeat between neighbours */
+    sort_draw_keys(&draw_list.keys, &draw_list.tmp);
+    for (size_t i = 0; i < draw_list.keys.count; i++) {
+        Draw_Cmd *cmd = &draw_list.cmds.items[draw_list.keys.items[i].idx];
+        if (cmd->shape == SHAPE_COUNT) {
+            Rvk_Buffer vtx_buff = {.handle = cmd->vtx_buff, .count = cmd->vtx_count};
+            rvk_draw_points(vtx_buff, &cmd->mvp, cmd->pl, cmd->pl_layout, cmd->ds, cmd->ds_count);
+            continue;
+        }
+        rvk_bind_gfx(cmd->pl, cmd->pl_layout, cmd->ds, cmd->ds_count);
+        rvk_push_const(cmd->pl_layout, VK_SHADER_STAGE_VERTEX_BIT, sizeof(float16), &cmd->mvp);
+        rvk_draw_buffers_range(geometry.vtx_buff, geometry.idx_buff, geometry.ranges[cmd->shape]);
+    }
+
+    draw_list.cmds.count = 0;
+    draw_list.keys.count = 0;
+}
+
+/* object space bounding sphere of a shape's vertices */
+Vector4 get_shape_bounds(Shape_Type shape)
+{
+    const Vertex *verts = primitives[shape].vtx_buff.items;
+    size_t count = primitives[shape].vtx_buff.count;
+    Vector3 min = verts[0].pos;
+    Vector3 max = verts[0].pos;
+    for (size_t i = 1; i < count; i++) {
+        min = Vector3Min(min, verts[i].pos);
+        max = Vector3Max(max, verts[i].pos);
+    }
+
+    Vector3 center = Vector3Scale(Vector3Add(min, max), 0.5f);
+    float radius = 0.0f;
+    for (size_t i = 0; i < count; i++)
+        radius = fmaxf(radius, Vector3Distance(center, verts[i].pos));
+
+    return (Vector4){center.x, center.y, center.z, radius};
+}
+
+uint32_t add_gpu_object(Shape_Type shape, Matrix transform)
+{
+    if (!gpu_scene.enabled) {
+        rvk_log(RVK_ERROR, "gpu scene was not enabled, call enable_gpu_scene() before init_window");
+        return GPU_OBJECT_NONE;
+    }
+    if (gpu_scene.objects.count >= gpu_scene.max_objects) {
+        rvk_log(RVK_ERROR, "gpu scene is full (%u objects)", gpu_scene.max_objects);
+        return GPU_OBJECT_NONE;
+    }
+
+    uint32_t id = gpu_scene.objects.count;
+    Gpu_Object obj = {
+        .model = MatrixToFloatV(transform),
+        .bounds = get_shape_bounds(shape),
+        .shape = shape,
+    };
+    rvk_da_append(&gpu_scene.objects, obj);
+
+    if (gpu_scene.dirty_start == gpu_scene.dirty_end) gpu_scene.dirty_start = id;
+    gpu_scene.dirty_end = id + 1;
+    return id;
+}
+
+void set_gpu_object_transform(uint32_t id, Matrix transform)
+{
+    if (id >= gpu_scene.objects.count) {
+        rvk_log(RVK_ERROR, "gpu object %u does not exist", id);
+        return;
+    }
+
+    gpu_scene.objects.items[id].model = MatrixToFloatV(transform);
+    if (gpu_scene.dirty_start == gpu_scene.dirty_end) {
+        gpu_scene.dirty_start = id;
+        gpu_scene.dirty_end = id + 1;
+    } else {
+        gpu_scene.dirty_start = (id < gpu_scene.dirty_start) ? id : gpu_scene.dirty_start;
+        gpu_scene.dirty_end = (id + 1 > gpu_scene.dirty_end) ? id + 1 : gpu_scene.dirty_end;
+    }
+}
+
+void gpu_scene_res_init()
+{
+    size_t max = gpu_scene.max_objects;
+    rvk_comp_buff_init(max * sizeof(Gpu_Object), max, NULL, &gpu_scene.obj_buff);
+    gpu_scene.cmd_buff = rvk_create_indirect_buff(max * sizeof(VkDrawIndexedIndirectCommand), max);
+    gpu_scene.count_buff = rvk_create_indirect_buff(sizeof(uint32_t), 1);
+
+    VkDescriptorSetLayoutBinding bindings[] = {
+        {
+            .binding = 0,
+            .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            .descriptorCount = 1,
+            .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_VERTEX_BIT,
+        },
+        {
+            .binding = 1,
+            .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            .descriptorCount = 1,
+            .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+        },
+        {
+            .binding = 2,
+            .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            .descriptorCount = 1,
+            .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+        },
+    };
+    rvk_ds_layout_init(bindings, RVK_ARRAY_LEN(bindings), &gpu_scene.ds_layout);
+    rvk_descriptor_pool_arena_init(&gpu_scene.arena);
+    rvk_descriptor_pool_arena_alloc_set(&gpu_scene.arena, &gpu_scene.ds_layout, &gpu_scene.ds);
+
+    Rvk_Buffer *buffs[] = {&gpu_scene.obj_buff, &gpu_scene.cmd_buff, &gpu_scene.count_buff};
+    VkWriteDescriptorSet writes[RVK_ARRAY_LEN(buffs)];
+    for (uint32_t i = 0; i < RVK_ARRAY_LEN(buffs); i++) {
+        writes[i] = (VkWriteDescriptorSet){
+            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+            .dstSet = gpu_scene.ds,
+            .dstBinding = i,
+            .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            .descriptorCount = 1,
+            .pBufferInfo = &buffs[i]->info,
+        };
+    }
+    rvk_update_ds(RVK_ARRAY_LEN(writes), writes);
+
+    /* cull pipeline */
+    VkPushConstantRange cull_range = {
+        .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+        .size = sizeof(Gpu_Cull_Push_Const),
+    };
+    VkPipelineLayoutCreateInfo layout_ci = {
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+        .setLayoutCount = 1,
+        .pSetLayouts = &gpu_scene.ds_layout.handle,
+        .pushConstantRangeCount = 1,
+        .pPushConstantRanges = &cull_range,
+    };
+    rvk_pl_layout_init(layout_ci, &gpu_scene.cull_pl_layout);
+    rvk_compute_pl_init("./res/gpu_cull.comp.glsl.spv", gpu_scene.cull_pl_layout, &gpu_scene.cull_pl);
+
+    /* draw pipeline, the model matrix comes from the object the instance index points at */
+    VkPushConstantRange draw_range = {
+        .stageFlags = VK_SHADER_STAGE_VERTEX_BIT,
+        .size = sizeof(float16),
+    };
+    layout_ci.pPushConstantRanges = &draw_range;
+    rvk_pl_layout_init(layout_ci, &gpu_scene.draw_pl_layout);
+
+    VkVertexInputAttributeDescription vert_attrs[] = {
+        {.location = 0, .format = VK_FORMAT_R32G32B32_SFLOAT, .offset = offsetof(Vertex, pos)},
+        {.location = 1, .format = VK_FORMAT_R32G32B32_SFLOAT, .offset = offsetof(Vertex, color)},
+        {.location = 2, .format = VK_FORMAT_R32G32_SFLOAT,    .offset = offsetof(Vertex, tex_coord)},
+    };
+    VkVertexInputBindingDescription vert_bindings = {
+        .inputRate = VK_VERTEX_INPUT_RATE_VERTEX,
+        .stride    = sizeof(Vertex),
+    };
+    Pipeline_Config config = {
+        .pl_layout = gpu_scene.draw_pl_layout,
+        .vert = "./res/gpu_scene.vert.glsl.spv",
+        .frag = "./res/default.frag.glsl.spv",
+        .topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST,
+        .polygon_mode = VK_POLYGON_MODE_FILL,
+        .vert_attrs = vert_attrs,
+        .vert_attr_count = RVK_ARRAY_LEN(vert_attrs),
+        .vert_bindings = &vert_bindings,
+        .vert_binding_count = 1,
+    };
+    rvk_basic_pl_init(config, &gpu_scene.draw_pl);
+}
+
+void cull_gpu_scene(Camera camera)
+{
+    if (!gpu_scene.enabled) {
+        rvk_log(RVK_ERROR, "gpu scene was not enabled, call enable_gpu_scene() before init_window");
+        return;
+    }
+    if (!gpu_scene.obj_buff.handle) gpu_scene_res_init();
+
+    /* the previous frame may still be reading what this frame is about to write */
+    rvk_mem_barrier(
+        VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_ACCESS_SHADER_WRITE_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_ACCESS_TRANSFER_WRITE_BIT
+    );
+
+    if (gpu_scene.dirty_start != gpu_scene.dirty_end) {
+        size_t count = gpu_scene.dirty_end - gpu_scene.dirty_start;
+        rvk_frame_buff_upload(
+            gpu_scene.obj_buff, gpu_scene.dirty_start * sizeof(Gpu_Object),
+            &gpu_scene.objects.items[gpu_scene.dirty_start], count * sizeof(Gpu_Object)
+        );
+        gpu_scene.dirty_start = gpu_scene.dirty_end = 0;
+    }
+    vkCmdFillBuffer(rvk_ctx.cmd_buff, gpu_scene.count_buff.handle, 0, VK_WHOLE_SIZE, 0);
+    /* without a draw count every command is drawn, the ones culling skipped must be empty */
+    if (!rvk_ctx.features.draw_indirect_count)
+        vkCmdFillBuffer(rvk_ctx.cmd_buff, gpu_scene.cmd_buff.handle, 0, VK_WHOLE_SIZE, 0);
+
+    rvk_mem_barrier(
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_ACCESS_TRANSFER_WRITE_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT
+    );
+
+    Matrix view = MatrixLookAt(camera.position, camera.target, camera.up);
+    Gpu_Cull_Push_Const pk = {
+        .view_proj = mat_mul_float16(view, get_proj(camera)),
+        .object_count = gpu_scene.objects.count,
+    };
+    for (size_t shape = 0; shape < SHAPE_COUNT; shape++) {
+        pk.first_idx[shape]  = geometry.ranges[shape].first_idx;
+        pk.idx_count[shape]  = geometry.ranges[shape].idx_count;
+        pk.vtx_offset[shape] = geometry.ranges[shape].vtx_offset;
+    }
+    gpu_scene.draw_max = pk.object_count;
+    rvk_push_const(gpu_scene.cull_pl_layout, VK_SHADER_STAGE_COMPUTE_BIT, sizeof(pk), &pk);
+    rvk_dispatch(gpu_scene.cull_pl, gpu_scene.cull_pl_layout, gpu_scene.ds, (pk.object_count + 63) / 64, 1, 1);
+
+    rvk_mem_barrier(
+        VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+        VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+        VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT
+    );
+    gpu_scene.culled = true;
+}
+
+void draw_gpu_scene()
+{
+    if (!gpu_scene.culled) {
+        rvk_log(RVK_WARNING, "draw_gpu_scene without cull_gpu_scene this frame, nothing drawn");
+        return;
+    }
+
+    float16 view_proj = MatrixToFloatV(matrices.view_proj);
+    rvk_bind_gfx(gpu_scene.draw_pl, gpu_scene.draw_pl_layout, &gpu_scene.ds, 1);
+    rvk_push_const(gpu_scene.draw_pl_layout, VK_SHADER_STAGE_VERTEX_BIT, sizeof(float16), &view_proj);
+    if (!gpu_scene.draw_max) return;
+    rvk_draw_indexed_indirect_count(
+        geometry.vtx_buff, geometry.idx_buff,
+        gpu_scene.cmd_buff, 0, gpu_scene.count_buff, 0, gpu_scene.draw_max
+    );
+}
+
+void destroy_gpu_scene_res()
+{
+    rvk_da_free(gpu_scene.objects);
+    if (!gpu_scene.obj_buff.handle) return;
+
+    rvk_buff_destroy(gpu_scene.obj_buff);
+    rvk_buff_destroy(gpu_scene.cmd_buff);
+    rvk_buff_destroy(gpu_scene.count_buff);
+    rvk_descriptor_pool_arena_destroy(gpu_scene.arena);
+    rvk_destroy_descriptor_set_layout(gpu_scene.ds_layout.handle);
+    rvk_destroy_pl_res(gpu_scene.cull_pl, gpu_scene.cull_pl_layout);
+    rvk_destroy_pl_res(gpu_scene.draw_pl, gpu_scene.draw_pl_layout);
+}
+
+void destroy_instancing_res()
+{
+    for (size_t i = 0; i < RVK_MAX_FRAMES_IN_FLIGHT; i++) {
+        Instance_Frame *frame = &instancing.frames[i];
+        if (frame->buff.handle) rvk_buff_destroy(frame->buff);
+    }
+    for (size_t i = 0; i < 2; i++)
+        for (size_t shape = 0; shape < SHAPE_COUNT; shape++)
+            rvk_da_free(instancing.batches[i][shape]);
+}
+
 Matrix get_proj(Camera camera)
 {
     Matrix proj = {0};
@@ -396,7 +1042,7 @@ void begin_mode_3d(Camera camera)
 {
     matrices.proj = get_proj(camera);
     matrices.view = MatrixLookAt(camera.position, camera.target, camera.up);
-    matrices.view_proj = MatrixMultiply(matrices.view, matrices.proj);
+    matrices.view_proj = mat_mul(matrices.view, matrices.proj);
 
     push_matrix();
 }
@@ -412,7 +1058,7 @@ bool get_mvp(Matrix *mvp)
 
     Matrix model = {0};
     if (!get_matrix_tos(&model)) rvk_return_defer(false);
-    *mvp = MatrixMultiply(model, matrices.view_proj);
+    *mvp = mat_mul(model, matrices.view_proj);
 
 defer:
     return result;
@@ -487,9 +1133,23 @@ void begin_frame()
 {
     begin_timer();
     rvk_wait_to_begin_gfx();
+    if (instancing.enabled) reset_instances();
+    gpu_scene.culled = false;
     rvk_begin_rec_gfx();
 }
 
+void begin_compute()
+{
+    rvk_begin_rec_compute();
+}
+
+void end_compute()
+{
+    /* the compute resources are per frame in flight, only the graphics that last used this
+     * frame's copies has to be done, the previous frame's graphics keeps running alongside */
+    rvk_submit_compute(rvk_frame_gfx_value());
+}
+
 void begin_drawing(Color color)
 {
     begin_frame();
@@ -506,38 +1166,106 @@ void end_frame()
 
 void end_drawing()
 {
+    if (instancing.enabled) flush_instances();
+    if (draw_list.enabled) flush_draw_list();
     rvk_end_render_pass();
     end_frame();
 }
 
+void begin_drawing_parallel(Color color)
+{
+    begin_frame();
+    rvk_begin_parallel_render_pass(color.r / 255.0f, color.g / 255.0f, color.b / 255.0f, color.a / 255.0f);
+}
+
+typedef struct {
+    Rvk_Record_Fn record;
+    void *data;
+    bool has_top;
+    Affine top;
+} Parallel_Record;
+
+/* every slice gets a matrix stack of its own, slice 0 runs on the caller's thread so its stack is put back */
+void record_parallel_slice(uint32_t idx, uint32_t thread_count, void *data)
+{
+    Parallel_Record *rec = data;
+    Mat_Stack saved = mat_stack;
+    mat_stack = (Mat_Stack){0};
+    if (rec->has_top) {
+        push_matrix();
+        mat_stack.items[0] = rec->top;
+    }
+    rec->record(idx, thread_count, rec->data);
+    free_matrix_stack();
+    mat_stack = saved;
+}
+
+void record_parallel(uint32_t thread_count, Rvk_Record_Fn record, void *data)
+{
+    if (instancing.enabled || draw_list.enabled) {
+        rvk_log(RVK_ERROR, "record_parallel cannot be used with instancing or the draw list");
+        return;
+    }
+    /* the default pipelines are created on first use, not from several threads at once */
+    if (!pipelines.handles[DEFAULT_PL_FILL]) default_pl_fill_init();
+    if (!pipelines.handles[DEFAULT_PL_WIREFRAME]) default_pl_wireframe_init();
+
+    Parallel_Record rec = {.record = record, .data = data, .has_top = mat_stack.count > 0};
+    if (rec.has_top) rec.top = mat_stack.items[mat_stack.count - 1];
+    rvk_record_parallel(thread_count, record_parallel_slice, &rec);
+}
+
+void set_matrix_stack_depth(size_t depth)
+{
+    if (!depth) {
+        rvk_log(RVK_ERROR, "matrix stack depth must be at least 1");
+        return;
+    }
+    mat_stack_depth = depth;
+}
+
+void free_matrix_stack()
+{
+    RVK_FREE(mat_stack.items);
+    mat_stack = (Mat_Stack){0};
+}
+
 void push_matrix()
 {
-    if (mat_stack_p < MAX_MAT_STACK) {
-        if (mat_stack_p) {
-            mat_stack[mat_stack_p] = mat_stack[mat_stack_p - 1];
-            mat_stack_p++;
+    if (!mat_stack.items) {
+        mat_stack.items = RVK_REALLOC(NULL, mat_stack_depth * sizeof(Affine));
+        RVK_ASSERT(mat_stack.items && "\"Buy more RAM lol\"\n\t\t-Tsoding");
+        mat_stack.capacity = mat_stack_depth;
+    }
+
+    if (mat_stack.count < mat_stack.capacity) {
+        if (mat_stack.count) {
+            mat_stack.items[mat_stack.count] = mat_stack.items[mat_stack.count - 1];
+            mat_stack.count++;
         } else {
-            mat_stack[mat_stack_p++] = MatrixIdentity();
+            mat_stack.items[mat_stack.count++] = (Affine){{{1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}}};
         }
     } else {
-        rvk_log(RVK_ERROR, "matrix stack overflow");
+        rvk_log(RVK_ERROR, "matrix stack overflow (depth %zu, see set_matrix_stack_depth)", mat_stack.capacity);
     }
 }
 
 void pop_matrix()
 {
-    if (mat_stack_p > 0)
-        mat_stack_p--;
+    if (mat_stack.count > 0)
+        mat_stack.count--;
     else
         rvk_log(RVK_ERROR, "matrix stack underflow");
 }
 
 void end_mode_3d()
 {
+    if (instancing.enabled) flush_instances();
+    if (draw_list.enabled) flush_draw_list();
     pop_matrix();
 
     size_t leftover = 0;
-    while(mat_stack_p > 0) {
+    while(mat_stack.count > 0) {
         pop_matrix();
         leftover++;
     }
@@ -608,112 +1336,161 @@ int get_last_btn_pressed()
     return gamepad.last_button_pressed;
 }
 
+Matrix affine_to_matrix(const Affine *a)
+{
+    return (Matrix){
+        a->m[0][0], a->m[0][1], a->m[0][2], a->m[0][3],
+        a->m[1][0], a->m[1][1], a->m[1][2], a->m[1][3],
+        a->m[2][0], a->m[2][1], a->m[2][2], a->m[2][3],
+        0.0f,       0.0f,       0.0f,       1.0f,
+    };
+}
+
+Affine affine_from_matrix(Matrix mat)
+{
+    return (Affine){{
+        {mat.m0, mat.m4, mat.m8,  mat.m12},
+        {mat.m1, mat.m5, mat.m9,  mat.m13},
+        {mat.m2, mat.m6, mat.m10, mat.m14},
+    }};
+}
+
+/* a * b, both affine so the bottom row never needs computing */
+Affine affine_mul(const Affine *a, const Affine *b)
+{
+    Affine res;
+    for (int r = 0; r < 3; r++) {
+        for (int c = 0; c < 4; c++) {
+            res.m[r][c] = a->m[r][0] * b->m[0][c] + a->m[r][1] * b->m[1][c] + a->m[r][2] * b->m[2][c];
+        }
+        res.m[r][3] += a->m[r][3];
+    }
+    return res;
+}
+
+/* columns i and j of the linear part become c*i + s*j and c*j - s*i */
+static void affine_rotate_cols(Affine *a, int i, int j, float angle)
+{
+    float c = cosf(angle);
+    float s = sinf(angle);
+    for (int r = 0; r < 3; r++) {
+        float ci = a->m[r][i];
+        float cj = a->m[r][j];
+        a->m[r][i] = c * ci + s * cj;
+        a->m[r][j] = c * cj - s * ci;
+    }
+}
+
+static Affine *mat_stack_top(const char *op)
+{
+    if (mat_stack.count > 0) return &mat_stack.items[mat_stack.count - 1];
+    rvk_log(RVK_ERROR, "no matrix available to %s", op);
+    return NULL;
+}
+
+static void mat_stack_mul(Matrix matrix, const char *op)
+{
+    Affine *top = mat_stack_top(op);
+    if (!top) return;
+    Affine rhs = affine_from_matrix(matrix);
+    *top = affine_mul(top, &rhs);
+}
+
 void add_matrix(Matrix matrix)
 {
-    if (mat_stack_p > 0)
-        mat_stack[mat_stack_p - 1] = MatrixMultiply(matrix, mat_stack[mat_stack_p - 1]);
-    else
-        rvk_log(RVK_ERROR, "no matrix available on current stack");
+    mat_stack_mul(matrix, "multiply");
 }
 
 void translate(float x, float y, float z)
 {
-    if (mat_stack_p > 0)
-        mat_stack[mat_stack_p - 1] = MatrixMultiply(MatrixTranslate(x, y, z), mat_stack[mat_stack_p - 1]);
-    else
-        rvk_log(RVK_ERROR, "no matrix available to translate");
+    Affine *top = mat_stack_top("translate");
+    if (!top) return;
+    for (int r = 0; r < 3; r++)
+        top->m[r][3] += top->m[r][0] * x + top->m[r][1] * y + top->m[r][2] * z;
 }
 
 void rotate(Vector3 axis, float angle)
 {
-    if (mat_stack_p > 0)
-        mat_stack[mat_stack_p - 1] = MatrixMultiply(MatrixRotate(axis, angle), mat_stack[mat_stack_p - 1]);
-    else
-        rvk_log(RVK_ERROR, "no matrix available to rotate");
+    mat_stack_mul(MatrixRotate(axis, angle), "rotate");
 }
 
 void rotate_x(float angle)
 {
-    if (mat_stack_p > 0)
-        mat_stack[mat_stack_p - 1] = MatrixMultiply(MatrixRotateX(angle), mat_stack[mat_stack_p - 1]);
-    else
-    rvk_log(RVK_ERROR, "no matrix available to rotate x");
+    Affine *top = mat_stack_top("rotate x");
+    if (top) affine_rotate_cols(top, 1, 2, angle);
 }
 
 void rotate_y(float angle)
 {
-    if (mat_stack_p > 0)
-        mat_stack[mat_stack_p - 1] = MatrixMultiply(MatrixRotateY(angle), mat_stack[mat_stack_p - 1]);
-    else
-        rvk_log(RVK_ERROR, "no matrix available to rotate y");
+    Affine *top = mat_stack_top("rotate y");
+    if (top) affine_rotate_cols(top, 2, 0, angle);
 }
 
 void rotate_z(float angle)
 {
-    if (mat_stack_p > 0)
-        mat_stack[mat_stack_p - 1] = MatrixMultiply(MatrixRotateZ(angle), mat_stack[mat_stack_p - 1]);
-    else
-        rvk_log(RVK_ERROR, "no matrix available to rotate z");
+    Affine *top = mat_stack_top("rotate z");
+    if (top) affine_rotate_cols(top, 0, 1, angle);
 }
 
 void rotate_xyz(Vector3 angle)
 {
-    if (mat_stack_p > 0)
-        mat_stack[mat_stack_p - 1] = MatrixMultiply(MatrixRotateXYZ(angle), mat_stack[mat_stack_p - 1]);
-    else
-        rvk_log(RVK_ERROR, "no matrix available to rotate xyz");
+    mat_stack_mul(MatrixRotateXYZ(angle), "rotate xyz");
 }
 
 void rotate_zyx(Vector3 angle)
 {
-    if (mat_stack_p > 0)
-        mat_stack[mat_stack_p - 1] = MatrixMultiply(MatrixRotateZYX(angle), mat_stack[mat_stack_p - 1]);
-    else
-        rvk_log(RVK_ERROR, "no matrix available to rotate zyx");
+    mat_stack_mul(MatrixRotateZYX(angle), "rotate zyx");
 }
 
 void scale(float x, float y, float z)
 {
-    if (mat_stack_p > 0)
-        mat_stack[mat_stack_p - 1] = MatrixMultiply(MatrixScale(x, y, z), mat_stack[mat_stack_p - 1]);
-    else
-        rvk_log(RVK_ERROR, "no matrix available to scale");
+    Affine *top = mat_stack_top("scale");
+    if (!top) return;
+    for (int r = 0; r < 3; r++) {
+        top->m[r][0] *= x;
+        top->m[r][1] *= y;
+        top->m[r][2] *= z;
+    }
 }
 
-void alloc_shape_res(Shape_Type shape_type)
+/* packs every primitive into the shared buffers, uploaded together before the first frame */
+void shape_res_init()
 {
-    if (is_shape_res_alloc(shape_type)) {
-        rvk_log(RVK_WARNING, "Shape resources for shape %d have already been allocated", shape_type);
-        return;
+    size_t vtx_count = 0;
+    size_t idx_count = 0;
+    for (size_t i = 0; i < SHAPE_COUNT; i++) {
+        geometry.ranges[i] = (Rvk_Draw_Range){
+            .first_idx  = idx_count,
+            .idx_count  = primitives[i].idx_buff.count,
+            .vtx_offset = vtx_count,
+        };
+        vtx_count += primitives[i].vtx_buff.count;
+        idx_count += primitives[i].idx_buff.count;
     }
 
-    Shape *shape = &shapes[shape_type];
-    void *data = primitives[shape_type].vtx_buff.items;
-    size_t count = primitives[shape_type].vtx_buff.count;
-    size_t size = primitives[shape_type].vtx_buff.size;
-    rvk_vtx_buff_init(size, count, data, &shape->vtx_buff);
-
-    data = primitives[shape_type].idx_buff.items;
-    count = primitives[shape_type].idx_buff.count;
-    size = primitives[shape_type].idx_buff.size;
-    rvk_idx_buff_init(size, count, data, &shape->idx_buff);
+    Vertex *verts = RVK_REALLOC(NULL, vtx_count * sizeof(Vertex));
+    uint16_t *idxs = RVK_REALLOC(NULL, idx_count * sizeof(uint16_t));
+    RVK_ASSERT(verts && idxs && "\"Buy more RAM lol\"\n\t\t-Tsoding");
+    for (size_t i = 0; i < SHAPE_COUNT; i++) {
+        Rvk_Draw_Range range = geometry.ranges[i];
+        memcpy(verts + range.vtx_offset, primitives[i].vtx_buff.items, primitives[i].vtx_buff.count * sizeof(Vertex));
+        memcpy(idxs + range.first_idx, primitives[i].idx_buff.items, range.idx_count * sizeof(uint16_t));
+    }
 
-    rvk_buff_staged_upload(shape->vtx_buff);
-    rvk_buff_staged_upload(shape->idx_buff);
-}
+    Rvk_Upload_Batch batch = {0};
+    rvk_begin_upload_batch(&batch);
+        geometry.vtx_buff = rvk_create_vertex_buffer(vtx_count * sizeof(Vertex), vtx_count, verts);
+        geometry.idx_buff = rvk_create_index_buffer(idx_count * sizeof(uint16_t), idx_count, idxs);
+    rvk_end_upload_batch(&batch);
 
-bool is_shape_res_alloc(Shape_Type shape_type)
-{
-    assert((shape_type >= 0 && shape_type < SHAPE_COUNT) && "invalid shape");
-    return (shapes[shape_type].vtx_buff.handle || shapes[shape_type].idx_buff.handle);
+    RVK_FREE(verts);
+    RVK_FREE(idxs);
 }
 
 void destroy_shape_res()
 {
-    for (size_t i = 0; i < SHAPE_COUNT; i++) {
-        if (shapes[i].vtx_buff.handle) rvk_buff_destroy(shapes[i].vtx_buff);
-        if (shapes[i].idx_buff.handle) rvk_buff_destroy(shapes[i].idx_buff);
-    }
+    if (geometry.vtx_buff.handle) rvk_buff_destroy(geometry.vtx_buff);
+    if (geometry.idx_buff.handle) rvk_buff_destroy(geometry.idx_buff);
 }
 
 Vector3 get_camera_forward(Camera *camera)
@@ -866,14 +1643,27 @@ bool draw_points(Rvk_Buffer vtx_buff, VkPipeline pl, VkPipelineLayout pl_layout,
     }
 
     Matrix model = {0};
-    if (mat_stack_p) {
-        model = mat_stack[mat_stack_p - 1];
+    if (mat_stack.count) {
+        model = affine_to_matrix(&mat_stack.items[mat_stack.count - 1]);
     } else {
         rvk_log(RVK_ERROR, "No matrix stack, cannot draw.");
         return false;
     }
-    Matrix mvp = MatrixMultiply(model, matrices.view_proj);
-    float16 f16_mvp = MatrixToFloatV(mvp);
+    float16 f16_mvp = mat_mul_float16(model, matrices.view_proj);
+    if (draw_list.enabled && ds_set_count <= DRAW_CMD_MAX_SETS) {
+        Draw_Cmd cmd = {
+            .mvp = f16_mvp,
+            .pl = pl,
+            .pl_layout = pl_layout,
+            .ds_count = ds_set_count,
+            .shape = SHAPE_COUNT,
+            .vtx_buff = vtx_buff.handle,
+            .vtx_count = vtx_buff.count,
+        };
+        for (size_t i = 0; i < ds_set_count; i++) cmd.ds[i] = ds_sets[i];
+        push_draw_cmd(cmd);
+        return true;
+    }
     rvk_draw_points(vtx_buff, &f16_mvp, pl, pl_layout, ds_sets, ds_set_count);
 
     return true;
@@ -933,20 +1723,20 @@ void set_target_fps(int fps)
 
 void look_at(Camera camera)
 {
-    /* Note we are using MatrixInvert here because matrix look at actually
+    /* Note we are using mat_invert here because matrix look at actually
      * takes the inverse because it assumes it will be used as a view matrix.
      * In this case we actually want the world matrix */
-    Matrix inv = MatrixInvert(MatrixLookAt(camera.position, camera.target, camera.up));
-    if (mat_stack_p > 0)
-        mat_stack[mat_stack_p - 1] = MatrixMultiply(mat_stack[mat_stack_p - 1], inv);
-    else
-        rvk_log(RVK_ERROR, "no matrix available to translate");
+    Matrix inv = mat_invert(MatrixLookAt(camera.position, camera.target, camera.up));
+    Affine *top = mat_stack_top("look at");
+    if (!top) return;
+    Affine lhs = affine_from_matrix(inv);
+    *top = affine_mul(&lhs, top);
 }
 
 bool get_matrix_tos(Matrix *model)
 {
-    if (mat_stack_p) {
-        *model = mat_stack[mat_stack_p - 1];
+    if (mat_stack.count) {
+        *model = affine_to_matrix(&mat_stack.items[mat_stack.count - 1]);
     } else {
         rvk_log(RVK_ERROR, "No matrix on stack");
         return false;
@@ -1039,14 +1829,18 @@ Rvk_Texture load_texture_from_image(const char *file_name)
     return load_texture(load_image(file_name));
 }
 
-Rvk_Buffer get_shape_vertex_buffer(Shape_Type shape)
+Rvk_Buffer get_shape_vertex_buffer()
+{
+    return geometry.vtx_buff;
+}
+
+Rvk_Buffer get_shape_index_buffer()
 {
-    if (!is_shape_res_alloc(shape)) alloc_shape_res(shape);
-    return shapes[shape].vtx_buff;
+    return geometry.idx_buff;
 }
 
-Rvk_Buffer get_shape_index_buffer(Shape_Type shape)
+Rvk_Draw_Range get_shape_range(Shape_Type shape)
 {
-    if (!is_shape_res_alloc(shape)) alloc_shape_res(shape);
-    return shapes[shape].idx_buff;
+    assert((shape >= 0 && shape < SHAPE_COUNT) && "invalid shape");
+    return geometry.ranges[shape];
 }
@@ -7,6 +7,7 @@
 #include <vulkan/vulkan_core.h>
 #include "rag_vk.h"
 #include "raylib-5.0/raymath.h"
+#include "mat_simd.h"
 
 /* 
  * The following header contains modifications from the original source "raylib.h",
@@ -236,6 +237,12 @@ typedef struct {
     int height;
 } Window_Size;
 
+/* push constants of draw_shape_bindless, the mvp then the resource index */
+typedef struct {
+    float16 mvp;
+    uint32_t idx;
+} Bindless_Push_Const;
+
 /* window */
 void init_window(int width, int height, const char *title); /* Initialize window and vulkan context */
 void close_window();                                        /* Close window and vulkan context */
@@ -267,13 +274,62 @@ void end_frame();
 void end_drawing();                                         /* Submits commands, presents, and polls for input */
 bool draw_shape(Shape_Type shape_type);                     /* Draw one of the existing shapes (solid fill) */
 void draw_shape_ex(VkPipeline pl, VkPipelineLayout pl_layout, VkDescriptorSet ds, Shape_Type shape);
+
+/* bindless draw, the table must already be bound (rvk_bind_bindless), pushes Bindless_Push_Const
+ * to the vertex and fragment stages */
+void draw_shape_bindless(VkPipeline pl, VkPipelineLayout pl_layout, uint32_t idx, Shape_Type shape);
 bool draw_shape_wireframe(Shape_Type shape_type);           /* Draw one of the existing shapes (wireframe) */
 bool draw_points(Rvk_Buffer buff, VkPipeline pl, VkPipelineLayout pl_layout, VkDescriptorSet *ds_sets, size_t ds_set_count);
 
-/* gpu compute */
+/* draw_shape and draw_shape_wireframe only record their mvp, every shape type is then drawn
+ * once with all of its instances when the batch is flushed, at end_mode_3d and end_drawing.
+ * needs res/default_instanced.vert.glsl.spv, draw order between shapes is not preserved */
+void enable_instancing();
+void flush_instances();
+
+/* draw_shape, draw_shape_wireframe, draw_shape_ex and draw_points append a record with a 64-bit
+ * sort key instead of recording, the list is radix sorted and recorded at end_mode_3d and
+ * end_drawing so draws sharing a pipeline, descriptor set and buffers end up next to each other.
+ * instancing, when enabled as well, still takes draw_shape and draw_shape_wireframe */
+typedef enum {
+    DRAW_ORDER_STATE,         /* group by pipeline, descriptor set, then buffers */
+    DRAW_ORDER_FRONT_TO_BACK, /* nearest first, lets early depth testing reject hidden fragments */
+    DRAW_ORDER_BACK_TO_FRONT, /* farthest first, for blended draws */
+} Draw_Order;
+void enable_draw_list();
+void set_draw_pass(uint32_t pass, Draw_Order order);        /* draws in a later pass (0-15) come after earlier ones */
+void flush_draw_list();
+
+/* gpu driven scene: object transforms and bounds live in a storage buffer, a compute pass frustum
+ * culls them and writes one indirect draw per visible object, then the whole scene is drawn with a
+ * single vkCmdDrawIndexedIndirectCount. the cpu cost per frame does not depend on the object count.
+ * needs res/gpu_cull.comp.glsl.spv, res/gpu_scene.vert.glsl.spv, and res/default.frag.glsl.spv */
+#define GPU_OBJECT_NONE UINT32_MAX
+void enable_gpu_scene(uint32_t max_objects);                /* call before init_window */
+uint32_t add_gpu_object(Shape_Type shape, Matrix transform); /* returns the object id, GPU_OBJECT_NONE when full */
+void set_gpu_object_transform(uint32_t id, Matrix transform);
+void cull_gpu_scene(Camera camera);                         /* after begin_frame, before the render pass begins */
+void draw_gpu_scene();                                      /* inside begin_mode_3d/end_mode_3d */
+
+/* gpu compute: work recorded in between (rvk_dispatch, rvk_compute_pl_barrier, ...) is submitted
+ * on its own, to an async compute queue when the device has one, so it can overlap the previous
+ * frame's graphics. what it writes needs one copy per frame in flight (rvk_get_frame_idx()), it only
+ * waits for the graphics that last used the current frame's copies. call after begin_frame, the
+ * frame's graphics submission waits for it */
 void begin_compute();
 void end_compute();
 
+/* multithreaded recording: begin_drawing_parallel begins the frame with a pass that only takes
+ * secondary command buffers, record_parallel then runs record(i, thread_count, data) on
+ * thread_count threads that each record into their own secondary. every thread starts from a copy
+ * of the caller's top matrix, so the matrix calls and draw_shape, draw_shape_wireframe,
+ * draw_shape_ex and draw_shape_bindless work as usual. instancing and the draw list collect draws
+ * for the whole frame and cannot be combined with it. the pass only takes secondaries, so drawing
+ * between begin_drawing_parallel and end_drawing outside record_parallel logs an error and records
+ * nothing. ended by end_drawing */
+void begin_drawing_parallel(Color color);
+void record_parallel(uint32_t thread_count, Rvk_Record_Fn record, void *data);
+
 /* input */
 bool is_key_pressed(int key);
 bool is_key_down(int key);
@@ -306,10 +362,15 @@ void begin_timer();
 void end_timer();
 void log_fps();
 
-/* transformations */
+/* transformations, every thread has its own stack of affine transforms (3x4, the last row is
+ * always 0 0 0 1), created by its first push_matrix with the depth set at that time. threads
+ * other than the main one call free_matrix_stack before exiting */
+#define MAT_STACK_DEFAULT_DEPTH 256
+void set_matrix_stack_depth(size_t depth); /* applies to stacks created after the call */
+void free_matrix_stack();
 void push_matrix();
 void pop_matrix();
-void add_matrix(Matrix matrix);
+void add_matrix(Matrix matrix);            /* the bottom row of matrix is ignored */
 void translate(float x, float y, float z);
 void rotate(Vector3 axis, float angle);
 void rotate_x(float angle);
@@ -322,8 +383,10 @@ bool get_matrix_tos(Matrix *model); /* get the top of the matrix stack */
 bool get_mvp(Matrix *mvp);
 bool get_mvp_float16(float16 *mvp);
 Matrix get_view_proj();
-Rvk_Buffer get_shape_vertex_buffer(Shape_Type shape);
-Rvk_Buffer get_shape_index_buffer(Shape_Type shape);
+/* every shape shares one vertex and one index buffer, uploaded by init_window */
+Rvk_Buffer get_shape_vertex_buffer();
+Rvk_Buffer get_shape_index_buffer();
+Rvk_Draw_Range get_shape_range(Shape_Type shape);
 
 /* color */
 Color color_from_HSV(float hue, float saturation, float value);
@@ -0,0 +1,349 @@
+#ifndef MAT_SIMD_H_
+#define MAT_SIMD_H_
+
+#include <stddef.h>
+#include "raylib-5.0/raymath.h"
+
+/*
+ * Vectorized versions of the raymath matrix functions core.c calls per draw, they take and return the
+ * same types and give the same results (up to rounding) as their raymath counterparts.
+ *
+ * The path is picked at compile time:
+ *     AVX2 + FMA   when built with -mavx2 -mfma (or /arch:AVX2)
+ *     SSE          any x86-64 build
+ *     NEON         arm builds (i.e. Quest)
+ *     scalar       anything else, or when MAT_SIMD_SCALAR is defined
+ */
+
+#if defined(MAT_SIMD_SCALAR)
+    #define MAT_SIMD_PATH "scalar"
+#elif defined(__AVX2__) && defined(__FMA__)
+    #define MAT_SIMD_AVX2
+    #define MAT_SIMD_SSE
+    #define MAT_SIMD_PATH "avx2"
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define MAT_SIMD_SSE
+    #define MAT_SIMD_PATH "sse"
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define MAT_SIMD_NEON
+    #define MAT_SIMD_PATH "neon"
+#else
+    #define MAT_SIMD_PATH "scalar"
+#endif
+
+Matrix mat_mul(Matrix left, Matrix right);                  /* same as MatrixMultiply(left, right) */
+Matrix mat_invert(Matrix mat);                              /* same as MatrixInvert(mat) */
+float16 mat_mul_float16(Matrix left, Matrix right);         /* MatrixToFloatV(MatrixMultiply(left, right)) */
+
+/* out[i] = (mat * (in[i], 1)).xyz, no perspective divide, in and out may be the same array */
+void mat_transform_points(Matrix mat, const Vector3 *in, Vector3 *out, size_t count);
+
+/* out[i] = MatrixToFloatV(MatrixMultiply(models[i], view_proj)), out may be mapped gpu memory */
+void mat_mul_batch_float16(const Matrix *models, Matrix view_proj, float16 *out, size_t count);
+
+#endif // MAT_SIMD_H_
+
+#ifdef MAT_SIMD_IMPLEMENTATION
+
+#if defined(MAT_SIMD_SSE)
+    #include <immintrin.h>
+#elif defined(MAT_SIMD_NEON)
+    #include <arm_neon.h>
+#endif
+
+/* Matrix is laid out m0 m4 m8 m12 | m1 m5 m9 m13 | ..., so in memory it holds the rows of the
+ * (column vector) matrix. MatrixMultiply(left, right) is right*left, so row r of the result is
+ * sum over k of right[r][k] * left row k. float16 holds columns, so it is the transpose in memory */
+
+#if defined(MAT_SIMD_SSE)
+
+#define MAT_SHUFFLE(a, b, x, y, z, w) _mm_shuffle_ps(a, b, _MM_SHUFFLE(w, z, y, x))
+#define MAT_SPLAT(v, i) _mm_shuffle_ps(v, v, _MM_SHUFFLE(i, i, i, i))
+
+static inline __m128 mat_row_combine(__m128 coeffs, const __m128 rows[4])
+{
+    __m128 res = _mm_mul_ps(MAT_SPLAT(coeffs, 0), rows[0]);
+    res = _mm_add_ps(res, _mm_mul_ps(MAT_SPLAT(coeffs, 1), rows[1]));
+    res = _mm_add_ps(res, _mm_mul_ps(MAT_SPLAT(coeffs, 2), rows[2]));
+    res = _mm_add_ps(res, _mm_mul_ps(MAT_SPLAT(coeffs, 3), rows[3]));
+    return res;
+}
+
+Matrix mat_mul(Matrix left, Matrix right)
+{
+    const float *l = &left.m0;
+    const float *r = &right.m0;
+    __m128 rows[4] = {_mm_loadu_ps(l), _mm_loadu_ps(l + 4), _mm_loadu_ps(l + 8), _mm_loadu_ps(l + 12)};
+
+    Matrix res;
+    float *o = &res.m0;
+    for (int i = 0; i < 4; i++)
+        _mm_storeu_ps(o + 4*i, mat_row_combine(_mm_loadu_ps(r + 4*i), rows));
+    return res;
+}
+
+/* columns of right, i.e. right transposed, so the columns of the product come out directly */
+static inline void mat_load_cols(Matrix mat, __m128 cols[4])
+{
+    const float *m = &mat.m0;
+    cols[0] = _mm_loadu_ps(m);
+    cols[1] = _mm_loadu_ps(m + 4);
+    cols[2] = _mm_loadu_ps(m + 8);
+    cols[3] = _mm_loadu_ps(m + 12);
+    _MM_TRANSPOSE4_PS(cols[0], cols[1], cols[2], cols[3]);
+}
+
+/* column c of right*left is right * (column c of left) = sum over k of left[k][c] * right column k */
+static inline void mat_mul_cols_sse(const float *l, const __m128 rcols[4], float *out)
+{
+    /* transposing left gives its columns, so each lane splats a column entry */
+    __m128 lcols[4] = {_mm_loadu_ps(l), _mm_loadu_ps(l + 4), _mm_loadu_ps(l + 8), _mm_loadu_ps(l + 12)};
+    _MM_TRANSPOSE4_PS(lcols[0], lcols[1], lcols[2], lcols[3]);
+    for (int c = 0; c < 4; c++)
+        _mm_storeu_ps(out + 4*c, mat_row_combine(lcols[c], rcols));
+}
+
+#if defined(MAT_SIMD_AVX2)
+/* two columns of the product per 256 bit register */
+static inline void mat_mul_cols_avx2(const float *l, const __m256 rcols[4], float *out)
+{
+    const __m256i lo = _mm256_setr_epi32(0, 0, 0, 0, 1, 1, 1, 1);
+    const __m256i hi = _mm256_setr_epi32(2, 2, 2, 2, 3, 3, 3, 3);
+    __m256 cols01 = _mm256_setzero_ps();
+    __m256 cols23 = _mm256_setzero_ps();
+    for (int k = 0; k < 4; k++) {
+        __m256 row = _mm256_broadcast_ps((const __m128 *)(l + 4*k));
+        cols01 = _mm256_fmadd_ps(_mm256_permutevar8x32_ps(row, lo), rcols[k], cols01);
+        cols23 = _mm256_fmadd_ps(_mm256_permutevar8x32_ps(row, hi), rcols[k], cols23);
+    }
+    _mm256_storeu_ps(out, cols01);
+    _mm256_storeu_ps(out + 8, cols23);
+}
+#endif
+
+/* a single product is cheaper in row form with one transpose on the way out */
+float16 mat_mul_float16(Matrix left, Matrix right)
+{
+    const float *l = &left.m0;
+    const float *r = &right.m0;
+    __m128 rows[4] = {_mm_loadu_ps(l), _mm_loadu_ps(l + 4), _mm_loadu_ps(l + 8), _mm_loadu_ps(l + 12)};
+    __m128 res[4];
+    for (int i = 0; i < 4; i++) res[i] = mat_row_combine(_mm_loadu_ps(r + 4*i), rows);
+    _MM_TRANSPOSE4_PS(res[0], res[1], res[2], res[3]);
+
+    float16 out;
+    for (int i = 0; i < 4; i++) _mm_storeu_ps(out.v + 4*i, res[i]);
+    return out;
+}
+
+void mat_mul_batch_float16(const Matrix *models, Matrix view_proj, float16 *out, size_t count)
+{
+    __m128 rcols[4];
+    mat_load_cols(view_proj, rcols);
+#if defined(MAT_SIMD_AVX2)
+    __m256 rcols2[4];
+    for (int k = 0; k < 4; k++) rcols2[k] = _mm256_set_m128(rcols[k], rcols[k]);
+    for (size_t i = 0; i < count; i++)
+        mat_mul_cols_avx2(&models[i].m0, rcols2, out[i].v);
+#else
+    for (size_t i = 0; i < count; i++)
+        mat_mul_cols_sse(&models[i].m0, rcols, out[i].v);
+#endif
+}
+
+void mat_transform_points(Matrix mat, const Vector3 *in, Vector3 *out, size_t count)
+{
+    __m128 cols[4];
+    mat_load_cols(mat, cols);
+    for (size_t i = 0; i < count; i++) {
+        Vector3 p = in[i];
+        __m128 res = _mm_add_ps(cols[3], _mm_mul_ps(_mm_set1_ps(p.x), cols[0]));
+        res = _mm_add_ps(res, _mm_mul_ps(_mm_set1_ps(p.y), cols[1]));
+        res = _mm_add_ps(res, _mm_mul_ps(_mm_set1_ps(p.z), cols[2]));
+        float tmp[4];
+        _mm_storeu_ps(tmp, res);
+        out[i] = (Vector3){tmp[0], tmp[1], tmp[2]};
+    }
+}
+
+/* 2x2 blocks packed as (x y z w) = | x y |
+ *                                  | z w | */
+static inline __m128 mat2_mul(__m128 a, __m128 b)
+{
+    return _mm_add_ps(_mm_mul_ps(a, MAT_SHUFFLE(b, b, 0, 3, 0, 3)),
+                      _mm_mul_ps(MAT_SHUFFLE(a, a, 1, 0, 3, 2), MAT_SHUFFLE(b, b, 2, 1, 2, 1)));
+}
+
+/* adj(a) * b */
+static inline __m128 mat2_adj_mul(__m128 a, __m128 b)
+{
+    return _mm_sub_ps(_mm_mul_ps(MAT_SHUFFLE(a, a, 3, 3, 0, 0), b),
+                      _mm_mul_ps(MAT_SHUFFLE(a, a, 1, 1, 2, 2), MAT_SHUFFLE(b, b, 2, 3, 0, 1)));
+}
+
+/* a * adj(b) */
+static inline __m128 mat2_mul_adj(__m128 a, __m128 b)
+{
+    return _mm_sub_ps(_mm_mul_ps(a, MAT_SHUFFLE(b, b, 3, 0, 3, 0)),
+                      _mm_mul_ps(MAT_SHUFFLE(a, a, 1, 0, 3, 2), MAT_SHUFFLE(b, b, 2, 1, 2, 1)));
+}
+
+/* block inverse, M = | A B |, the inverse of the transpose is the transpose of the inverse
+ *                    | C D |  so the memory order does not matter */
+Matrix mat_invert(Matrix mat)
+{
+    const float *m = &mat.m0;
+    __m128 r0 = _mm_loadu_ps(m);
+    __m128 r1 = _mm_loadu_ps(m + 4);
+    __m128 r2 = _mm_loadu_ps(m + 8);
+    __m128 r3 = _mm_loadu_ps(m + 12);
+
+    __m128 a = _mm_movelh_ps(r0, r1);
+    __m128 b = _mm_movehl_ps(r1, r0);
+    __m128 c = _mm_movelh_ps(r2, r3);
+    __m128 d = _mm_movehl_ps(r3, r2);
+
+    /* (|A| |B| |C| |D|) */
+    __m128 det_sub = _mm_sub_ps(
+        _mm_mul_ps(MAT_SHUFFLE(r0, r2, 0, 2, 0, 2), MAT_SHUFFLE(r1, r3, 1, 3, 1, 3)),
+        _mm_mul_ps(MAT_SHUFFLE(r0, r2, 1, 3, 1, 3), MAT_SHUFFLE(r1, r3, 0, 2, 0, 2))
+    );
+    __m128 det_a = MAT_SPLAT(det_sub, 0);
+    __m128 det_b = MAT_SPLAT(det_sub, 1);
+    __m128 det_c = MAT_SPLAT(det_sub, 2);
+    __m128 det_d = MAT_SPLAT(det_sub, 3);
+
+    __m128 d_c = mat2_adj_mul(d, c);
+    __m128 a_b = mat2_adj_mul(a, b);
+    __m128 x = _mm_sub_ps(_mm_mul_ps(det_d, a), mat2_mul(b, d_c));
+    __m128 w = _mm_sub_ps(_mm_mul_ps(det_a, d), mat2_mul(c, a_b));
+    __m128 y = _mm_sub_ps(_mm_mul_ps(det_b, c), mat2_mul_adj(d, a_b));
+    __m128 z = _mm_sub_ps(_mm_mul_ps(det_c, b), mat2_mul_adj(a, d_c));
+
+    /* |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C) */
+    __m128 tr = _mm_mul_ps(a_b, MAT_SHUFFLE(d_c, d_c, 0, 2, 1, 3));
+    tr = _mm_add_ps(tr, _mm_movehl_ps(tr, tr));
+    tr = _mm_add_ss(tr, MAT_SHUFFLE(tr, tr, 1, 1, 1, 1));
+    __m128 det = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(det_a, det_d), _mm_mul_ps(det_b, det_c)), MAT_SPLAT(tr, 0));
+
+    __m128 inv_det = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), det);
+    x = _mm_mul_ps(x, inv_det);
+    y = _mm_mul_ps(y, inv_det);
+    z = _mm_mul_ps(z, inv_det);
+    w = _mm_mul_ps(w, inv_det);
+
+    Matrix res;
+    float *o = &res.m0;
+    _mm_storeu_ps(o,      MAT_SHUFFLE(x, y, 3, 1, 3, 1));
+    _mm_storeu_ps(o + 4,  MAT_SHUFFLE(x, y, 2, 0, 2, 0));
+    _mm_storeu_ps(o + 8,  MAT_SHUFFLE(z, w, 3, 1, 3, 1));
+    _mm_storeu_ps(o + 12, MAT_SHUFFLE(z, w, 2, 0, 2, 0));
+    return res;
+}
+
+#elif defined(MAT_SIMD_NEON)
+
+Matrix mat_mul(Matrix left, Matrix right)
+{
+    const float *l = &left.m0;
+    const float *r = &right.m0;
+    float32x4_t rows[4] = {vld1q_f32(l), vld1q_f32(l + 4), vld1q_f32(l + 8), vld1q_f32(l + 12)};
+
+    Matrix res;
+    float *o = &res.m0;
+    for (int i = 0; i < 4; i++) {
+        float32x4_t row = vmulq_n_f32(rows[0], r[4*i]);
+        row = vmlaq_n_f32(row, rows[1], r[4*i + 1]);
+        row = vmlaq_n_f32(row, rows[2], r[4*i + 2]);
+        row = vmlaq_n_f32(row, rows[3], r[4*i + 3]);
+        vst1q_f32(o + 4*i, row);
+    }
+    return res;
+}
+
+static inline void mat_load_cols(Matrix mat, float32x4_t cols[4])
+{
+    float16 t = MatrixToFloatV(mat);
+    for (int i = 0; i < 4; i++) cols[i] = vld1q_f32(t.v + 4*i);
+}
+
+float16 mat_mul_float16(Matrix left, Matrix right)
+{
+    float16 res;
+    mat_mul_batch_float16(&left, right, &res, 1);
+    return res;
+}
+
+void mat_mul_batch_float16(const Matrix *models, Matrix view_proj, float16 *out, size_t count)
+{
+    float32x4_t rcols[4];
+    mat_load_cols(view_proj, rcols);
+    for (size_t i = 0; i < count; i++) {
+        const float *l = &models[i].m0;
+        for (int c = 0; c < 4; c++) {
+            float32x4_t col = vmulq_n_f32(rcols[0], l[c]);
+            col = vmlaq_n_f32(col, rcols[1], l[4 + c]);
+            col = vmlaq_n_f32(col, rcols[2], l[8 + c]);
+            col = vmlaq_n_f32(col, rcols[3], l[12 + c]);
+            vst1q_f32(out[i].v + 4*c, col);
+        }
+    }
+}
+
+void mat_transform_points(Matrix mat, const Vector3 *in, Vector3 *out, size_t count)
+{
+    float32x4_t cols[4];
+    mat_load_cols(mat, cols);
+    for (size_t i = 0; i < count; i++) {
+        Vector3 p = in[i];
+        float32x4_t res = vmlaq_n_f32(cols[3], cols[0], p.x);
+        res = vmlaq_n_f32(res, cols[1], p.y);
+        res = vmlaq_n_f32(res, cols[2], p.z);
+        out[i] = (Vector3){vgetq_lane_f32(res, 0), vgetq_lane_f32(res, 1), vgetq_lane_f32(res, 2)};
+    }
+}
+
+/* inverses are rare (camera helpers), the scalar version is kept on arm */
+Matrix mat_invert(Matrix mat)
+{
+    return MatrixInvert(mat);
+}
+
+#else // scalar
+
+Matrix mat_mul(Matrix left, Matrix right)
+{
+    return MatrixMultiply(left, right);
+}
+
+Matrix mat_invert(Matrix mat)
+{
+    return MatrixInvert(mat);
+}
+
+float16 mat_mul_float16(Matrix left, Matrix right)
+{
+    return MatrixToFloatV(MatrixMultiply(left, right));
+}
+
+void mat_mul_batch_float16(const Matrix *models, Matrix view_proj, float16 *out, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+        out[i] = MatrixToFloatV(MatrixMultiply(models[i], view_proj));
+}
+
+void mat_transform_points(Matrix mat, const Vector3 *in, Vector3 *out, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        Vector3 p = in[i];
+        out[i] = (Vector3){
+            mat.m0*p.x + mat.m4*p.y + mat.m8*p.z + mat.m12,
+            mat.m1*p.x + mat.m5*p.y + mat.m9*p.z + mat.m13,
+            mat.m2*p.x + mat.m6*p.y + mat.m10*p.z + mat.m14,
+        };
+    }
+}
+
+#endif
+
+#endif // MAT_SIMD_IMPLEMENTATION
@@ -0,0 +1,63 @@
+#include <stdlib.h>
+
+/* headless platform: no window, no input, time comes from a monotonic clock.
+ * CVR_HEADLESS_FRAMES=<n> makes window_should_close return true after n frames,
+ * otherwise the application decides when to stop. */
+static size_t headless_frame_limit = 0;
+
+bool init_platform()
+{
+    const char *frames = getenv("CVR_HEADLESS_FRAMES");
+    if (frames) headless_frame_limit = strtoull(frames, NULL, 10);
+    rvk_log(RVK_INFO, "headless platform %dx%d", win_size.width, win_size.height);
+    return true;
+}
+
+bool window_should_close()
+{
+    return headless_frame_limit && cvr_time.frame_count >= headless_frame_limit;
+}
+
+void poll_input_events()
+{
+    /* nothing generates input, but keep pressed/released edges consistent */
+    keyboard.key_pressed_queue_count = 0;
+    keyboard.char_pressed_queue_count = 0;
+    for (int i = 0; i < MAX_KEYBOARD_KEYS; i++) {
+        keyboard.prev_key_state[i] = keyboard.curr_key_state[i];
+        keyboard.key_repeat_in_frame[i] = 0;
+    }
+
+    mouse.prev_pos = mouse.curr_pos;
+    for (int i = 0; i < MAX_MOUSE_BUTTONS; i++)
+        mouse.prev_button_state[i] = mouse.curr_button_state[i];
+    mouse.prev_wheel_move = mouse.curr_wheel_move;
+    mouse.curr_wheel_move = (Vector2){ 0.0f, 0.0f };
+
+    for (int i = 0; i < MAX_GAMEPAD_BUTTONS; i++)
+        gamepad.prev_button_state[i] = gamepad.curr_button_state[i];
+}
+
+double get_time()
+{
+    return rvk_get_headless_time();
+}
+
+void close_platform()
+{
+}
+
+void set_window_size(int width, int height)
+{
+    win_size.width = width;
+    win_size.height = height;
+    rvk_ctx.extent.width = width;
+    rvk_ctx.extent.height = height;
+    if (rvk_ctx.device) rvk_recreate_swapchain();
+}
+
+void set_window_pos(int x, int y)
+{
+    (void)x;
+    (void)y;
+}
@@ -5,7 +5,7 @@
 #define RVK_REALLOC realloc
 #define RVK_FREE free
 
-#ifdef PLATFORM_DESKTOP_GLFW
+#if defined(PLATFORM_DESKTOP_GLFW) || defined(PLATFORM_HEADLESS)
 #define RVK_EXIT_APP RVK_ASSERT(0)
 #else
 #define RVK_EXIT_APP
@@ -50,6 +50,7 @@
 #define RVK_SUCCEEDED(x) ((x) == VK_SUCCESS)
 #define clamp(val, min, max) ((val) < (min)) ? (min) : (((val) > (max)) ? (max) : (val))
 #define RVK_ARRAY_LEN(array) (sizeof(array)/sizeof(array[0]))
+#define RVK_MAX(a, b) (((a) > (b)) ? (a) : (b))
 
 /* note: these are a *nearly* one-to-one mapping of the vulkan equivalent (i.e. VK_DESCRIPTOR_TYPE_*),
  * but VK_DESCRIPTOR_TYPE_MAX_ENUM = 0x7FFFFFFF, is too huge for a static array, so
@@ -69,20 +70,61 @@ typedef enum {
     RVK_DESCRIPTOR_TYPE_COUNT,
 } Rvk_Descriptor_Type;
 
+#define RVK_MAX_LAYOUT_BINDINGS 16
+typedef struct {
+    uint32_t binding;
+    VkDescriptorType type;
+    uint32_t count;
+} Rvk_Layout_Binding;
+
 typedef struct {
     VkDescriptorSetLayout handle;
     uint32_t desc_count[RVK_DESCRIPTOR_TYPE_COUNT];
+    /* kept so update templates can be built from the layout,
+     * empty when the layout has more than RVK_MAX_LAYOUT_BINDINGS bindings */
+    Rvk_Layout_Binding bindings[RVK_MAX_LAYOUT_BINDINGS];
+    uint32_t binding_count;
 } Rvk_Descriptor_Set_Layout;
 
-#define MAX_DESCRIPTOR_SETS 100
+/* one slot of the packed data an update template reads, which member is
+ * used depends on the descriptor type of the binding the slot belongs to */
+typedef union {
+    VkDescriptorBufferInfo buff;
+    VkDescriptorImageInfo img;
+    VkBufferView texel_buff;
+} Rvk_Descriptor_Info;
+
+/* rewrites every binding of a set in one call, the infos passed to the update are
+ * one Rvk_Descriptor_Info per descriptor, in the order the layout's bindings were given */
 typedef struct {
-    VkDescriptorPool pool;
-    /* Please note that pool usage tracking is only good
-     * for judging whether the pool capacity is close to full.
-     * it is only incremented when you call: rvk_descriptor_pool_arena_alloc_set(...)
-     * it is only decremented when you call: rvk_descriptor_pool_arena_reset(...)
-     * */
+    VkDescriptorUpdateTemplate handle; // null on vulkan 1.0, updates fall back to writes
+    Rvk_Layout_Binding bindings[RVK_MAX_LAYOUT_BINDINGS];
+    uint32_t binding_count;
+    uint32_t info_count;
+} Rvk_Ds_Template;
+
+/* sets the first pool of an arena can hold for the layout that triggered its creation */
+#define RVK_DESCRIPTOR_ARENA_INITIAL_SETS 16
+
+typedef struct {
+    VkDescriptorPool *items;
+    size_t count;
+    size_t capacity;
+} Rvk_Descriptor_Pools;
+
+/* a chain of descriptor pools created on demand. a new pool is sized from what the arena
+ * has handed out so far, a reset folds the chain back into one pool sized for the peak,
+ * so an arena that is reset every frame settles on a single pool after a few frames */
+typedef struct {
+    VkDescriptorPool pool; // pool sets are currently allocated from
+    Rvk_Descriptor_Pools pools;
+    size_t pool_idx;
+    /* only incremented when you call: rvk_descriptor_pool_arena_alloc_set(...)
+     * only reset to zero when you call: rvk_descriptor_pool_arena_reset(...) */
     uint32_t pools_usage[RVK_DESCRIPTOR_TYPE_COUNT];
+    uint32_t set_count;
+    uint32_t peak_usage[RVK_DESCRIPTOR_TYPE_COUNT];
+    uint32_t peak_set_count;
 } Rvk_Descriptor_Pool_Arena;
 
 #define RVK_MAX_SWAPCHAIN_IMAGES 5
@@ -102,14 +144,68 @@ typedef enum {
     RVK_BUFFER_TYPE_COMPUTE,
     RVK_BUFFER_TYPE_UNIFORM,
     RVK_BUFFER_TYPE_STAGING,
+    RVK_BUFFER_TYPE_INDIRECT,
     RVK_BUFFER_TYPE_COUNT,
 } Rvk_Buffer_Type;
 
+/* device memory is allocated in large blocks per memory type and handed out in sub-ranges,
+ * buffers and images bind at an offset into a block instead of owning a VkDeviceMemory */
+#define RVK_MEM_BLOCK_SIZE (64*1024*1024)
+
+typedef struct {
+    VkDeviceSize offset;
+    VkDeviceSize size;
+    bool linear; // buffers and linear images can't share a bufferImageGranularity page with optimal images
+    bool mapped;
+} Rvk_Mem_Range;
+
+typedef struct {
+    Rvk_Mem_Range *items;
+    size_t count;
+    size_t capacity;
+} Rvk_Mem_Ranges;
+
+typedef struct {
+    VkDeviceMemory mem;
+    VkDeviceSize size;
+    VkDeviceSize used;
+    uint32_t mem_type_idx;
+    void *mapped;
+    uint32_t map_count;
+    Rvk_Mem_Ranges ranges; // sorted by offset
+} Rvk_Mem_Block;
+
+typedef struct {
+    Rvk_Mem_Block **items;
+    size_t count;
+    size_t capacity;
+} Rvk_Mem_Blocks;
+
+typedef struct {
+    Rvk_Mem_Blocks blocks[VK_MAX_MEMORY_TYPES]; // one list of blocks per memory type
+    VkDeviceSize granularity;
+} Rvk_Mem_Allocator;
+
+typedef struct {
+    Rvk_Mem_Block *block;
+    VkDeviceSize offset;
+    VkDeviceSize size;
+} Rvk_Allocation;
+
+typedef struct {
+    size_t block_count;
+    size_t alloc_count;
+    VkDeviceSize bytes_reserved; // sum of all block sizes
+    VkDeviceSize bytes_used;
+    VkDeviceSize largest_free;
+    float fragmentation;         // 0 when all free space is contiguous, approaches 1 as it splinters
+} Rvk_Mem_Stats;
+
 typedef struct {
     size_t size;
     size_t count;
     VkBuffer handle;
-    VkDeviceMemory mem;
+    Rvk_Allocation alloc;
     void *mapped;
     void *data;
     VkDescriptorBufferInfo info;
@@ -119,7 +215,7 @@ typedef struct {
 typedef struct {
     VkExtent2D extent;
     VkImage handle;
-    VkDeviceMemory mem;
+    Rvk_Allocation alloc;
     VkImageAspectFlags aspect_mask; // TODO: this shouldn't really be here
     VkFormat format;
 } Rvk_Image;
@@ -131,6 +227,7 @@ typedef struct {
     VkDescriptorImageInfo info;
 } Rvk_Texture;
 
+/* with dynamic rendering enabled a render texture is only its images and views, fb and rp stay VK_NULL_HANDLE */
 typedef struct {
     VkFramebuffer fb;
     VkRenderPass rp;
@@ -138,8 +235,286 @@ typedef struct {
     Rvk_Texture color;
     VkImageView img_views[2];
     VkExtent2D extent;
+    uint32_t view_count; // layers rendered by multiview, 1 otherwise
 } Rvk_Render_Texture;
 
+/* the cpu records frame N+1 while the gpu is still working on frame N,
+ * each frame in flight owns its command buffer and sync objects */
+#define RVK_MAX_FRAMES_IN_FLIGHT 3
+#define RVK_DEFAULT_FRAMES_IN_FLIGHT 2
+typedef struct {
+    VkCommandBuffer cmd_buff;
+    VkCommandBuffer compute_cmd_buff;
+    uint64_t compute_value;             // compute timeline value of the frame's last compute submission
+    uint64_t gfx_value;                 // graphics timeline value of the frame's last rvk_submit_gfx
+    VkSemaphore img_avail_sem;
+    VkFence fence;
+    Rvk_Descriptor_Pool_Arena ds_arena; // transient sets, reset once the fence signals
+} Rvk_Frame;
+
+/* shader modules are created once per spir-v blob and shared by every pipeline that uses them */
+typedef struct {
+    char *path;       // path it was first loaded from
+    uint64_t hash;    // hash of the spir-v contents
+    size_t size;
+    VkShaderModule module;
+    uint32_t ref_count;
+} Rvk_Shader;
+
+typedef struct {
+    Rvk_Shader *items;
+    size_t count;
+    size_t capacity;
+} Rvk_Shader_Registry;
+
+/* bindless mode: one update-after-bind set holding a large array per resource kind,
+ * bound once and indexed by draws through push constants, in glsl:
+ *   #extension GL_EXT_nonuniform_qualifier : require
+ *   layout(set = 0, binding = 0) uniform sampler2D textures[];
+ *   layout(set = 0, binding = 1) buffer Buffers { ... } buffers[];
+ *   layout(set = 0, binding = 2, rgba8) uniform image2D images[]; */
+typedef enum {
+    RVK_BINDLESS_TEXTURE,        // combined image sampler
+    RVK_BINDLESS_STORAGE_BUFFER,
+    RVK_BINDLESS_STORAGE_IMAGE,
+    RVK_BINDLESS_KIND_COUNT,
+} Rvk_Bindless_Kind;
+
+#define RVK_BINDLESS_MAX_TEXTURES        16384
+#define RVK_BINDLESS_MAX_STORAGE_BUFFERS 16384
+#define RVK_BINDLESS_MAX_STORAGE_IMAGES  4096
+#define RVK_BINDLESS_NONE UINT32_MAX
+
+typedef struct {
+    uint32_t *items;
+    size_t count;
+    size_t capacity;
+} Rvk_Bindless_Slots;
+
+typedef struct {
+    VkDescriptorPool pool;
+    VkDescriptorSetLayout layout;
+    VkDescriptorSet set;
+    uint32_t capacity[RVK_BINDLESS_KIND_COUNT]; // clamped to the device limits
+    uint32_t used[RVK_BINDLESS_KIND_COUNT];     // high water mark, slots below it are live or free
+    Rvk_Bindless_Slots free[RVK_BINDLESS_KIND_COUNT];
+    /* removed since the last frame submission, any frame up to and including it may read them */
+    Rvk_Bindless_Slots removed[RVK_BINDLESS_KIND_COUNT];
+    /* handed to frame i at its submission, reusable once its fence signals again */
+    Rvk_Bindless_Slots retired[RVK_MAX_FRAMES_IN_FLIGHT][RVK_BINDLESS_KIND_COUNT];
+} Rvk_Bindless_Table;
+
+/* state changes the recording helpers track, counted per frame as issued or skipped */
+typedef enum {
+    RVK_CMD_BIND_PIPELINE,
+    RVK_CMD_BIND_DESCRIPTOR_SETS,
+    RVK_CMD_BIND_VERTEX_BUFFER,
+    RVK_CMD_BIND_INDEX_BUFFER,
+    RVK_CMD_SET_VIEWPORT,
+    RVK_CMD_SET_SCISSOR,
+    RVK_CMD_PUSH_CONSTANTS,
+    RVK_CMD_STATE_COUNT,
+} Rvk_Cmd_State_Kind;
+
+typedef struct {
+    uint32_t issued[RVK_CMD_STATE_COUNT];
+    uint32_t skipped[RVK_CMD_STATE_COUNT];
+} Rvk_Cmd_Stats;
+
+/* what is currently bound in the command buffer being recorded, so helpers that are
+ * called once per draw only reach vulkan when something actually changes */
+#define RVK_MAX_TRACKED_SETS 4
+#define RVK_MAX_PUSH_CONST_SIZE 128
+typedef struct {
+    VkCommandBuffer cmd_buff;
+    VkPipeline pl[2];              // indexed by bind point, graphics then compute
+    VkPipelineLayout ds_layout[2];
+    VkDescriptorSet ds[2][RVK_MAX_TRACKED_SETS];
+    VkBuffer vtx_buff;
+    VkBuffer idx_buff;
+    VkIndexType idx_type;
+    bool viewport_set;
+    VkViewport viewport;
+    bool scissor_set;
+    VkRect2D scissor;
+    VkPipelineLayout push_layout;
+    VkShaderStageFlags push_stages;
+    uint32_t push_size;
+    uint8_t push_data[RVK_MAX_PUSH_CONST_SIZE];
+    Rvk_Cmd_Stats stats;
+} Rvk_Cmd_State;
+
+/* every submission signals the next value of one timeline semaphore, once the semaphore reaches
+ * a value the work submitted with it, and everything submitted to the queue before it, is done */
+typedef enum {
+    RVK_DEFERRED_BUFFER,
+    RVK_DEFERRED_TEXTURE,
+} Rvk_Deferred_Kind;
+
+/* a destroyed resource the gpu may still be using */
+typedef struct {
+    Rvk_Deferred_Kind kind;
+    uint64_t value; // 0 until the next frame is submitted, destroyed once this value completes
+    union {
+        Rvk_Buffer buff;
+        Rvk_Texture tex;
+    } as;
+} Rvk_Deferred_Destroy;
+
+typedef struct {
+    Rvk_Deferred_Destroy *items;
+    size_t count;
+    size_t capacity;
+} Rvk_Deferred_Destroys;
+
+#define RVK_MAX_SUBMIT_SIGNALS 8
+typedef struct {
+    VkSemaphore sem;
+    uint64_t submitted; // value of the most recent submission
+    uint64_t completed; // last value the semaphore was seen at
+    Rvk_Deferred_Destroys deferred;
+} Rvk_Timeline;
+
+/* persistently mapped staging memory that uploads sub-allocate from. ranges are grouped into spans
+ * by the work that reads them, a span is reclaimed once the timeline of the submission that read it
+ * has reached its value. spans are reclaimed oldest first, and only once every older one is done too,
+ * since frames, quick uploads and batches on a transfer queue do not complete in allocation order */
+#define RVK_DEFAULT_STAGING_RING_SIZE (32*1024*1024)
+typedef enum {
+    RVK_STAGING_FRAME, // copies recorded into the frame's command buffer
+    RVK_STAGING_QUICK, // an upload outside of a batch, submitted and waited on right away
+    RVK_STAGING_BATCH, // copies recorded into the active upload batch
+} Rvk_Staging_Owner;
+
+typedef struct {
+    VkDeviceSize end;       // ring head once the span's last range was handed out
+    Rvk_Staging_Owner owner;
+    Rvk_Timeline *timeline; // NULL while the owner is still recording
+    uint64_t value;
+} Rvk_Staging_Span;
+
+typedef struct {
+    Rvk_Staging_Span *items;
+    size_t count;
+    size_t capacity;
+} Rvk_Staging_Spans;
+
+typedef struct {
+    VkBuffer handle;
+    VkDeviceMemory mem;
+    void *mapped;          // mapped for the lifetime of the ring
+    VkDeviceSize capacity;
+    VkDeviceSize head;     // total bytes handed out, only ever grows
+    VkDeviceSize tail;     // total bytes reclaimed, only ever grows
+    Rvk_Staging_Spans spans;
+} Rvk_Staging_Ring;
+
+typedef struct {
+    VkBuffer handle;
+    VkDeviceSize offset;
+    VkDeviceSize size;
+    void *mapped;
+} Rvk_Staging_Range;
+
+
+/* a resource an upload batch wrote on the transfer queue, released there and acquired
+ * by the unified queue once the batch completes */
+typedef struct {
+    uint64_t value;            // transfer timeline value of its batch, 0 while the batch records
+    VkBuffer buff;             // either a buffer
+    VkImage img;               // or an image, with the layout transition that goes along with it
+    VkImageLayout old_layout;  // UNDEFINED means the transfer queue never touched it, only the transition is left
+    VkImageLayout new_layout;
+} Rvk_Queue_Transfer;
+
+typedef struct {
+    Rvk_Queue_Transfer *items;
+    size_t count;
+    size_t capacity;
+} Rvk_Queue_Transfers;
+
+typedef struct {
+    VkCommandBuffer cmd_buff;
+    uint64_t value; // unified timeline
+} Rvk_Acquire_Cmd;
+
+typedef struct {
+    Rvk_Acquire_Cmd *items;
+    size_t count;
+    size_t capacity;
+} Rvk_Acquire_Cmds;
+
+/* upload batches run on a transfer-only queue family when the device has one, so copies do not
+ * compete with rendering. without one (or with Rvk_Config.no_transfer_queue) queue, pool, and
+ * timeline alias the unified ones and nothing changes owner */
+typedef struct {
+    bool disabled;
+    bool dedicated;
+    uint32_t queue_idx;
+    VkQueue queue;
+    VkCommandPool pool;
+    Rvk_Timeline timeline;        // only used when dedicated
+    uint64_t acquired;            // transfer value up to which the unified queue has acquired everything
+    Rvk_Queue_Transfers pending;  // released (or still recording), not acquired yet
+    Rvk_Acquire_Cmds acquire_cmds;
+} Rvk_Transfer_Queue;
+
+/* compute recorded between rvk_begin_rec_compute and rvk_submit_compute goes out in its own
+ * submission, on a second queue of the unified family when the family has one so it can overlap
+ * with graphics. staying in the unified family keeps resources usable from both queues without
+ * ownership transfers. the next rvk_submit_gfx waits on it */
+typedef struct {
+    bool disabled;
+    bool async;
+    bool recording;
+    VkQueue queue;
+    Rvk_Timeline timeline;
+    uint64_t pending;              // value the next graphics submission waits on, 0 if none
+    VkCommandBuffer gfx_cmd_buff;  // put back once compute is submitted
+    Rvk_Cmd_State gfx_cmd_state;
+} Rvk_Compute_Queue;
+
+/* slot i of rvk_record_parallel records the i-th slice of every parallel pass. it owns a pool per
+ * frame in flight, reset once that frame's fence signals, so its secondaries are allocated once
+ * and reused every frame */
+typedef struct {
+    VkCommandPool pools[RVK_MAX_FRAMES_IN_FLIGHT];
+    struct {
+        VkCommandBuffer *items;
+        size_t count;
+        size_t capacity;
+    } cmd_buffs[RVK_MAX_FRAMES_IN_FLIGHT];
+    uint32_t used[RVK_MAX_FRAMES_IN_FLIGHT];
+    VkCommandBuffer cmd_buff;  // being recorded
+    Rvk_Cmd_State cmd_state;   // of cmd_buff
+} Rvk_Record_Slot;
+
+/* what the secondaries of the pass begun by rvk_begin_parallel_render_pass inherit */
+#define RVK_MAX_RECORD_THREADS 16
+typedef struct {
+    bool active;
+    bool refused;              // a recording into the primary was refused this pass, logged once
+    VkRenderPass render_pass;  // VK_NULL_HANDLE with dynamic rendering
+    VkFramebuffer frame_buff;
+    VkFormat color_fmt;
+    VkFormat depth_fmt;
+    uint32_t slot_count;       // slots that have pools
+    Rvk_Record_Slot slots[RVK_MAX_RECORD_THREADS];
+} Rvk_Parallel_Record;
+
+/* optional device features, filled in by rvk_device_init from the queried VkPhysicalDeviceFeatures2 chain */
+typedef struct {
+    bool timeline_semaphore;    // always enabled, rag_vk needs it
+    bool synchronization2;      // always enabled where supported, vkCmdPipelineBarrier otherwise
+    bool int64_atomics;         // shaderInt64 + shaderBufferInt64Atomics, rvk_enable_atomic_features
+    bool multiview;             // rvk_enable_multiview_feature
+    bool dynamic_rendering;     // rvk_enable_dynamic_rendering, render passes otherwise
+    bool descriptor_indexing;   // what the bindless table needs, rvk_enable_bindless
+    bool buffer_device_address; // rvk_enable_buffer_device_address
+    bool multi_draw_indirect;   // multiDrawIndirect + drawIndirectFirstInstance, rvk_enable_draw_indirect
+    bool draw_indirect_count;   // vkCmdDrawIndexedIndirectCount, rvk_enable_draw_indirect
+} Rvk_Device_Features;
+
 typedef struct {
     VkInstance instance;
     VkDebugUtilsMessengerEXT debug_msgr;
@@ -149,10 +524,30 @@ typedef struct {
     uint32_t queue_idx;
     VkQueue unified_queue;
     VkCommandPool pool;
+    Rvk_Transfer_Queue transfer;
+    Rvk_Compute_Queue compute;
+    Rvk_Parallel_Record parallel;
+
+    /* cmd_buff, img_avail_sem, and fence always alias the current frame */
     VkCommandBuffer cmd_buff;
     VkSemaphore img_avail_sem;
-    VkSemaphore render_fin_sem;
     VkFence fence;
+    /* one per swapchain image, not per frame: the frame's fence says nothing about when
+     * the presentation engine is done waiting on it */
+    VkSemaphore render_fin_sems[RVK_MAX_SWAPCHAIN_IMAGES];
+    Rvk_Frame frames[RVK_MAX_FRAMES_IN_FLIGHT];
+    uint32_t frames_in_flight;
+    uint32_t frame_idx;
+    Rvk_Timeline timeline;
+    Rvk_Staging_Ring stg_ring;
+    Rvk_Mem_Allocator mem_allocator;
+    VkPipelineCache pl_cache;
+    const char *pl_cache_path;
+    Rvk_Shader_Registry shaders;
+    Rvk_Bindless_Table bindless;
+    Rvk_Cmd_State cmd_state;  // of cmd_buff while it is recording
+    Rvk_Cmd_Stats cmd_stats;  // of the last finished recording
+
     VkSurfaceKHR surface;
     VkSurfaceFormatKHR surface_fmt;
     VkExtent2D extent;
@@ -162,16 +557,27 @@ typedef struct {
     VkImageView depth_img_view;
     bool using_validation;
 
-    // TODO: this is really hacky of me, I should have a proper way
-    // to query/enable features
+    /* requested with rvk_enable_* before init, rvk_device_init enables the ones the device
+     * supports. render paths check features, never the requests */
     bool enable_atomic_features;
     bool enable_multiview_feature;
+    bool enable_dynamic_rendering;
+    bool enable_bindless;
+    bool enable_draw_indirect;
+    bool enable_buffer_device_address;
+    Rvk_Device_Features supported; // what the device could enable
+    Rvk_Device_Features features;  // what was enabled
 } Rvk_Context;
 
 typedef struct {
     int width;
     int height;
     const char *title;
+    uint32_t frames_in_flight;      // defaults to RVK_DEFAULT_FRAMES_IN_FLIGHT
+    VkDeviceSize staging_ring_size; // defaults to RVK_DEFAULT_STAGING_RING_SIZE
+    const char *pipeline_cache_path; // defaults to RVK_DEFAULT_PIPELINE_CACHE_PATH
+    bool no_transfer_queue;          // keep upload batches on the unified queue
+    bool no_async_compute;           // submit compute on the unified queue
 } Rvk_Config;
 #define rvk_init(...) rvk_init_((Rvk_Config){__VA_ARGS__})
 void rvk_init_(Rvk_Config cfg);
@@ -185,7 +591,27 @@ void rvk_img_views_init(void);
 void rvk_img_view_init(Rvk_Image img, VkImageView *img_view);
 void rvk_sst_pl_init(VkPipelineLayout pl_layout, VkPipeline *pl);
 void rvk_compute_pl_init(const char *shader_name, VkPipelineLayout pl_layout, VkPipeline *pipeline);
-void rvk_shader_mod_init(const char *file_name, VkShaderModule *module);
+void rvk_compute_pl_init_spec(const char *shader_name, VkPipelineLayout pl_layout, const VkSpecializationInfo *spec_info, VkPipeline *pipeline);
+
+/* specialization constants, picked at pipeline creation instead of baked into the spir-v
+ * e.g. layout(local_size_x_id = 0) in; layout(constant_id = 1) const int WIDTH = 1600; */
+#define RVK_MAX_SPEC_CONSTANTS 16
+typedef struct {
+    VkSpecializationMapEntry entries[RVK_MAX_SPEC_CONSTANTS];
+    uint32_t data[RVK_MAX_SPEC_CONSTANTS];
+    VkSpecializationInfo info;
+} Rvk_Spec_Constants;
+
+/* constant_id i gets values[i], every constant is 32 bits (int, uint, float bits, or bool) */
+const VkSpecializationInfo *rvk_spec_constants(Rvk_Spec_Constants *spec, const uint32_t *values, uint32_t count);
+uint32_t rvk_max_compute_workgroup_size(void); // largest local_size_x (with y = z = 1) the device allows
+void rvk_shader_mod_init(const char *file_name, VkShaderModule *module); // caller owns the module
+
+/* registry: a module stays cached after its last release until rvk_shader_registry_trim or rvk_destroy */
+VkShaderModule rvk_shader_acquire(const char *file_name);
+void rvk_shader_release(VkShaderModule module);
+void rvk_shader_registry_trim(void);    // destroys every module that nobody holds
+void rvk_shader_registry_destroy(void);
 void rvk_render_pass_init(void);
 VkRenderPass rvk_create_basic_render_pass(void);
 VkRenderPass rvk_create_multiview_render_pass(void);
@@ -198,12 +624,30 @@ void rvk_destroy_frame_buff(VkFramebuffer frame_buff);
 void rvk_recreate_swapchain(void);
 void rvk_depth_init(void);
 void rvk_destroy_pl_res(VkPipeline pipeline, VkPipelineLayout pl_layout);
+/* the recording thread's secondary inside a parallel pass, the frame's primary otherwise. the primary
+ * of a parallel pass only takes secondaries, so outside rvk_record_parallel this logs an error and
+ * returns VK_NULL_HANDLE, and the rvk_ drawing helpers record nothing */
 VkCommandBuffer rvk_get_cmd_buff(void);
 VkCommandBuffer rvk_get_comp_buff(void);
 void rvk_reset_pool(VkDescriptorPool pool);
 double rvk_dt(void);
 void rvk_enable_atomic_features();
 void rvk_enable_multiview_feature();
+void rvk_enable_dynamic_rendering(); // vkCmdBeginRendering instead of render pass and framebuffer objects
+void rvk_enable_bindless();          // descriptor indexing, see Rvk_Bindless_Table
+void rvk_enable_draw_indirect();     // multi draw indirect, plus the draw count from a buffer where supported
+void rvk_enable_buffer_device_address(); // every memory block can then back SHADER_DEVICE_ADDRESS buffers
+VkDeviceAddress rvk_buff_device_address(Rvk_Buffer buff);
+void rvk_set_frames_in_flight(uint32_t count);
+uint32_t rvk_get_frames_in_flight(void);
+
+/* pipelines are created through a cache that rvk_init loads from disk and rvk_destroy saves
+ * back, so later runs skip shader compilation. The file is only used when it was written
+ * by the same device and driver version */
+#define RVK_DEFAULT_PIPELINE_CACHE_PATH "./.rvk_pipeline_cache"
+void rvk_pl_cache_init(const char *path);
+void rvk_pl_cache_save(void);
+void rvk_pl_cache_destroy(void); // saves first
 
 /* platform specifics */
 #ifdef PLATFORM_DESKTOP_GLFW
@@ -220,6 +664,17 @@ double rvk_get_glfw_time();
 void rvk_set_android_asset_man(AAssetManager *aam);
 #endif
 
+#ifdef PLATFORM_HEADLESS
+/* renders into images owned by rag_vk instead of a swapchain (no window or surface needed) */
+void rvk_headless_imgs_init(void);
+void rvk_headless_imgs_destroy(void);
+double rvk_get_headless_time(void);
+
+/* copies the most recently submitted frame (R8G8B8A8, width*height*4 bytes) into dst, waits for the gpu
+   logs an error and leaves dst untouched if no frame has been submitted yet */
+void rvk_headless_read_frame(void *dst);
+#endif
+
 // TODO: switch to verb object
 void rvk_descriptor_pool_arena_init(Rvk_Descriptor_Pool_Arena *arena);
 void rvk_destroy_descriptor_pool_arena(Rvk_Descriptor_Pool_Arena arena);
@@ -231,6 +686,28 @@ void rvk_log_descriptor_pool_usage(Rvk_Descriptor_Pool_Arena arena);
 void rvk_log_descriptor_layout_usage(Rvk_Descriptor_Set_Layout layout, const char *shader_name);
 void rvk_descriptor_pool_arena_destroy(Rvk_Descriptor_Pool_Arena arena);
 
+/* per-frame arena of the current frame in flight, its sets stay valid until this
+ * frame slot comes around again, so they can be allocated and written every frame */
+Rvk_Descriptor_Pool_Arena *rvk_frame_ds_arena(void);
+void rvk_frame_alloc_set(Rvk_Descriptor_Set_Layout *ds_layout, VkDescriptorSet *set);
+
+/* bindless table, created at init when rvk_enable_bindless() was called first.
+ * the add functions return the array index shaders use, RVK_BINDLESS_NONE when the table is full.
+ * removed slots wait for the next frame submission, and are reused once that frame, and so every
+ * frame that might read them, has finished */
+void rvk_bindless_init(void);
+void rvk_bindless_destroy(void);
+void rvk_bindless_submit(uint32_t frame_idx); // frame_idx was submitted, it takes the slots removed since the last one
+void rvk_bindless_retire(uint32_t frame_idx); // frame_idx's fence has signaled, its removed slots become free
+uint32_t rvk_bindless_add_texture(Rvk_Texture tex);
+uint32_t rvk_bindless_add_storage_buffer(Rvk_Buffer buff);
+uint32_t rvk_bindless_add_storage_image(VkImageView view);
+void rvk_bindless_update_texture(uint32_t idx, Rvk_Texture tex); // point a live slot at another texture
+void rvk_bindless_remove(Rvk_Bindless_Kind kind, uint32_t idx);
+VkDescriptorSetLayout rvk_bindless_layout(void); // goes in set 0 of pipeline layouts that read the table
+void rvk_bind_bindless(VkPipelineLayout pl_layout, VkPipelineBindPoint bind_point); // once per command buffer
+void rvk_cmd_bind_bindless(VkCommandBuffer cmd_buff, VkPipelineLayout pl_layout, VkPipelineBindPoint bind_point);
+
 typedef struct {
     VkPipelineLayout pl_layout;
     const char *vert;
@@ -242,6 +719,7 @@ typedef struct {
     VkVertexInputBindingDescription *vert_bindings;
     size_t vert_binding_count;
     VkRenderPass render_pass;
+    const Rvk_Render_Texture *render_texture; // target instead of the swapchain, works with or without dynamic rendering
 } Pipeline_Config;
 
 void rvk_pl_layout_init(VkPipelineLayoutCreateInfo ci, VkPipelineLayout *pl_layout);
@@ -284,6 +762,9 @@ typedef struct {
     // extended but lazily assumes this order
     const char *vertex_shader_name;
     const char *fragment_shader_name;
+    const VkSpecializationInfo *p_vertex_specialization_info;   // only used with the shader names
+    const VkSpecializationInfo *p_fragment_specialization_info;
+    const Rvk_Render_Texture *render_texture; // target instead of the swapchain, works with or without dynamic rendering
 } Rvk_Graphics_Pipeline_Create_Info;
 
 // notes that the name is create_graphics_pipelines with an "s" to be consistent with vkCreateGraphicsPipelines
@@ -291,6 +772,54 @@ typedef struct {
 #define rvk_create_graphics_pipelines(pl, ...) rvk_create_graphics_pipelines_(pl, (Rvk_Graphics_Pipeline_Create_Info){__VA_ARGS__})
 void rvk_create_graphics_pipelines_(VkPipeline *pl, Rvk_Graphics_Pipeline_Create_Info ci);
 
+/* Between rvk_begin_pipeline_batch and rvk_end_pipeline_batch, rvk_create_graphics_pipelines,
+ * rvk_compute_pl_init, rvk_sst_pl_init, and rvk_basic_pl_init only record their create info.
+ * The end call creates everything, one vkCreate*Pipelines call per kind, or split over
+ * thread_count worker threads, and returns once every VkPipeline is written.
+ * pNext chains, specialization info, and sample masks are not copied, so they must stay
+ * alive until the batch ends (the other state is copied and can be stack locals) */
+#define RVK_MAX_PIPELINE_STAGES 5
+typedef struct {
+    VkPipeline *pl;
+    VkGraphicsPipelineCreateInfo ci;
+    VkPipelineShaderStageCreateInfo stages[RVK_MAX_PIPELINE_STAGES];
+    VkShaderModule release[2]; // registry modules to release once the pipeline exists
+    VkPipelineVertexInputStateCreateInfo vertex_input;
+    VkPipelineInputAssemblyStateCreateInfo input_assembly;
+    VkPipelineTessellationStateCreateInfo tessellation;
+    VkPipelineViewportStateCreateInfo viewport;
+    VkPipelineRasterizationStateCreateInfo rasterization;
+    VkPipelineMultisampleStateCreateInfo multisample;
+    VkPipelineDepthStencilStateCreateInfo depth_stencil;
+    VkPipelineColorBlendStateCreateInfo color_blend;
+    VkPipelineDynamicStateCreateInfo dynamic;
+    VkPipelineRenderingCreateInfo rendering; // only when it heads the pNext chain (dynamic rendering)
+    VkFormat color_fmt;
+    void *arrays[6]; // heap copies of the arrays the states above point to
+} Rvk_Pending_Gfx_Pipeline;
+
+typedef struct {
+    VkPipeline *pl;
+    VkComputePipelineCreateInfo ci;
+    VkShaderModule release;
+} Rvk_Pending_Compute_Pipeline;
+
+typedef struct {
+    struct {
+        Rvk_Pending_Gfx_Pipeline *items;
+        size_t count;
+        size_t capacity;
+    } gfx;
+    struct {
+        Rvk_Pending_Compute_Pipeline *items;
+        size_t count;
+        size_t capacity;
+    } compute;
+} Rvk_Pipeline_Batch;
+
+void rvk_begin_pipeline_batch(Rvk_Pipeline_Batch *batch);
+void rvk_end_pipeline_batch(Rvk_Pipeline_Batch *batch, uint32_t thread_count); // 0 or 1 means no worker threads
+
 void rvk_wait_to_begin_gfx();
 void rvk_begin_rec_gfx();
 void rvk_wait_reset();
@@ -302,9 +831,42 @@ void rvk_end_rec_gfx();
 void rvk_end_command_buffer(VkCommandBuffer cmd_buff);
 void rvk_begin_render_pass(float r, float g, float b, float a);
 void rvk_begin_offscreen_render_pass(float r, float g, float b, float a, VkRenderPass rp, VkFramebuffer fb, VkExtent2D extent);
+void rvk_begin_render_texture(Rvk_Render_Texture rt, float r, float g, float b, float a); // either path, ended by rvk_end_render_pass
 void rvk_end_render_pass();
 void rvk_cmd_end_render_pass(VkCommandBuffer cmd_buff);
-void rvk_submit_gfx();
+uint64_t rvk_submit_gfx(); // returns the frame's timeline value
+
+/* splits a pass across threads. rvk_begin_parallel_render_pass begins the swapchain pass for
+ * secondary command buffers only, each rvk_record_parallel then runs record(i, thread_count, data)
+ * on thread_count threads, the calling thread taking slice 0. the drawing helpers (rvk_bind_gfx,
+ * rvk_push_const, rvk_draw_buffers_range, ...) called from record go to that thread's secondary,
+ * with bind tracking of its own, and the secondaries are executed in slice order once every
+ * thread is done. record must not touch other rvk_ctx state, rvk_end_render_pass ends the pass */
+typedef void (*Rvk_Record_Fn)(uint32_t thread_idx, uint32_t thread_count, void *data);
+void rvk_begin_parallel_render_pass(float r, float g, float b, float a);
+void rvk_record_parallel(uint32_t thread_count, Rvk_Record_Fn record, void *data); // at most RVK_MAX_RECORD_THREADS
+
+/* records the frame's compute into its own command buffer, every recording helper (rvk_dispatch,
+ * rvk_push_const, rvk_compute_pl_barrier, ...) targets it until rvk_submit_compute. the submission
+ * first waits for the graphics timeline to reach wait_gfx_value (0 waits on nothing). with one copy
+ * of its resources per frame in flight, rvk_frame_gfx_value() is enough and lets the compute overlap
+ * the previous frame's graphics, resources shared by all frames need rvk_timeline_submitted(rvk_gfx_timeline()) */
+void rvk_begin_rec_compute(void);
+uint64_t rvk_submit_compute(uint64_t wait_gfx_value); // returns the compute timeline value
+uint64_t rvk_frame_gfx_value(void); // graphics value of the last frame that used the current frame index, 0 if none
+
+/* completion tracking, each submission made through rag_vk signals the next value of its queue's
+ * timeline and returns that value. values of one timeline complete in order, but the graphics,
+ * compute and transfer timelines are independent, a value only means something on its own timeline */
+Rvk_Timeline *rvk_gfx_timeline(void);
+Rvk_Timeline *rvk_compute_timeline(void);
+Rvk_Timeline *rvk_transfer_timeline(void);        // the graphics one without a dedicated transfer queue
+Rvk_Timeline *rvk_queue_timeline(VkQueue queue);  // timeline signaled by submissions to queue
+uint64_t rvk_timeline_submitted(Rvk_Timeline *timeline);                // value of the most recent submission
+uint64_t rvk_timeline_completed(Rvk_Timeline *timeline);                // does not block
+bool rvk_timeline_is_complete(Rvk_Timeline *timeline, uint64_t value);  // does not block
+void rvk_timeline_wait(Rvk_Timeline *timeline, uint64_t value);
+void rvk_timeline_retire(void);                // destroys deferred resources whose work is done, run once per frame
 
 typedef struct {
     const void* p_next;
@@ -316,8 +878,9 @@ typedef struct {
     uint32_t signal_semaphore_count;
     const VkSemaphore* p_signal_semaphores;
 } Rvk_Submit_Info;
+/* the timeline semaphore is added to the signal semaphores, so p_next must not hold a VkTimelineSemaphoreSubmitInfo */
 #define rvk_queue_submit(queue, fence, ...) rvk_queue_submit_(queue, fence, (Rvk_Submit_Info){__VA_ARGS__})
-void rvk_queue_submit_(VkQueue queue, VkFence fence, Rvk_Submit_Info rvk_si);
+uint64_t rvk_queue_submit_(VkQueue queue, VkFence fence, Rvk_Submit_Info rvk_si); // returns the value on rvk_queue_timeline(queue)
 
 typedef struct {
     const void* p_next;
@@ -333,7 +896,21 @@ void rvk_cmd_begin_render_pass_(VkCommandBuffer cmd_buff, Rvk_Render_Pass_Begin_
 void rvk_draw(VkPipeline pl, VkPipelineLayout pl_layout, Rvk_Buffer vtx_buff, Rvk_Buffer idx_buff, void *float16_mvp);
 void rvk_bind_gfx(VkPipeline pl, VkPipelineLayout pl_layout, VkDescriptorSet *ds, size_t ds_count);
 void rvk_bind_gfx_extent(VkPipeline pl, VkPipelineLayout pl_layout, VkDescriptorSet *ds, size_t ds_count, VkExtent2D extent);
-void rvk_draw_buffers(Rvk_Buffer vtx_buff, Rvk_Buffer idx_buff);
+/* one mesh inside vertex and index buffers shared by several meshes, indices are relative to vtx_offset */
+typedef struct {
+    uint32_t first_idx;
+    uint32_t idx_count;
+    int32_t vtx_offset;
+} Rvk_Draw_Range;
+
+void rvk_draw_buffers(Rvk_Buffer vtx_buff, Rvk_Buffer idx_buff); // the whole index buffer
+void rvk_draw_buffers_range(Rvk_Buffer vtx_buff, Rvk_Buffer idx_buff, Rvk_Draw_Range range);
+/* per-instance attributes come from binding 1, read from inst_buff starting at inst_offset */
+void rvk_draw_buffers_instanced(Rvk_Buffer vtx_buff, Rvk_Buffer idx_buff, Rvk_Draw_Range range, Rvk_Buffer inst_buff, VkDeviceSize inst_offset, uint32_t instance_count);
+/* up to max_draws VkDrawIndexedIndirectCommands from cmds, the first uint32_t at count_offset in count_buff
+ * says how many. without drawIndirectCount all max_draws are drawn, so unused commands must be zeroed */
+void rvk_draw_indexed_indirect_count(Rvk_Buffer vtx_buff, Rvk_Buffer idx_buff, Rvk_Buffer cmds, VkDeviceSize cmd_offset,
+                                     Rvk_Buffer count_buff, VkDeviceSize count_offset, uint32_t max_draws);
 void rvk_bind_vertex_buffers(Rvk_Buffer vtx_buff);
 void rvk_draw_points(Rvk_Buffer vtx_buff, void *float16_mvp, VkPipeline pl, VkPipelineLayout pl_layout, VkDescriptorSet *ds_sets, size_t ds_set_count);
 void rvk_draw_sst(VkPipeline pl, VkPipelineLayout pl_layout, VkDescriptorSet ds);
@@ -350,6 +927,18 @@ void rvk_compute_pl_barrier();
 void rvk_buff_init(size_t size, size_t count, VkBufferUsageFlags usage, VkMemoryPropertyFlags mem_props, Rvk_Buffer_Type type, void *data, Rvk_Buffer *buffer);
 void rvk_uniform_buff_init(size_t size, void *data, Rvk_Buffer *buffer);
 Rvk_Buffer rvk_create_mapped_uniform_buff(size_t size, void *data);
+Rvk_Buffer rvk_create_mapped_vertex_buff(size_t size, size_t count); // host visible, written by the cpu every frame
+Rvk_Buffer rvk_create_indirect_buff(size_t size, size_t count);      // device local, written by compute and read as draw commands
+
+/* One copy of a buffer per frame in flight, so the cpu can write the
+ * next frame's data while the gpu still reads the previous frame's copy */
+typedef struct {
+    Rvk_Buffer buffs[RVK_MAX_FRAMES_IN_FLIGHT];
+    uint32_t count;
+} Rvk_Frame_Buffer;
+Rvk_Frame_Buffer rvk_create_mapped_uniform_frame_buff(size_t size, void *data);
+Rvk_Buffer *rvk_frame_buff_get(Rvk_Frame_Buffer *frame_buff); // current frame's copy
+void rvk_destroy_frame_buffer(Rvk_Frame_Buffer frame_buff);
 void rvk_comp_buff_init(size_t size, size_t count, void *data, Rvk_Buffer *buffer);
 Rvk_Buffer rvk_upload_compute_buff(size_t size, size_t count, void *data);
 void rvk_vtx_buff_init(size_t size, size_t count, void *data, Rvk_Buffer *buffer);
@@ -360,6 +949,7 @@ Rvk_Buffer rvk_upload_vtx_buff2(size_t size, size_t count, void *data);
 Rvk_Buffer rvk_create_vertex_buffer(size_t size, size_t count, void *data);
 Rvk_Buffer rvk_create_index_buffer(size_t size, size_t count, void *data);
 void rvk_upload_idx_buff(size_t size, size_t count, void *data, Rvk_Buffer *buffer);
+/* the buffer is destroyed once the gpu has finished the next frame submission, no need to wait idle first */
 void rvk_buff_destroy(Rvk_Buffer buffer);
 void rvk_destroy_buffer(Rvk_Buffer buffer);
 void rvk_buff_map(Rvk_Buffer *buff);
@@ -367,8 +957,60 @@ void rvk_buff_unmap(Rvk_Buffer buff);
 void rvk_buff_staged_upload(Rvk_Buffer buff);
 const char *rvk_buff_type_as_str(Rvk_Buffer_Type type);
 
-/* Copies "size" bytes from src to dst buffer, a value of zero implies copying the whole src buffer */
+/* Copies "size" bytes from src to dst buffer, a value of zero implies copying the whole src buffer.
+ * the source is usually a buffer the unified queue has been using, so with a dedicated transfer
+ * queue the copy runs on the unified queue right away (and blocks). it would then run ahead of
+ * the batch's uploads into src, so inside a batch that is an error */
 void rvk_buff_copy(Rvk_Buffer dst_buff, Rvk_Buffer src_buff, VkDeviceSize size);
+void rvk_cmd_buff_copy(VkCommandBuffer cmd_buff, Rvk_Buffer dst_buff, Rvk_Buffer src_buff, VkDeviceSize size);
+
+/* Records any number of buffer copies, image copies, and layout transitions into one
+ * command buffer that is submitted once, instead of a submit + queue drain per upload.
+ * Between rvk_begin_upload_batch and rvk_submit_upload_batch, the upload helpers
+ * (rvk_buff_staged_upload, rvk_img_copy, rvk_transition_img_layout, rvk_load_texture,
+ * rvk_upload_*_buff, ...) record into the caller's batch. rvk_buff_copy does too, unless the
+ * batch runs on a dedicated transfer queue, then it may not be called inside the batch.
+ *
+ * With a dedicated transfer queue the batch runs there while frames keep rendering, the buffers
+ * and images it wrote are handed to the unified queue (ownership transfer + timeline wait) once it
+ * completes, rvk_upload_batch_done turns true when that handoff has been submitted. The batch
+ * first waits for every graphics submission made before it, so it never overwrites what an
+ * in-flight frame still reads. Resources written are expected to be replaced whole (or be new),
+ * the unified queue does not release them back first. Uploads made outside a batch stay on the
+ * unified queue. timeline_value only means something on the batch's timeline, waiting on it there
+ * covers the copies but not the handoff, rvk_upload_batch_done covers both */
+typedef struct {
+    VkCommandBuffer cmd_buff;
+    VkFence fence;
+    Rvk_Timeline *timeline;  // set when submitted, the transfer timeline when the queue is dedicated
+    uint64_t timeline_value; // value on timeline, not comparable with graphics values
+    size_t cmd_count;
+} Rvk_Upload_Batch;
+
+void rvk_begin_upload_batch(Rvk_Upload_Batch *batch);
+VkFence rvk_submit_upload_batch(Rvk_Upload_Batch *batch); // does not wait, returns the fence to wait on
+bool rvk_upload_batch_done(Rvk_Upload_Batch *batch);       // does not block, the batch's writes are usable once true
+void rvk_wait_upload_batch(Rvk_Upload_Batch *batch);      // waits, then frees the batch's resources
+void rvk_end_upload_batch(Rvk_Upload_Batch *batch);       // submit + wait
+
+/* uploads go through the staging ring, anything larger than rvk_stg_ring_max_chunk()
+ * is split into several copies. Outside of a batch these block until the copy is done.
+ * in a batch on a dedicated transfer queue, rvk_buff_upload has to write the whole buffer */
+void rvk_buff_upload(Rvk_Buffer dst_buff, VkDeviceSize dst_offset, const void *data, VkDeviceSize size);
+/* records the copies into the frame's command buffer instead, so the upload is ordered with the
+ * frame's other work and does not block, the staging ranges are reclaimed once the frame completes.
+ * everything uploaded this way in one frame has to fit in the staging ring */
+void rvk_frame_buff_upload(Rvk_Buffer dst_buff, VkDeviceSize dst_offset, const void *data, VkDeviceSize size);
+void rvk_img_upload(VkImage dst_img, VkExtent2D extent, VkFormat fmt, const void *data); // image must be in TRANSFER_DST_OPTIMAL
+
+/* the ring is created by rvk_init, ranges are handed out for one owner and reclaimed once the
+ * submission of that owner has completed on its timeline */
+void rvk_stg_ring_init(VkDeviceSize size);
+void rvk_stg_ring_destroy(void);
+Rvk_Staging_Range rvk_stg_ring_alloc(Rvk_Staging_Owner owner, VkDeviceSize size, VkDeviceSize alignment); // may block on older uploads
+VkDeviceSize rvk_stg_ring_max_chunk(void);
+void rvk_stg_ring_submit(Rvk_Staging_Owner owner, Rvk_Timeline *timeline, uint64_t value); // owner's ranges so far are read by value
+void rvk_stg_ring_retire(void); // reclaims the oldest spans whose values have been reached
 
 void rvk_storage_tex_init(Rvk_Texture *texture, VkExtent2D extent);
 void rvk_pl_barrier(VkImageMemoryBarrier barrier);
@@ -378,6 +1020,21 @@ void rvk_raster_sampler_barrier(VkImage img);
 void rvk_depth_img_barrier(VkImage depth_img);
 void rvk_color_img_barrier(VkImage color_img);
 void rvk_swapchain_img_barrier(void);
+
+/* orders this frame's compute work after the previous frame's shader accesses,
+ * needed when resources are shared (i.e. not per-frame) across frames in flight */
+void rvk_frame_compute_barrier(void);
+
+/* global memory barrier in the frame's command buffer, e.g. compute writes before indirect reads */
+void rvk_mem_barrier(VkPipelineStageFlags src_stage, VkAccessFlags src_access, VkPipelineStageFlags dst_stage, VkAccessFlags dst_access);
+
+/* the recording helpers skip binds and dynamic state that would not change anything.
+ * call rvk_cmd_state_invalidate after recording state into rvk_get_cmd_buff() by hand */
+void rvk_cmd_state_invalidate(void);
+Rvk_Cmd_Stats rvk_get_cmd_stats(void); // counters of the last frame that finished recording
+void rvk_log_cmd_stats(void);
+
+/* moves rvk_ctx to the next frame in flight, rvk_submit_gfx calls this after present */
 uint32_t rvk_advance_frame(void);
 uint32_t rvk_get_frame_idx(void);
 
@@ -388,6 +1045,9 @@ void rvk_destroy_ds_pool(VkDescriptorPool pool);
 void rvk_destroy_descriptor_set_layout(VkDescriptorSetLayout layout);
 bool rvk_alloc_ds(VkDescriptorSetAllocateInfo alloc, VkDescriptorSet *sets);
 void rvk_update_ds(size_t count, VkWriteDescriptorSet *writes);
+void rvk_ds_template_init(Rvk_Descriptor_Set_Layout *layout, Rvk_Ds_Template *tmpl);
+void rvk_update_ds_with_template(Rvk_Ds_Template *tmpl, VkDescriptorSet set, const Rvk_Descriptor_Info *infos);
+void rvk_destroy_ds_template(Rvk_Ds_Template tmpl);
 
 
 typedef enum {
@@ -412,17 +1072,31 @@ bool rvk_is_device_suitable(VkPhysicalDevice phys_device);
 void rvk_pick_phys_device();
 void rvk_destroy_swapchain();
 bool rvk_find_mem_type_idx(uint32_t type, VkMemoryPropertyFlags properties, uint32_t *idx);
+
+Rvk_Allocation rvk_mem_alloc(VkMemoryRequirements mem_reqs, VkMemoryPropertyFlags properties, bool linear);
+void rvk_mem_free(Rvk_Allocation alloc);
+void *rvk_mem_map(Rvk_Allocation alloc);   // memory must be host visible, blocks stay mapped while any range is
+void rvk_mem_unmap(Rvk_Allocation alloc);
+void rvk_mem_destroy(void);                 // frees every block, called by rvk_destroy
+Rvk_Mem_Stats rvk_mem_stats(void);
+void rvk_mem_log_stats(void);
+void rvk_img_destroy(Rvk_Image img);
 uint32_t rvk_get_unified_gfx_and_present_queue_idx(VkPhysicalDevice phys_device);
 bool rvk_has_unified_gfx_and_present_queue(VkPhysicalDevice phys_device);
 void rvk_img_init(Rvk_Image *img, VkImageUsageFlags usage, VkMemoryPropertyFlags properties);
 void rvk_img_copy(VkImage dst_img, VkBuffer src_buff, VkExtent2D extent);
+void rvk_cmd_img_copy(VkCommandBuffer cmd_buff, VkImage dst_img, VkBuffer src_buff, VkExtent2D extent);
 Rvk_Texture rvk_load_texture(void *data, size_t width, size_t height, VkFormat fmt);
 Rvk_Render_Texture rvk_create_render_texture(VkExtent2D extent);
 Rvk_Render_Texture rvk_create_multiview_render_texture(VkExtent2D extent, uint32_t view_count);
 void rvk_destroy_render_texture(Rvk_Render_Texture rt);
-void rvk_unload_texture(Rvk_Texture texture);
+/* recreates the images (and pass objects if any) at the new size, the gpu must be done with the old ones
+ * and descriptor sets that sampled them need rewriting with the new views */
+void rvk_resize_render_texture(Rvk_Render_Texture *rt, VkExtent2D extent);
+void rvk_unload_texture(Rvk_Texture texture); // deferred like rvk_buff_destroy
 void rvk_destroy_texture(Rvk_Texture texture);
 void rvk_transition_img_layout(VkImage image, VkImageLayout old_layout, VkImageLayout new_layout);
+void rvk_cmd_transition_img_layout(VkCommandBuffer cmd_buff, VkImage image, VkImageLayout old_layout, VkImageLayout new_layout);
 void rvk_sampler_init(VkSampler *sampler);
 int rvk_format_to_size(VkFormat fmt);
 
@@ -506,6 +1180,7 @@ typedef struct {
 } Rvk_String_Builder;
 
 bool rvk_read_entire_file(const char *path, Rvk_String_Builder *sb);
+bool rvk_write_entire_file(const char *path, const void *data, size_t size);
 
 #define rvk_sb_free(sb) RVK_FREE((sb).items)
 
@@ -523,6 +1198,25 @@ typedef struct {
 void rvk_allocate_command_buffer_(VkCommandBuffer *buff, Rvk_Command_Buffer_Allocate_Info ci);
 
 void rvk_cmd_syncs_init();
+void rvk_timeline_init(Rvk_Timeline *timeline);
+void rvk_timeline_destroy();
+/* wait_values holds one value per wait semaphore when some of them are timelines, NULL otherwise */
+uint64_t rvk_timeline_submit(Rvk_Timeline *timeline, VkQueue queue, VkSubmitInfo si, VkFence fence, const uint64_t *wait_values);
+void rvk_transfer_queue_pick(VkPhysicalDevice phys_device);
+void rvk_compute_queue_pick(VkPhysicalDevice phys_device);
+void rvk_transfer_queue_destroy();
+void rvk_transfer_release_buff(VkBuffer buff);
+void rvk_transfer_release(VkCommandBuffer cmd_buff);
+void rvk_transfer_acquire_completed();
+void rvk_record_slots_reset();
+void rvk_record_slots_destroy();
+void rvk_img_layout_masks(VkImageLayout old_layout, VkImageLayout new_layout,
+                          VkPipelineStageFlags *src_stage, VkPipelineStageFlags *dst_stage,
+                          VkAccessFlags *src_access, VkAccessFlags *dst_access);
+void rvk_timeline_assign_deferred(uint64_t value); // deferred resources without a value retire with this one
+void rvk_defer_destroy(Rvk_Deferred_Destroy res);
+void rvk_destroy_deferred(Rvk_Deferred_Destroy res);
+void rvk_use_frame(uint32_t frame_idx);
 void rvk_cmd_pool_init();
 void rvk_create_semaphore(VkSemaphore *semaphore);
 void rvk_create_fence(VkFence *fence);
@@ -535,6 +1229,11 @@ VkCommandBuffer rvk_cmd_quick_begin(void);
 /* Ends and frees a temporary command buffer. Easy-to-use, not super efficent. */
 void rvk_cmd_quick_end(VkCommandBuffer *tmp_cmd_buff);
 
+/* same as quick begin/end, unless an upload batch is active, then it records into the batch */
+VkCommandBuffer rvk_upload_cmd_begin(void);
+void rvk_upload_cmd_end(VkCommandBuffer *cmd_buff);
+Rvk_Staging_Owner rvk_upload_owner(void); // who the staging ranges of the next upload belong to
+
 typedef struct {
     const char **items;
     size_t count;
@@ -560,6 +1259,13 @@ void rvk_handle_bad_vk_result(VkResult result, const char* function);
 #ifdef RAG_VK_IMPLEMENTATION
 
 #include <vulkan/vulkan.h>
+#include <pthread.h>
+#if !defined(_WIN32) && !defined(PLATFORM_ANDROID_QUEST)
+#include <sys/mman.h> // shader files are memory mapped
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 #define Z_NEAR 0.01
 #define Z_FAR 500.0
@@ -569,9 +1275,42 @@ Rvk_Context rvk_ctx = {0};
 /* swapchain image index */
 static uint32_t rvk_img_idx = 0;
 
+/* timeline semaphore entry points, core in 1.2 but an extension on quest */
+static PFN_vkWaitSemaphores rvk_wait_semaphores_pfn = NULL;
+static PFN_vkGetSemaphoreCounterValue rvk_get_semaphore_counter_value_pfn = NULL;
+
+/* dynamic rendering entry points, loaded at device creation since they are vulkan 1.3 */
+static PFN_vkCmdBeginRendering rvk_cmd_begin_rendering_pfn = NULL;
+static PFN_vkCmdEndRendering rvk_cmd_end_rendering_pfn = NULL;
+
+/* attachments of the dynamic rendering pass being recorded, moved to their final layouts when it ends */
+typedef struct {
+    bool active;
+    bool secondary; // contents come from rvk_record_parallel
+    VkImage color;
+    VkImage depth;
+    uint32_t layer_count;
+    VkImageLayout color_final;
+    VkImageLayout depth_final;
+} Rvk_Dynamic_Target;
+static Rvk_Dynamic_Target rvk_dynamic_target = {0};
+
+#if defined(_MSC_VER)
+    #define RVK_THREAD_LOCAL __declspec(thread)
+#else
+    #define RVK_THREAD_LOCAL _Thread_local
+#endif
+
+/* slot the calling thread records into during rvk_record_parallel, NULL everywhere else */
+static RVK_THREAD_LOCAL Rvk_Record_Slot *rvk_record_slot = NULL;
+
 /* various extensions & validation layers here */
 static const char *rvk_validation_layers[] = { "VK_LAYER_KHRONOS_validation" };
+#ifdef PLATFORM_ANDROID_QUEST
+static const char *rvk_device_exts[] = { VK_KHR_SWAPCHAIN_EXTENSION_NAME, VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME };
+#else
 static const char *rvk_device_exts[] = { VK_KHR_SWAPCHAIN_EXTENSION_NAME };
+#endif
 Rvk_Instance_Exts rvk_inst_exts = {0};
 
 #ifdef PLATFORM_ANDROID_QUEST
@@ -602,7 +1341,7 @@ void rvk_log(Rvk_Log_Level level, const char *fmt, ...)
          __android_log_vprint(ANDROID_LOG_ERROR,  APP_NAME, fmt, args);
         break;
     }
-#elif defined(PLATFORM_DESKTOP_GLFW)
+#elif defined(PLATFORM_DESKTOP_GLFW) || defined(PLATFORM_HEADLESS)
     switch (level) {
     case RVK_INFO:
         fprintf(stderr, "[RVK][INFO] ");
@@ -693,6 +1432,26 @@ defer:
     return result;
 }
 
+bool rvk_write_entire_file(const char *path, const void *data, size_t size)
+{
+    bool result = true;
+    FILE *f = fopen(path, "wb");
+    if (f == NULL) {
+        rvk_log(RVK_ERROR, "Could not open %s for writing: %s", path, strerror(errno));
+        rvk_return_defer(false);
+    }
+
+    fwrite(data, 1, size, f);
+    if (ferror(f)) {
+        rvk_log(RVK_ERROR, "Could not write %s: %s", path, strerror(errno));
+        rvk_return_defer(false);
+    }
+
+defer:
+    if (f) fclose(f);
+    return result;
+}
+
 /***********************************************************************************
 *
 *   If using GLFW on desktop: #define PLATFORM_DESKTOP_GLFW
@@ -759,6 +1518,107 @@ double rvk_get_glfw_time()
 
 #endif // PLATFORM_DESKTOP_GLFW
 
+/***********************************************************************************
+*
+*   If running without a display (CI, render farms, lavapipe): #define PLATFORM_HEADLESS
+*
+************************************************************************************/
+
+#ifdef PLATFORM_HEADLESS
+
+#include <time.h>
+
+#define RVK_HEADLESS_FMT VK_FORMAT_R8G8B8A8_UNORM
+
+static Rvk_Image rvk_headless_imgs[RVK_MAX_FRAMES_IN_FLIGHT];
+static uint32_t rvk_headless_last_img = UINT32_MAX; // image of the last submitted frame
+static struct timespec rvk_headless_start_time;
+
+void rvk_headless_imgs_init()
+{
+    rvk_ctx.surface_fmt = (VkSurfaceFormatKHR) {
+        .format = RVK_HEADLESS_FMT,
+        .colorSpace = VK_COLOR_SPACE_SRGB_NONLINEAR_KHR,
+    };
+
+    /* one render target per frame in flight, so frame N+1 never draws over frame N */
+    rvk_ctx.swapchain.img_count = rvk_get_frames_in_flight();
+    VkExtent3D extent = {rvk_ctx.extent.width, rvk_ctx.extent.height, 1};
+    for (uint32_t i = 0; i < rvk_ctx.swapchain.img_count; i++) {
+        rvk_headless_imgs[i] = rvk_create_image(
+            extent,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            .format = RVK_HEADLESS_FMT,
+            .usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_SAMPLED_BIT);
+        rvk_ctx.swapchain.imgs[i] = rvk_headless_imgs[i].handle;
+    }
+}
+
+void rvk_headless_imgs_destroy()
+{
+    for (uint32_t i = 0; i < rvk_ctx.swapchain.img_count; i++) {
+        rvk_img_destroy(rvk_headless_imgs[i]);
+        rvk_ctx.swapchain.imgs[i] = VK_NULL_HANDLE;
+    }
+    rvk_headless_last_img = UINT32_MAX;
+}
+
+double rvk_get_headless_time()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    if (!rvk_headless_start_time.tv_sec && !rvk_headless_start_time.tv_nsec)
+        rvk_headless_start_time = now;
+    return (double)(now.tv_sec - rvk_headless_start_time.tv_sec) +
+           (double)(now.tv_nsec - rvk_headless_start_time.tv_nsec) * 1e-9;
+}
+
+void rvk_headless_read_frame(void *dst)
+{
+    /* before the first submit the images are still undefined, there is nothing to copy */
+    if (rvk_headless_last_img == UINT32_MAX) {
+        rvk_log(RVK_ERROR, "Could not read headless frame: no frame has been rendered yet");
+        return;
+    }
+
+    VkDeviceSize size = (VkDeviceSize)rvk_ctx.extent.width * rvk_ctx.extent.height * 4;
+    Rvk_Buffer stg_buff = {0};
+    rvk_buff_init(
+        size, 1,
+        VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+        RVK_BUFFER_TYPE_STAGING,
+        NULL,
+        &stg_buff
+    );
+
+    /* the default render pass leaves the frame in transfer src layout */
+    vkDeviceWaitIdle(rvk_ctx.device);
+    VkCommandBuffer cmd_buff = rvk_cmd_quick_begin();
+    VkBufferImageCopy region = {
+        .imageSubresource = {
+            .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+            .layerCount = 1,
+        },
+        .imageExtent = {rvk_ctx.extent.width, rvk_ctx.extent.height, 1},
+    };
+    vkCmdCopyImageToBuffer(
+        cmd_buff,
+        rvk_ctx.swapchain.imgs[rvk_headless_last_img],
+        VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+        stg_buff.handle,
+        1, &region
+    );
+    rvk_cmd_quick_end(&cmd_buff);
+
+    rvk_buff_map(&stg_buff);
+    memcpy(dst, stg_buff.mapped, size);
+    rvk_buff_unmap(stg_buff);
+    rvk_buff_destroy(stg_buff);
+}
+
+#endif // PLATFORM_HEADLESS
+
 /***********************************************************************************
 *
 *   If using GLFW on desktop: #define PLATFORM_ANDROID_QUEST
@@ -784,17 +1644,28 @@ void rvk_init_(Rvk_Config cfg)
         const char *name = (cfg.title) ? cfg.title: "default title";
         rvk_glfw_init(width, height, name);
     }
+#elif defined(PLATFORM_HEADLESS)
+    rvk_ctx.extent.width  = (cfg.width)  ? cfg.width  : RVK_DEFAULT_WINDOW_DIM;
+    rvk_ctx.extent.height = (cfg.height) ? cfg.height : RVK_DEFAULT_WINDOW_DIM;
+    rvk_get_headless_time();
 #else
     rvk_log(RVK_ERROR, "currently rvk_init only supports PLATFORM_DESKTOP_GLFW");
     RVK_EXIT_APP;
 #endif
 
+    if (cfg.frames_in_flight) rvk_set_frames_in_flight(cfg.frames_in_flight);
+    if (!rvk_ctx.frames_in_flight) rvk_ctx.frames_in_flight = RVK_DEFAULT_FRAMES_IN_FLIGHT;
+    rvk_ctx.transfer.disabled = cfg.no_transfer_queue;
+    rvk_ctx.compute.disabled = cfg.no_async_compute;
+
     rvk_instance_init();
 #ifdef VK_VALIDATION
     rvk_setup_debug_msgr();
 #endif
-#ifdef PLATFORM_DESKTOP_GLFW
+#if defined(PLATFORM_DESKTOP_GLFW)
     rvk_glfw_surface_init();
+#elif defined(PLATFORM_HEADLESS)
+    /* no surface, rvk_swapchain_init creates offscreen images instead */
 #else
     rvk_log(RVK_ERROR, "currently rvk_init only supports PLATFORM_DESKTOP_GLFW");
     RVK_EXIT_APP;
@@ -804,35 +1675,59 @@ void rvk_init_(Rvk_Config cfg)
     rvk_pick_phys_device();
 
     rvk_device_init();
+    rvk_pl_cache_init((cfg.pipeline_cache_path) ? cfg.pipeline_cache_path : RVK_DEFAULT_PIPELINE_CACHE_PATH);
     rvk_swapchain_init();
     rvk_img_views_init();
-    rvk_render_pass_init();
+    if (!rvk_ctx.features.dynamic_rendering) rvk_render_pass_init();
     rvk_depth_init();
-    rvk_frame_buffs_init();
+    if (!rvk_ctx.features.dynamic_rendering) rvk_frame_buffs_init();
     rvk_cmd_pool_init();
-    rvk_allocate_command_buffer(&rvk_ctx.cmd_buff);
+    for (uint32_t i = 0; i < rvk_ctx.frames_in_flight; i++) {
+        rvk_allocate_command_buffer(&rvk_ctx.frames[i].cmd_buff);
+        rvk_allocate_command_buffer(&rvk_ctx.frames[i].compute_cmd_buff);
+    }
     rvk_cmd_syncs_init();
+    rvk_ctx.frame_idx = 0;
+    rvk_use_frame(rvk_ctx.frame_idx);
+    rvk_stg_ring_init((cfg.staging_ring_size) ? cfg.staging_ring_size : RVK_DEFAULT_STAGING_RING_SIZE);
+    if (rvk_ctx.features.descriptor_indexing) rvk_bindless_init();
 }
 
 void rvk_destroy()
 {
     vkDeviceWaitIdle(rvk_ctx.device);
 
-    vkDestroySemaphore(rvk_ctx.device, rvk_ctx.img_avail_sem, NULL);
-    vkDestroySemaphore(rvk_ctx.device, rvk_ctx.render_fin_sem, NULL);
-    vkDestroyFence(rvk_ctx.device, rvk_ctx.fence, NULL);
+    rvk_timeline_destroy();
+    rvk_transfer_queue_destroy();
+    rvk_record_slots_destroy();
+    vkDestroySemaphore(rvk_ctx.device, rvk_ctx.compute.timeline.sem, NULL);
+    rvk_ctx.compute.timeline = (Rvk_Timeline){0};
+    rvk_stg_ring_destroy();
+    rvk_bindless_destroy();
+    for (uint32_t i = 0; i < rvk_ctx.frames_in_flight; i++) {
+        vkDestroySemaphore(rvk_ctx.device, rvk_ctx.frames[i].img_avail_sem, NULL);
+        vkDestroyFence(rvk_ctx.device, rvk_ctx.frames[i].fence, NULL);
+        rvk_descriptor_pool_arena_destroy(rvk_ctx.frames[i].ds_arena);
+    }
+    for (uint32_t i = 0; i < RVK_MAX_SWAPCHAIN_IMAGES; i++)
+        vkDestroySemaphore(rvk_ctx.device, rvk_ctx.render_fin_sems[i], NULL);
     vkDestroyCommandPool(rvk_ctx.device, rvk_ctx.pool, NULL);
 
     rvk_destroy_swapchain();
     vkDeviceWaitIdle(rvk_ctx.device);
     vkDestroyRenderPass(rvk_ctx.device, rvk_ctx.render_pass, NULL);
+    rvk_mem_destroy();
+    rvk_shader_registry_destroy();
+    rvk_pl_cache_destroy();
     vkDestroyDevice(rvk_ctx.device, NULL);
 #ifdef VK_VALIDATION
     RVK_LOAD_PFN(vkDestroyDebugUtilsMessengerEXT);
     if (vkDestroyDebugUtilsMessengerEXT)
         vkDestroyDebugUtilsMessengerEXT(rvk_ctx.instance, rvk_ctx.debug_msgr, NULL);
 #endif
+#ifndef PLATFORM_HEADLESS
     vkDestroySurfaceKHR(rvk_ctx.instance, rvk_ctx.surface, NULL);
+#endif
     vkDestroyInstance(rvk_ctx.instance, NULL);
 #ifdef PLATFORM_DESKTOP_GLFW
     rvk_glfw_destroy();
@@ -864,10 +1759,18 @@ void rvk_instance_init()
 
     uint32_t platform_ext_count = 0;
 
+#ifdef PLATFORM_ANDROID_QUEST
+    /* vulkan 1.0 has no vkGetPhysicalDeviceFeatures2, feature negotiation needs the KHR version */
+    rvk_da_append(&rvk_inst_exts, VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+#endif
+
 #ifdef PLATFORM_DESKTOP_GLFW
     const char **platform_exts = glfwGetRequiredInstanceExtensions(&platform_ext_count);
     for (size_t i = 0; i < platform_ext_count; i++)
         rvk_da_append(&rvk_inst_exts, platform_exts[i]);
+#elif defined(PLATFORM_HEADLESS)
+    /* nothing to present to, so no surface extensions */
+    (void)platform_ext_count;
 #else
     rvk_log(RVK_ERROR, "rvk_instance_init() currently requires PLATFORM_DESKTOP_GLFW");
     RVK_EXIT_APP;
@@ -892,77 +1795,215 @@ void rvk_instance_init()
     RAG_VK(vkCreateInstance(&instance_ci, NULL, &rvk_ctx.instance));
 }
 
-void rvk_device_init()
-{
-    float queuePriority = 1.0f;
-    VkDeviceQueueCreateInfo queue_ci = {
-        .sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
-        .queueFamilyIndex = rvk_ctx.queue_idx,
-        .queueCount = 1,
-        .pQueuePriorities = &queuePriority,
-    };
-    VkPhysicalDeviceFeatures features = {
-        .samplerAnisotropy = VK_TRUE,
-        .fillModeNonSolid = VK_TRUE,
-    };
-
-    if (rvk_ctx.enable_atomic_features) {
-        features.shaderInt64 = VK_TRUE;
-    }
+/* the feature structs rag_vk knows about, chained behind VkPhysicalDeviceFeatures2. the chain
+ * points into itself, so it is initialized in place and never copied */
+typedef struct {
+    VkPhysicalDeviceFeatures2 core;
+#ifdef PLATFORM_ANDROID_QUEST
+    VkPhysicalDeviceMultiviewFeaturesKHR multiview;
+    VkPhysicalDeviceTimelineSemaphoreFeaturesKHR timeline;
+#else
+    VkPhysicalDeviceVulkan11Features v11;
+    VkPhysicalDeviceVulkan12Features v12;
+    VkPhysicalDeviceVulkan13Features v13;
+#endif
+} Rvk_Feature_Chain;
 
-    // extended_features
-    VkPhysicalDeviceVulkan13Features atomic_sync_feature = {
-        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES,
-        .synchronization2 = VK_TRUE,
-    };
-    VkPhysicalDeviceVulkan12Features shader_buff_int_64_feature = {
-        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES,
-        .pNext = &atomic_sync_feature,
-        .shaderBufferInt64Atomics = VK_TRUE,
+static void rvk_feature_chain_init(Rvk_Feature_Chain *chain)
+{
+    *chain = (Rvk_Feature_Chain){0};
+#ifdef PLATFORM_ANDROID_QUEST
+    chain->timeline = (VkPhysicalDeviceTimelineSemaphoreFeaturesKHR){
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR,
     };
-    VkPhysicalDeviceMultiviewFeaturesKHR multiview_feature = {
+    chain->multiview = (VkPhysicalDeviceMultiviewFeaturesKHR){
         .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MULTIVIEW_FEATURES_KHR,
-        .multiview = VK_TRUE,
-    };
-    VkPhysicalDeviceFeatures2 extended_features = {
-        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
-        .features = features,
+        .pNext = &chain->timeline,
     };
+    chain->core = (VkPhysicalDeviceFeatures2){.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2, .pNext = &chain->multiview};
+#else
+    chain->v13 = (VkPhysicalDeviceVulkan13Features){.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES};
+    chain->v12 = (VkPhysicalDeviceVulkan12Features){.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES, .pNext = &chain->v13};
+    chain->v11 = (VkPhysicalDeviceVulkan11Features){.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_FEATURES, .pNext = &chain->v12};
+    chain->core = (VkPhysicalDeviceFeatures2){.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2, .pNext = &chain->v11};
+#endif
+}
 
-    VkDeviceCreateInfo device_ci = {
-        .sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
-        .pEnabledFeatures = &features,
-        .pQueueCreateInfos = &queue_ci,
-        .queueCreateInfoCount = 1,
-        .enabledExtensionCount = RVK_ARRAY_LEN(rvk_device_exts),
-        .ppEnabledExtensionNames = rvk_device_exts,
-    };
+static bool rvk_feature_negotiated(bool requested, bool supported, const char *name)
+{
+    if (requested && !supported) rvk_log(RVK_WARNING, "%s was requested, but the device does not support it", name);
+    return requested && supported;
+}
 
-    if (rvk_ctx.enable_atomic_features) {
-        extended_features.pNext = &shader_buff_int_64_feature,
-        device_ci.pNext = &extended_features;
-        device_ci.pEnabledFeatures = NULL;
+/* queries what the device supports, fills rvk_ctx.supported and rvk_ctx.features, and
+ * sets up enabled with everything that was requested and is supported */
+static void rvk_negotiate_features(Rvk_Feature_Chain *enabled)
+{
+    Rvk_Feature_Chain supported;
+    rvk_feature_chain_init(&supported);
+#ifdef PLATFORM_ANDROID_QUEST
+    RVK_LOAD_PFN(vkGetPhysicalDeviceFeatures2KHR);
+    if (!vkGetPhysicalDeviceFeatures2KHR) {
+        rvk_log(RVK_ERROR, "failed to load function pointer for vkGetPhysicalDeviceFeatures2KHR");
+        RVK_EXIT_APP;
     }
+    vkGetPhysicalDeviceFeatures2KHR(rvk_ctx.phys_device, &supported.core);
+#else
+    vkGetPhysicalDeviceFeatures2(rvk_ctx.phys_device, &supported.core);
+#endif
+    VkPhysicalDeviceFeatures core = supported.core.features;
+
+    Rvk_Device_Features *s = &rvk_ctx.supported;
+    *s = (Rvk_Device_Features){0};
+    s->multi_draw_indirect = core.multiDrawIndirect && core.drawIndirectFirstInstance;
+#ifdef PLATFORM_ANDROID_QUEST
+    s->timeline_semaphore = supported.timeline.timelineSemaphore;
+    s->multiview = supported.multiview.multiview;
+#else
+    VkPhysicalDeviceVulkan12Features v12 = supported.v12;
+    s->timeline_semaphore = v12.timelineSemaphore;
+    s->synchronization2 = supported.v13.synchronization2;
+    s->int64_atomics = core.shaderInt64 && v12.shaderBufferInt64Atomics;
+    s->multiview = supported.v11.multiview;
+    s->dynamic_rendering = supported.v13.dynamicRendering;
+    s->descriptor_indexing = v12.runtimeDescriptorArray &&
+                             v12.descriptorBindingPartiallyBound &&
+                             v12.descriptorBindingUpdateUnusedWhilePending &&
+                             v12.descriptorBindingSampledImageUpdateAfterBind &&
+                             v12.descriptorBindingStorageBufferUpdateAfterBind &&
+                             v12.descriptorBindingStorageImageUpdateAfterBind &&
+                             v12.shaderSampledImageArrayNonUniformIndexing;
+    s->buffer_device_address = v12.bufferDeviceAddress;
+    s->draw_indirect_count = v12.drawIndirectCount;
+#endif
 
-    if (rvk_ctx.enable_multiview_feature) {
-        extended_features.pNext = &multiview_feature,
-        device_ci.pNext = &extended_features;
-        device_ci.pEnabledFeatures = NULL;
+    if (!s->timeline_semaphore) {
+        rvk_log(RVK_ERROR, "the device does not support timeline semaphores");
+        RVK_EXIT_APP;
     }
 
-#ifdef VK_VALIDATION
-    if (rvk_ctx.using_validation) {
-        device_ci.enabledLayerCount = RVK_ARRAY_LEN(rvk_validation_layers);
-        device_ci.ppEnabledLayerNames = rvk_validation_layers;
+    Rvk_Device_Features *f = &rvk_ctx.features;
+    f->timeline_semaphore    = true;
+    f->synchronization2      = s->synchronization2;
+    f->int64_atomics         = rvk_feature_negotiated(rvk_ctx.enable_atomic_features, s->int64_atomics, "int64 atomics");
+    f->multiview             = rvk_feature_negotiated(rvk_ctx.enable_multiview_feature, s->multiview, "multiview");
+    f->dynamic_rendering     = rvk_feature_negotiated(rvk_ctx.enable_dynamic_rendering, s->dynamic_rendering, "dynamic rendering");
+    f->descriptor_indexing   = rvk_feature_negotiated(rvk_ctx.enable_bindless, s->descriptor_indexing, "descriptor indexing");
+    f->buffer_device_address = rvk_feature_negotiated(rvk_ctx.enable_buffer_device_address, s->buffer_device_address, "buffer device address");
+    f->multi_draw_indirect   = rvk_feature_negotiated(rvk_ctx.enable_draw_indirect, s->multi_draw_indirect, "multi draw indirect");
+    f->draw_indirect_count   = rvk_ctx.enable_draw_indirect && s->draw_indirect_count;
+    if (rvk_ctx.enable_draw_indirect && !f->draw_indirect_count)
+        rvk_log(RVK_WARNING, "drawIndirectCount not supported, indirect draws always draw their max count");
+
+    rvk_feature_chain_init(enabled);
+    VkPhysicalDeviceFeatures *e = &enabled->core.features;
+    e->samplerAnisotropy = VK_TRUE;
+    e->fillModeNonSolid = VK_TRUE;
+    e->shaderInt64 = f->int64_atomics;
+    e->multiDrawIndirect = f->multi_draw_indirect;
+    e->drawIndirectFirstInstance = f->multi_draw_indirect;
+#ifdef PLATFORM_ANDROID_QUEST
+    enabled->timeline.timelineSemaphore = VK_TRUE;
+    enabled->multiview.multiview = f->multiview;
+#else
+    enabled->v11.multiview = f->multiview;
+    VkPhysicalDeviceVulkan12Features *e12 = &enabled->v12;
+    e12->timelineSemaphore = VK_TRUE;
+    e12->shaderBufferInt64Atomics = f->int64_atomics;
+    e12->bufferDeviceAddress = f->buffer_device_address;
+    e12->drawIndirectCount = f->draw_indirect_count;
+    if (f->descriptor_indexing) {
+        e12->runtimeDescriptorArray = VK_TRUE;
+        e12->descriptorBindingPartiallyBound = VK_TRUE;
+        e12->descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+        e12->descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+        e12->descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+        e12->descriptorBindingStorageImageUpdateAfterBind = VK_TRUE;
+        e12->shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+        e12->shaderStorageBufferArrayNonUniformIndexing = v12.shaderStorageBufferArrayNonUniformIndexing;
+        e12->shaderStorageImageArrayNonUniformIndexing = v12.shaderStorageImageArrayNonUniformIndexing;
+    }
+    enabled->v13.synchronization2 = f->synchronization2;
+    enabled->v13.dynamicRendering = f->dynamic_rendering;
+#endif
+}
+
+void rvk_device_init()
+{
+    float queuePriority = 1.0f;
+    float unified_priorities[] = {1.0f, 1.0f}; // graphics, then async compute
+    VkDeviceQueueCreateInfo queue_ci = {
+        .sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
+        .queueFamilyIndex = rvk_ctx.queue_idx,
+        .queueCount = (rvk_ctx.compute.async) ? 2 : 1,
+        .pQueuePriorities = unified_priorities,
+    };
+    VkDeviceQueueCreateInfo queue_cis[] = {
+        queue_ci,
+        {
+            .sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
+            .queueFamilyIndex = rvk_ctx.transfer.queue_idx,
+            .queueCount = 1,
+            .pQueuePriorities = &queuePriority,
+        },
+    };
+    Rvk_Feature_Chain enabled = {0};
+    rvk_negotiate_features(&enabled);
+
+    VkDeviceCreateInfo device_ci = {
+        .sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
+        .pNext = &enabled.core,
+        .pQueueCreateInfos = queue_cis,
+        .queueCreateInfoCount = (rvk_ctx.transfer.dedicated) ? 2 : 1,
+#ifndef PLATFORM_HEADLESS
+        .enabledExtensionCount = RVK_ARRAY_LEN(rvk_device_exts),
+        .ppEnabledExtensionNames = rvk_device_exts,
+#endif
+    };
+
+#ifdef VK_VALIDATION
+    if (rvk_ctx.using_validation) {
+        device_ci.enabledLayerCount = RVK_ARRAY_LEN(rvk_validation_layers);
+        device_ci.ppEnabledLayerNames = rvk_validation_layers;
     }
 #endif
 
     RAG_VK(vkCreateDevice(rvk_ctx.phys_device, &device_ci, NULL, &rvk_ctx.device));
     vkGetDeviceQueue(rvk_ctx.device, rvk_ctx.queue_idx, 0, &rvk_ctx.unified_queue);
+    if (rvk_ctx.transfer.dedicated) vkGetDeviceQueue(rvk_ctx.device, rvk_ctx.transfer.queue_idx, 0, &rvk_ctx.transfer.queue);
+    else rvk_ctx.transfer.queue = rvk_ctx.unified_queue;
+    if (rvk_ctx.compute.async) vkGetDeviceQueue(rvk_ctx.device, rvk_ctx.queue_idx, 1, &rvk_ctx.compute.queue);
+    else rvk_ctx.compute.queue = rvk_ctx.unified_queue;
+
+#ifdef PLATFORM_ANDROID_QUEST
+    rvk_wait_semaphores_pfn = (PFN_vkWaitSemaphores)vkGetDeviceProcAddr(rvk_ctx.device, "vkWaitSemaphoresKHR");
+    rvk_get_semaphore_counter_value_pfn = (PFN_vkGetSemaphoreCounterValue)vkGetDeviceProcAddr(rvk_ctx.device, "vkGetSemaphoreCounterValueKHR");
+#else
+    rvk_wait_semaphores_pfn = (PFN_vkWaitSemaphores)vkGetDeviceProcAddr(rvk_ctx.device, "vkWaitSemaphores");
+    rvk_get_semaphore_counter_value_pfn = (PFN_vkGetSemaphoreCounterValue)vkGetDeviceProcAddr(rvk_ctx.device, "vkGetSemaphoreCounterValue");
+#endif
+    if (!rvk_wait_semaphores_pfn || !rvk_get_semaphore_counter_value_pfn) {
+        rvk_log(RVK_ERROR, "could not load the timeline semaphore functions");
+        RVK_EXIT_APP;
+    }
+
+    if (rvk_ctx.features.dynamic_rendering) {
+        rvk_cmd_begin_rendering_pfn = (PFN_vkCmdBeginRendering)vkGetDeviceProcAddr(rvk_ctx.device, "vkCmdBeginRendering");
+        rvk_cmd_end_rendering_pfn   = (PFN_vkCmdEndRendering)vkGetDeviceProcAddr(rvk_ctx.device, "vkCmdEndRendering");
+        if (!rvk_cmd_begin_rendering_pfn || !rvk_cmd_end_rendering_pfn) {
+            rvk_log(RVK_ERROR, "could not load vkCmdBeginRendering/vkCmdEndRendering");
+            RVK_EXIT_APP;
+        }
+    }
 }
 
 void rvk_swapchain_init()
 {
+#ifdef PLATFORM_HEADLESS
+    rvk_headless_imgs_init();
+    return;
+#endif
+
     VkSurfaceCapabilitiesKHR capabilities = {0};
     vkGetPhysicalDeviceSurfaceCapabilitiesKHR(rvk_ctx.phys_device, rvk_ctx.surface, &capabilities);
     rvk_choose_swapchain_fmt();
@@ -1073,6 +2114,245 @@ void rvk_img_views_init()
     }
 }
 
+/* pipeline batch that the pipeline creation functions currently record into (NULL if none) */
+static Rvk_Pipeline_Batch *rvk_active_pipeline_batch = NULL;
+
+static void *rvk_pl_copy_array(const void *src, size_t size, void **owner)
+{
+    if (!src || !size) return NULL;
+    void *dst = RVK_REALLOC(NULL, size);
+    RVK_ASSERT(dst != NULL && "\"Buy more RAM lol\"\n\t\t-Tsoding");
+    memcpy(dst, src, size);
+    *owner = dst;
+    return dst;
+}
+
+/* points the pipeline at a render pass, or with dynamic rendering chains the attachment formats
+ * of rt (the swapchain when NULL) in front of ci->pNext, rendering and color_fmt must outlive ci */
+static void rvk_pl_render_target(VkGraphicsPipelineCreateInfo *ci, VkRenderPass rp, const Rvk_Render_Texture *rt,
+                                 VkPipelineRenderingCreateInfo *rendering, VkFormat *color_fmt)
+{
+    if (!rp && rt) rp = rt->rp;
+    if (rp || !rvk_ctx.features.dynamic_rendering) {
+        ci->renderPass = (rp) ? rp : rvk_ctx.render_pass;
+        return;
+    }
+
+    uint32_t view_count = (rt && rt->view_count) ? rt->view_count : 1;
+    *color_fmt = (rt) ? rt->color.img.format : rvk_ctx.surface_fmt.format;
+    *rendering = (VkPipelineRenderingCreateInfo) {
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO,
+        .pNext = ci->pNext,
+        .viewMask = (view_count > 1) ? (1u << view_count) - 1 : 0,
+        .colorAttachmentCount = 1,
+        .pColorAttachmentFormats = color_fmt,
+        .depthAttachmentFormat = (rt) ? rt->depth.img.format : rvk_ctx.depth_img.format,
+    };
+    ci->renderPass = VK_NULL_HANDLE;
+    ci->pNext = rendering;
+}
+
+/* creates the pipeline now, or copies its create info into the active batch */
+static void rvk_gfx_pl_create(const VkGraphicsPipelineCreateInfo *ci, VkPipeline *pl, VkShaderModule vert, VkShaderModule frag)
+{
+    if (!rvk_active_pipeline_batch) {
+        RAG_VK(vkCreateGraphicsPipelines(rvk_ctx.device, rvk_ctx.pl_cache, 1, ci, NULL, pl));
+        if (vert) rvk_shader_release(vert);
+        if (frag) rvk_shader_release(frag);
+        return;
+    }
+
+    if (ci->stageCount > RVK_MAX_PIPELINE_STAGES) {
+        rvk_log(RVK_ERROR, "pipeline batch supports at most %d shader stages per pipeline", RVK_MAX_PIPELINE_STAGES);
+        RVK_EXIT_APP;
+    }
+
+    /* the states are copied by value, the pointers into the entry are patched when the batch ends */
+    Rvk_Pending_Gfx_Pipeline p = {.pl = pl, .ci = *ci, .release = {vert, frag}};
+    memcpy(p.stages, ci->pStages, ci->stageCount*sizeof(*ci->pStages));
+    if (ci->pVertexInputState) {
+        p.vertex_input = *ci->pVertexInputState;
+        p.vertex_input.pVertexBindingDescriptions = rvk_pl_copy_array(
+            p.vertex_input.pVertexBindingDescriptions,
+            p.vertex_input.vertexBindingDescriptionCount*sizeof(VkVertexInputBindingDescription),
+            &p.arrays[0]
+        );
+        p.vertex_input.pVertexAttributeDescriptions = rvk_pl_copy_array(
+            p.vertex_input.pVertexAttributeDescriptions,
+            p.vertex_input.vertexAttributeDescriptionCount*sizeof(VkVertexInputAttributeDescription),
+            &p.arrays[1]
+        );
+    }
+    if (ci->pInputAssemblyState) p.input_assembly = *ci->pInputAssemblyState;
+    if (ci->pTessellationState)  p.tessellation   = *ci->pTessellationState;
+    if (ci->pViewportState) {
+        p.viewport = *ci->pViewportState;
+        p.viewport.pViewports = rvk_pl_copy_array(p.viewport.pViewports, p.viewport.viewportCount*sizeof(VkViewport), &p.arrays[2]);
+        p.viewport.pScissors  = rvk_pl_copy_array(p.viewport.pScissors,  p.viewport.scissorCount*sizeof(VkRect2D),    &p.arrays[3]);
+    }
+    if (ci->pRasterizationState) p.rasterization = *ci->pRasterizationState;
+    if (ci->pMultisampleState)   p.multisample   = *ci->pMultisampleState;
+    if (ci->pDepthStencilState)  p.depth_stencil = *ci->pDepthStencilState;
+    if (ci->pColorBlendState) {
+        p.color_blend = *ci->pColorBlendState;
+        p.color_blend.pAttachments = rvk_pl_copy_array(
+            p.color_blend.pAttachments,
+            p.color_blend.attachmentCount*sizeof(VkPipelineColorBlendAttachmentState),
+            &p.arrays[4]
+        );
+    }
+    if (ci->pDynamicState) {
+        p.dynamic = *ci->pDynamicState;
+        p.dynamic.pDynamicStates = rvk_pl_copy_array(p.dynamic.pDynamicStates, p.dynamic.dynamicStateCount*sizeof(VkDynamicState), &p.arrays[5]);
+    }
+    const VkPipelineRenderingCreateInfo *rendering = ci->pNext;
+    if (rendering && rendering->sType == VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO) {
+        /* usually chained by rvk_pl_render_target from a stack local, so its single color format is copied too */
+        p.rendering = *rendering;
+        if (rendering->colorAttachmentCount == 1) p.color_fmt = rendering->pColorAttachmentFormats[0];
+    }
+    rvk_da_append(&rvk_active_pipeline_batch->gfx, p);
+}
+
+static void rvk_compute_pl_create(const VkComputePipelineCreateInfo *ci, VkPipeline *pl, VkShaderModule module)
+{
+    if (!rvk_active_pipeline_batch) {
+        RAG_VK(vkCreateComputePipelines(rvk_ctx.device, rvk_ctx.pl_cache, 1, ci, NULL, pl));
+        if (module) rvk_shader_release(module);
+        return;
+    }
+
+    Rvk_Pending_Compute_Pipeline p = {.pl = pl, .ci = *ci, .release = module};
+    rvk_da_append(&rvk_active_pipeline_batch->compute, p);
+}
+
+static void rvk_pending_gfx_patch(Rvk_Pending_Gfx_Pipeline *p)
+{
+    p->ci.pStages = p->stages;
+    if (p->ci.pVertexInputState)   p->ci.pVertexInputState   = &p->vertex_input;
+    if (p->ci.pInputAssemblyState) p->ci.pInputAssemblyState = &p->input_assembly;
+    if (p->ci.pTessellationState)  p->ci.pTessellationState  = &p->tessellation;
+    if (p->ci.pViewportState)      p->ci.pViewportState      = &p->viewport;
+    if (p->ci.pRasterizationState) p->ci.pRasterizationState = &p->rasterization;
+    if (p->ci.pMultisampleState)   p->ci.pMultisampleState   = &p->multisample;
+    if (p->ci.pDepthStencilState)  p->ci.pDepthStencilState  = &p->depth_stencil;
+    if (p->ci.pColorBlendState)    p->ci.pColorBlendState    = &p->color_blend;
+    if (p->ci.pDynamicState)       p->ci.pDynamicState       = &p->dynamic;
+    if (p->rendering.sType) {
+        if (p->rendering.colorAttachmentCount == 1) p->rendering.pColorAttachmentFormats = &p->color_fmt;
+        p->ci.pNext = &p->rendering;
+    }
+}
+
+typedef struct {
+    VkGraphicsPipelineCreateInfo *gfx_cis;
+    VkPipeline *gfx_pls;
+    uint32_t gfx_count;
+    VkComputePipelineCreateInfo *compute_cis;
+    VkPipeline *compute_pls;
+    uint32_t compute_count;
+} Rvk_Pipeline_Work;
+
+static void *rvk_pipeline_worker(void *arg)
+{
+    /* pipeline caches are internally synchronized, so the workers can share rvk_ctx.pl_cache */
+    Rvk_Pipeline_Work *work = arg;
+    if (work->gfx_count)
+        RAG_VK(vkCreateGraphicsPipelines(rvk_ctx.device, rvk_ctx.pl_cache, work->gfx_count, work->gfx_cis, NULL, work->gfx_pls));
+    if (work->compute_count)
+        RAG_VK(vkCreateComputePipelines(rvk_ctx.device, rvk_ctx.pl_cache, work->compute_count, work->compute_cis, NULL, work->compute_pls));
+    return NULL;
+}
+
+void rvk_begin_pipeline_batch(Rvk_Pipeline_Batch *batch)
+{
+    if (rvk_active_pipeline_batch) {
+        rvk_log(RVK_ERROR, "a pipeline batch is already recording, end it before beginning another");
+        RVK_EXIT_APP;
+    }
+    *batch = (Rvk_Pipeline_Batch){0};
+    rvk_active_pipeline_batch = batch;
+}
+
+void rvk_end_pipeline_batch(Rvk_Pipeline_Batch *batch, uint32_t thread_count)
+{
+    if (rvk_active_pipeline_batch != batch) {
+        rvk_log(RVK_ERROR, "pipeline batch ended, but it was not the one recording");
+        RVK_EXIT_APP;
+    }
+    rvk_active_pipeline_batch = NULL;
+
+    /* contiguous create infos and outputs so they can be handed to vkCreate*Pipelines in slices */
+    uint32_t gfx_count = batch->gfx.count;
+    uint32_t compute_count = batch->compute.count;
+    size_t total = gfx_count + compute_count;
+    VkGraphicsPipelineCreateInfo *gfx_cis = RVK_REALLOC(NULL, (gfx_count + 1)*sizeof(*gfx_cis));
+    VkComputePipelineCreateInfo *compute_cis = RVK_REALLOC(NULL, (compute_count + 1)*sizeof(*compute_cis));
+    VkPipeline *pls = RVK_REALLOC(NULL, (total + 1)*sizeof(*pls));
+    RVK_ASSERT(gfx_cis && compute_cis && pls && "\"Buy more RAM lol\"\n\t\t-Tsoding");
+    for (uint32_t i = 0; i < gfx_count; i++) {
+        rvk_pending_gfx_patch(&batch->gfx.items[i]);
+        gfx_cis[i] = batch->gfx.items[i].ci;
+    }
+    for (uint32_t i = 0; i < compute_count; i++)
+        compute_cis[i] = batch->compute.items[i].ci;
+
+    if (thread_count > total) thread_count = total;
+    if (thread_count <= 1) {
+        Rvk_Pipeline_Work work = {gfx_cis, pls, gfx_count, compute_cis, pls + gfx_count, compute_count};
+        rvk_pipeline_worker(&work);
+    } else {
+        /* split both lists evenly, worker i gets the i-th slice of each */
+        pthread_t *threads = RVK_REALLOC(NULL, thread_count*sizeof(*threads));
+        Rvk_Pipeline_Work *work = RVK_REALLOC(NULL, thread_count*sizeof(*work));
+        RVK_ASSERT(threads && work && "\"Buy more RAM lol\"\n\t\t-Tsoding");
+        for (uint32_t t = 0; t < thread_count; t++) {
+            uint32_t gfx_start = gfx_count*t/thread_count, gfx_end = gfx_count*(t + 1)/thread_count;
+            uint32_t comp_start = compute_count*t/thread_count, comp_end = compute_count*(t + 1)/thread_count;
+            work[t] = (Rvk_Pipeline_Work) {
+                .gfx_cis = gfx_cis + gfx_start,
+                .gfx_pls = pls + gfx_start,
+                .gfx_count = gfx_end - gfx_start,
+                .compute_cis = compute_cis + comp_start,
+                .compute_pls = pls + gfx_count + comp_start,
+                .compute_count = comp_end - comp_start,
+            };
+            if (pthread_create(&threads[t], NULL, rvk_pipeline_worker, &work[t]) != 0) {
+                rvk_log(RVK_WARNING, "could not start pipeline worker thread, creating its pipelines here");
+                rvk_pipeline_worker(&work[t]);
+                threads[t] = pthread_self();
+            }
+        }
+        for (uint32_t t = 0; t < thread_count; t++)
+            if (!pthread_equal(threads[t], pthread_self())) pthread_join(threads[t], NULL);
+        RVK_FREE(threads);
+        RVK_FREE(work);
+    }
+
+    /* hand out the pipelines and drop everything the batch copied */
+    for (uint32_t i = 0; i < gfx_count; i++) {
+        Rvk_Pending_Gfx_Pipeline *p = &batch->gfx.items[i];
+        *p->pl = pls[i];
+        for (size_t j = 0; j < RVK_ARRAY_LEN(p->release); j++)
+            if (p->release[j]) rvk_shader_release(p->release[j]);
+        for (size_t j = 0; j < RVK_ARRAY_LEN(p->arrays); j++)
+            RVK_FREE(p->arrays[j]);
+    }
+    for (uint32_t i = 0; i < compute_count; i++) {
+        Rvk_Pending_Compute_Pipeline *p = &batch->compute.items[i];
+        *p->pl = pls[gfx_count + i];
+        if (p->release) rvk_shader_release(p->release);
+    }
+    rvk_log(RVK_INFO, "pipeline batch created %u graphics and %u compute pipelines", gfx_count, compute_count);
+
+    RVK_FREE(gfx_cis);
+    RVK_FREE(compute_cis);
+    RVK_FREE(pls);
+    rvk_da_free(batch->gfx);
+    rvk_da_free(batch->compute);
+    *batch = (Rvk_Pipeline_Batch){0};
+}
+
 void rvk_basic_pl_init(Pipeline_Config config, VkPipeline *pl)
 {
     rvk_log(RVK_ERROR, "rvk_basic_pl_init is deprecated in favor of rvk_create_graphics_pipelines");
@@ -1088,8 +2368,8 @@ void rvk_basic_pl_init(Pipeline_Config config, VkPipeline *pl)
             .pName = "main",
         },
     };
-    rvk_shader_mod_init(config.vert, &stages[0].module);
-    rvk_shader_mod_init(config.frag, &stages[1].module);
+    stages[0].module = rvk_shader_acquire(config.vert);
+    stages[1].module = rvk_shader_acquire(config.frag);
 
     VkDynamicState dynamic_states[] = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
     VkPipelineDynamicStateCreateInfo dynamic_state_ci = {
@@ -1171,11 +2451,11 @@ void rvk_basic_pl_init(Pipeline_Config config, VkPipeline *pl)
         .pDynamicState = &dynamic_state_ci,
         .pDepthStencilState = &depth_ci,
         .layout = config.pl_layout,
-        .renderPass = (config.render_pass) ? config.render_pass : rvk_ctx.render_pass,
     };
-    RAG_VK(vkCreateGraphicsPipelines(rvk_ctx.device, VK_NULL_HANDLE, 1, &pipeline_ci, NULL, pl));
-    vkDestroyShaderModule(rvk_ctx.device, stages[0].module, NULL);
-    vkDestroyShaderModule(rvk_ctx.device, stages[1].module, NULL);
+    VkPipelineRenderingCreateInfo rendering_ci = {0};
+    VkFormat color_fmt = VK_FORMAT_UNDEFINED;
+    rvk_pl_render_target(&pipeline_ci, config.render_pass, config.render_texture, &rendering_ci, &color_fmt);
+    rvk_gfx_pl_create(&pipeline_ci, pl, stages[0].module, stages[1].module);
 }
 
 void rvk_create_graphics_pipelines_(VkPipeline *pl, Rvk_Graphics_Pipeline_Create_Info ci)
@@ -1201,8 +2481,10 @@ void rvk_create_graphics_pipelines_(VkPipeline *pl, Rvk_Graphics_Pipeline_Create
         actual_ci.stageCount= ci.stage_count;
     } else if (ci.vertex_shader_name && ci.fragment_shader_name) {
         using_shader_lazy_method = true;
-        rvk_shader_mod_init(ci.vertex_shader_name, &stages_lazy_method[0].module);
-        rvk_shader_mod_init(ci.fragment_shader_name, &stages_lazy_method[1].module);
+        stages_lazy_method[0].module = rvk_shader_acquire(ci.vertex_shader_name);
+        stages_lazy_method[1].module = rvk_shader_acquire(ci.fragment_shader_name);
+        stages_lazy_method[0].pSpecializationInfo = ci.p_vertex_specialization_info;
+        stages_lazy_method[1].pSpecializationInfo = ci.p_fragment_specialization_info;
         actual_ci.pStages = stages_lazy_method;
         actual_ci.stageCount= RVK_ARRAY_LEN(stages_lazy_method);
     } else {
@@ -1316,25 +2598,25 @@ void rvk_create_graphics_pipelines_(VkPipeline *pl, Rvk_Graphics_Pipeline_Create
     };
     actual_ci.pDepthStencilState = (ci.p_depth_stencil_state) ? ci.p_depth_stencil_state: &default_depth_ci;
 
-    // render pass
-    if (ci.render_pass) {
-        actual_ci.renderPass = ci.render_pass;
-    } else if (rvk_ctx.render_pass) {
-        actual_ci.renderPass = rvk_ctx.render_pass;
-    } else {
-        rvk_log(RVK_ERROR, "cannot create pipeline because render pass was missing, options 1 or 2");
+    // render pass, or the attachment formats with dynamic rendering
+    bool has_target = ci.render_pass || ci.render_texture || rvk_ctx.render_pass || rvk_ctx.features.dynamic_rendering;
+    if (!has_target) {
+        rvk_log(RVK_ERROR, "cannot create pipeline because render pass was missing, options 1, 2, or 3");
         rvk_log(RVK_ERROR, "    (1) call rvk_render_pass_init() to use the default");
         rvk_log(RVK_ERROR, "    (2) look at that function, create your own, and pass it in i.e. ");
         rvk_log(RVK_ERROR, "        rvk_create_graphics_pipelines(&your_pl, ..., .render_pass=your_render_pass)");
+        rvk_log(RVK_ERROR, "    (3) call rvk_enable_dynamic_rendering() before initializing");
         RVK_EXIT_APP;
     }
+    VkPipelineRenderingCreateInfo rendering_ci = {0};
+    VkFormat color_fmt = VK_FORMAT_UNDEFINED;
+    rvk_pl_render_target(&actual_ci, ci.render_pass, ci.render_texture, &rendering_ci, &color_fmt);
 
 
-    RAG_VK(vkCreateGraphicsPipelines(rvk_ctx.device, VK_NULL_HANDLE, 1, &actual_ci, NULL, pl));
-
     if (using_shader_lazy_method) {
-        vkDestroyShaderModule(rvk_ctx.device, stages_lazy_method[0].module, NULL);
-        vkDestroyShaderModule(rvk_ctx.device, stages_lazy_method[1].module, NULL);
+        rvk_gfx_pl_create(&actual_ci, pl, stages_lazy_method[0].module, stages_lazy_method[1].module);
+    } else {
+        rvk_gfx_pl_create(&actual_ci, pl, VK_NULL_HANDLE, VK_NULL_HANDLE);
     }
 }
 
@@ -1353,8 +2635,8 @@ void rvk_sst_pl_init(VkPipelineLayout pl_layout, VkPipeline *pl)
             .pName = "main",
         },
     };
-    rvk_shader_mod_init("./res/sst.vert.glsl.spv", &stages[0].module);
-    rvk_shader_mod_init("./res/sst.frag.glsl.spv", &stages[1].module);
+    stages[0].module = rvk_shader_acquire("./res/sst.vert.glsl.spv");
+    stages[1].module = rvk_shader_acquire("./res/sst.frag.glsl.spv");
 
     /* populate fields for graphics pipeline create info */
     VkDynamicState dynamic_states[] = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
@@ -1415,13 +2697,13 @@ void rvk_sst_pl_init(VkPipelineLayout pl_layout, VkPipeline *pl)
         .pDynamicState = &dynamic_state_ci,
         .pDepthStencilState = &depth_ci,
         .layout = pl_layout,
-        .renderPass = rvk_ctx.render_pass,
         .subpass = 0,
     };
+    VkPipelineRenderingCreateInfo rendering_ci = {0};
+    VkFormat color_fmt = VK_FORMAT_UNDEFINED;
+    rvk_pl_render_target(&pipeline_ci, VK_NULL_HANDLE, NULL, &rendering_ci, &color_fmt);
 
-    RAG_VK(vkCreateGraphicsPipelines(rvk_ctx.device, VK_NULL_HANDLE, 1, &pipeline_ci, NULL, pl));
-    vkDestroyShaderModule(rvk_ctx.device, stages[0].module, NULL);
-    vkDestroyShaderModule(rvk_ctx.device, stages[1].module, NULL);
+    rvk_gfx_pl_create(&pipeline_ci, pl, stages[0].module, stages[1].module);
 }
 
 void rvk_pl_layout_init(VkPipelineLayoutCreateInfo ci, VkPipelineLayout *pl_layout)
@@ -1451,20 +2733,58 @@ void rvk_create_pipeline_layout_(VkPipelineLayout *pl_layout, Rvk_Pipeline_Layou
 }
 
 void rvk_compute_pl_init(const char *shader_name, VkPipelineLayout pl_layout, VkPipeline *pipeline)
+{
+    rvk_compute_pl_init_spec(shader_name, pl_layout, NULL, pipeline);
+}
+
+void rvk_compute_pl_init_spec(const char *shader_name, VkPipelineLayout pl_layout, const VkSpecializationInfo *spec_info, VkPipeline *pipeline)
 {
     VkPipelineShaderStageCreateInfo shader_ci = {
         .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
         .stage = VK_SHADER_STAGE_COMPUTE_BIT,
         .pName = "main",
+        .pSpecializationInfo = spec_info,
     };
-    rvk_shader_mod_init(shader_name, &shader_ci.module);
+    shader_ci.module = rvk_shader_acquire(shader_name);
     VkComputePipelineCreateInfo pipeline_ci = {
         .sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
         .layout = pl_layout,
         .stage = shader_ci,
     };
-    RAG_VK(vkCreateComputePipelines(rvk_ctx.device, VK_NULL_HANDLE, 1, &pipeline_ci, NULL, pipeline));
-    vkDestroyShaderModule(rvk_ctx.device, shader_ci.module, NULL);
+    rvk_compute_pl_create(&pipeline_ci, pipeline, shader_ci.module);
+}
+
+const VkSpecializationInfo *rvk_spec_constants(Rvk_Spec_Constants *spec, const uint32_t *values, uint32_t count)
+{
+    if (count > RVK_MAX_SPEC_CONSTANTS) {
+        rvk_log(RVK_ERROR, "%u specialization constants requested, at most %d supported", count, RVK_MAX_SPEC_CONSTANTS);
+        RVK_EXIT_APP;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        spec->data[i] = values[i];
+        spec->entries[i] = (VkSpecializationMapEntry) {
+            .constantID = i,
+            .offset = i*sizeof(uint32_t),
+            .size = sizeof(uint32_t),
+        };
+    }
+    spec->info = (VkSpecializationInfo) {
+        .mapEntryCount = count,
+        .pMapEntries = spec->entries,
+        .dataSize = count*sizeof(uint32_t),
+        .pData = spec->data,
+    };
+    return &spec->info;
+}
+
+uint32_t rvk_max_compute_workgroup_size()
+{
+    VkPhysicalDeviceProperties props = {0};
+    vkGetPhysicalDeviceProperties(rvk_ctx.phys_device, &props);
+    uint32_t max_x = props.limits.maxComputeWorkGroupSize[0];
+    uint32_t max_invocations = props.limits.maxComputeWorkGroupInvocations;
+    return (max_x < max_invocations) ? max_x : max_invocations;
 }
 
 void rvk_destroy_pl_res(VkPipeline pipeline, VkPipelineLayout pl_layout)
@@ -1475,6 +2795,16 @@ void rvk_destroy_pl_res(VkPipeline pipeline, VkPipelineLayout pl_layout)
 
 VkCommandBuffer rvk_get_cmd_buff()
 {
+    if (rvk_record_slot) return rvk_record_slot->cmd_buff;
+    Rvk_Parallel_Record *par = &rvk_ctx.parallel;
+    if (par->active) {
+        if (!par->refused) {
+            rvk_log(RVK_ERROR, "drawing outside rvk_record_parallel while a parallel pass is active, "
+                               "its primary only takes secondary command buffers");
+            par->refused = true;
+        }
+        return VK_NULL_HANDLE;
+    }
     return rvk_ctx.cmd_buff;
 }
 
@@ -1489,61 +2819,385 @@ void rvk_enable_atomic_features()
     rvk_ctx.enable_atomic_features = true;
 }
 
+void rvk_enable_bindless()
+{
+#ifdef PLATFORM_ANDROID_QUEST
+    rvk_log(RVK_WARNING, "bindless needs vulkan 1.2 descriptor indexing, keeping descriptor sets on this platform");
+#else
+    rvk_log(RVK_INFO, "enabling bindless descriptors");
+    rvk_ctx.enable_bindless = true;
+#endif
+}
+
+void rvk_enable_draw_indirect()
+{
+    rvk_log(RVK_INFO, "enabling draw indirect");
+    rvk_ctx.enable_draw_indirect = true;
+}
+
+void rvk_enable_buffer_device_address()
+{
+#ifdef PLATFORM_ANDROID_QUEST
+    rvk_log(RVK_WARNING, "buffer device address needs vulkan 1.2, not available on this platform");
+#else
+    rvk_log(RVK_INFO, "enabling buffer device address");
+    rvk_ctx.enable_buffer_device_address = true;
+#endif
+}
+
+VkDeviceAddress rvk_buff_device_address(Rvk_Buffer buff)
+{
+    if (!rvk_ctx.features.buffer_device_address) {
+        rvk_log(RVK_ERROR, "buffer device address is not enabled, call rvk_enable_buffer_device_address() before initializing");
+        RVK_EXIT_APP;
+    }
+#ifdef PLATFORM_ANDROID_QUEST
+    return 0;
+#else
+    VkBufferDeviceAddressInfo info = {.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO, .buffer = buff.handle};
+    return vkGetBufferDeviceAddress(rvk_ctx.device, &info);
+#endif
+}
+
+void rvk_enable_dynamic_rendering()
+{
+#ifdef PLATFORM_ANDROID_QUEST
+    rvk_log(RVK_WARNING, "dynamic rendering needs vulkan 1.3, keeping render passes on this platform");
+#else
+    rvk_log(RVK_INFO, "enabling dynamic rendering");
+    rvk_ctx.enable_dynamic_rendering = true;
+#endif
+}
+
 void rvk_enable_multiview_feature()
 {
     rvk_log(RVK_INFO, "enabling multiview feature");
     rvk_ctx.enable_multiview_feature = true;
 }
 
-// TODO: make this obsolete with rvk_create_shader_module
-void rvk_shader_mod_init(const char *file_name, VkShaderModule *module)
+void rvk_set_frames_in_flight(uint32_t count)
 {
-#ifdef PLATFORM_ANDROID_QUEST
-    char *content = NULL;
+    if (rvk_ctx.device) {
+        rvk_log(RVK_WARNING, "frames in flight must be set before rvk_init");
+        return;
+    }
+    rvk_ctx.frames_in_flight = clamp(count, 1, RVK_MAX_FRAMES_IN_FLIGHT);
+}
+
+uint32_t rvk_get_frames_in_flight()
+{
+    return (rvk_ctx.frames_in_flight) ? rvk_ctx.frames_in_flight : RVK_DEFAULT_FRAMES_IN_FLIGHT;
+}
+
+void rvk_use_frame(uint32_t frame_idx)
+{
+    Rvk_Frame *frame = &rvk_ctx.frames[frame_idx];
+    rvk_ctx.cmd_buff       = frame->cmd_buff;
+    rvk_ctx.img_avail_sem  = frame->img_avail_sem;
+    rvk_ctx.fence          = frame->fence;
+}
+
+uint32_t rvk_advance_frame()
+{
+    rvk_ctx.frame_idx = (rvk_ctx.frame_idx + 1) % rvk_ctx.frames_in_flight;
+    rvk_use_frame(rvk_ctx.frame_idx);
+    return rvk_ctx.frame_idx;
+}
+
+uint32_t rvk_get_frame_idx()
+{
+    return rvk_ctx.frame_idx;
+}
+
+/* written in front of the driver's cache data, the driver's own header has no driver version */
+typedef struct {
+    char magic[4];
+    uint32_t vendor_id;
+    uint32_t device_id;
+    uint32_t driver_version;
+    uint8_t uuid[VK_UUID_SIZE];
+    uint64_t data_size;
+} Rvk_Pipeline_Cache_Header;
+
+static bool rvk_pl_cache_header_valid(const Rvk_Pipeline_Cache_Header *header, size_t file_size)
+{
+    VkPhysicalDeviceProperties props = {0};
+    vkGetPhysicalDeviceProperties(rvk_ctx.phys_device, &props);
+    if (memcmp(header->magic, "RVKC", 4) != 0) return false;
+    if (header->vendor_id != props.vendorID || header->device_id != props.deviceID) return false;
+    if (header->driver_version != props.driverVersion) return false;
+    if (memcmp(header->uuid, props.pipelineCacheUUID, VK_UUID_SIZE) != 0) return false;
+    return header->data_size == file_size - sizeof(*header);
+}
+
+void rvk_pl_cache_init(const char *path)
+{
+    rvk_ctx.pl_cache_path = path;
+    Rvk_String_Builder sb = {0};
+    VkPipelineCacheCreateInfo cache_ci = {.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO};
+
+#if defined(PLATFORM_DESKTOP_GLFW) || defined(PLATFORM_HEADLESS)
+    /* a missing file is the normal first run, so don't go through rvk_read_entire_file's error */
+    FILE *f = (path) ? fopen(path, "rb") : NULL;
+    if (f) {
+        fclose(f);
+        if (rvk_read_entire_file(path, &sb) && sb.count >= sizeof(Rvk_Pipeline_Cache_Header)) {
+            const Rvk_Pipeline_Cache_Header *header = (const Rvk_Pipeline_Cache_Header *)sb.items;
+            if (rvk_pl_cache_header_valid(header, sb.count)) {
+                cache_ci.initialDataSize = header->data_size;
+                cache_ci.pInitialData = sb.items + sizeof(*header);
+                rvk_log(RVK_INFO, "loaded pipeline cache %s (%zu bytes)", path, (size_t)header->data_size);
+            } else {
+                rvk_log(RVK_INFO, "pipeline cache %s is from a different device or driver, ignoring it", path);
+            }
+        }
+    }
+#endif
+
+    RAG_VK(vkCreatePipelineCache(rvk_ctx.device, &cache_ci, NULL, &rvk_ctx.pl_cache));
+    rvk_sb_free(sb);
+}
+
+void rvk_pl_cache_save()
+{
+#if defined(PLATFORM_DESKTOP_GLFW) || defined(PLATFORM_HEADLESS)
+    if (!rvk_ctx.pl_cache || !rvk_ctx.pl_cache_path) return;
+
+    size_t data_size = 0;
+    RAG_VK(vkGetPipelineCacheData(rvk_ctx.device, rvk_ctx.pl_cache, &data_size, NULL));
+    char *file = RVK_REALLOC(NULL, sizeof(Rvk_Pipeline_Cache_Header) + data_size);
+    RVK_ASSERT(file != NULL && "\"Buy more RAM lol\"\n\t\t-Tsoding");
+    RAG_VK(vkGetPipelineCacheData(rvk_ctx.device, rvk_ctx.pl_cache, &data_size, file + sizeof(Rvk_Pipeline_Cache_Header)));
+
+    VkPhysicalDeviceProperties props = {0};
+    vkGetPhysicalDeviceProperties(rvk_ctx.phys_device, &props);
+    Rvk_Pipeline_Cache_Header header = {
+        .magic = {'R', 'V', 'K', 'C'},
+        .vendor_id = props.vendorID,
+        .device_id = props.deviceID,
+        .driver_version = props.driverVersion,
+        .data_size = data_size,
+    };
+    memcpy(header.uuid, props.pipelineCacheUUID, VK_UUID_SIZE);
+    memcpy(file, &header, sizeof(header));
+
+    /* write to a temporary and rename, so a crash mid-write never leaves a torn cache behind */
+    Rvk_String_Builder tmp_path = {0};
+    rvk_sb_append_buf(&tmp_path, rvk_ctx.pl_cache_path, strlen(rvk_ctx.pl_cache_path));
+    rvk_sb_append_buf(&tmp_path, ".tmp", 5);
+    if (rvk_write_entire_file(tmp_path.items, file, sizeof(header) + data_size)) {
+        if (rename(tmp_path.items, rvk_ctx.pl_cache_path) != 0)
+            rvk_log(RVK_WARNING, "could not replace pipeline cache %s: %s", rvk_ctx.pl_cache_path, strerror(errno));
+    }
+    rvk_sb_free(tmp_path);
+    RVK_FREE(file);
+#endif
+}
+
+void rvk_pl_cache_destroy()
+{
+    if (!rvk_ctx.pl_cache) return;
+    rvk_pl_cache_save();
+    vkDestroyPipelineCache(rvk_ctx.device, rvk_ctx.pl_cache, NULL);
+    rvk_ctx.pl_cache = VK_NULL_HANDLE;
+}
+
+/* read-only view of a whole file, memory mapped where the platform allows it */
+typedef struct {
+    const void *data;
+    size_t size;
+#if defined(PLATFORM_ANDROID_QUEST)
+    AAsset *asset;
+#elif defined(_WIN32)
+    Rvk_String_Builder sb;
+#endif
+} Rvk_Mapped_File;
+
+static bool rvk_map_file(const char *path, Rvk_Mapped_File *file)
+{
+#if defined(PLATFORM_ANDROID_QUEST)
     if (!rvk_aam) {
         rvk_log(RVK_ERROR, "set android asset manager with rvk_set_android_asset_man(AAssetManager *aam)");
         RVK_EXIT_APP;
     }
-    AAsset *file  = AAssetManager_open(rvk_aam, file_name, AASSET_MODE_BUFFER);
-    off_t length  = AAsset_getLength(file);
-    content = malloc(length);
-    AAsset_read(file, content, length);
+    file->asset = AAssetManager_open(rvk_aam, path, AASSET_MODE_BUFFER);
+    if (!file->asset) return false;
+    file->data = AAsset_getBuffer(file->asset);
+    file->size = AAsset_getLength(file->asset);
+    return file->data != NULL;
+#elif defined(_WIN32)
+    /* no mmap here, fall back to reading the file */
+    file->sb = (Rvk_String_Builder){0};
+    if (!rvk_read_entire_file(path, &file->sb)) return false;
+    file->data = file->sb.items;
+    file->size = file->sb.count;
+    return true;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        rvk_log(RVK_ERROR, "Could not open %s for reading: %s", path, strerror(errno));
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) < 0 || st.st_size == 0) {
+        rvk_log(RVK_ERROR, "Could not stat %s or it was empty", path);
+        close(fd);
+        return false;
+    }
+    void *data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        rvk_log(RVK_ERROR, "Could not map %s: %s", path, strerror(errno));
+        return false;
+    }
+    file->data = data;
+    file->size = st.st_size;
+    return true;
+#endif
+}
+
+static void rvk_unmap_file(Rvk_Mapped_File file)
+{
+#if defined(PLATFORM_ANDROID_QUEST)
+    AAsset_close(file.asset);
+#elif defined(_WIN32)
+    rvk_sb_free(file.sb);
+#else
+    munmap((void *)file.data, file.size);
+#endif
+}
+
+static uint64_t rvk_hash_bytes(const void *data, size_t size)
+{
+    /* FNV-1a */
+    const uint8_t *bytes = data;
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+// TODO: make this obsolete with rvk_create_shader_module
+void rvk_shader_mod_init(const char *file_name, VkShaderModule *module)
+{
+    Rvk_Mapped_File file = {0};
+    if (!rvk_map_file(file_name, &file)) {
+        rvk_log(RVK_ERROR, "failed to read entire file %s", file_name);
+        RVK_EXIT_APP;
+    }
     VkShaderModuleCreateInfo module_ci = {
         .sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
-        .codeSize = length,
-        .pCode = (uint32_t *)content,
+        .codeSize = file.size,
+        .pCode = (const uint32_t *)file.data,
     };
     RAG_VK(vkCreateShaderModule(rvk_ctx.device, &module_ci, NULL, module));
-    free(content);
-#endif // PLATFORM_ANDROID_QUEST
+    rvk_unmap_file(file);
+}
 
-#ifdef PLATFORM_DESKTOP_GLFW
-    Rvk_String_Builder sb = {0};
-    if (!rvk_read_entire_file(file_name, &sb)) {
+VkShaderModule rvk_shader_acquire(const char *file_name)
+{
+    Rvk_Shader_Registry *reg = &rvk_ctx.shaders;
+
+    /* the same path again doesn't even touch the file system */
+    for (size_t i = 0; i < reg->count; i++) {
+        if (strcmp(reg->items[i].path, file_name) == 0) {
+            reg->items[i].ref_count++;
+            return reg->items[i].module;
+        }
+    }
+
+    Rvk_Mapped_File file = {0};
+    if (!rvk_map_file(file_name, &file)) {
         rvk_log(RVK_ERROR, "failed to read entire file %s", file_name);
         RVK_EXIT_APP;
     }
+
+    /* a different path with identical spir-v shares the module too */
+    uint64_t hash = rvk_hash_bytes(file.data, file.size);
+    for (size_t i = 0; i < reg->count; i++) {
+        if (reg->items[i].hash == hash && reg->items[i].size == file.size) {
+            rvk_unmap_file(file);
+            reg->items[i].ref_count++;
+            return reg->items[i].module;
+        }
+    }
+
+    Rvk_Shader shader = {
+        .path = RVK_REALLOC(NULL, strlen(file_name) + 1),
+        .hash = hash,
+        .size = file.size,
+        .ref_count = 1,
+    };
     VkShaderModuleCreateInfo module_ci = {
         .sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
-        .codeSize = sb.count,
-        .pCode = (const uint32_t *)sb.items,
+        .codeSize = file.size,
+        .pCode = (const uint32_t *)file.data,
     };
-    RAG_VK(vkCreateShaderModule(rvk_ctx.device, &module_ci, NULL, module));
-    rvk_sb_free(sb);
-#endif // PLATFORM_DESKTOP_GLFW
+    RAG_VK(vkCreateShaderModule(rvk_ctx.device, &module_ci, NULL, &shader.module));
+    rvk_unmap_file(file);
+    memcpy(shader.path, file_name, strlen(file_name) + 1);
+    rvk_da_append(reg, shader);
+    return shader.module;
 }
 
-void rvk_render_pass_init()
+void rvk_shader_release(VkShaderModule module)
 {
-    VkAttachmentDescription color = {
-        .format = rvk_ctx.surface_fmt.format,
+    Rvk_Shader_Registry *reg = &rvk_ctx.shaders;
+    for (size_t i = 0; i < reg->count; i++) {
+        if (reg->items[i].module != module) continue;
+        if (!reg->items[i].ref_count) {
+            rvk_log(RVK_WARNING, "shader %s released more times than it was acquired", reg->items[i].path);
+            return;
+        }
+        reg->items[i].ref_count--;
+        return;
+    }
+    rvk_log(RVK_WARNING, "released a shader module that was not acquired through the registry");
+}
+
+void rvk_shader_registry_trim()
+{
+    Rvk_Shader_Registry *reg = &rvk_ctx.shaders;
+    size_t kept = 0;
+    for (size_t i = 0; i < reg->count; i++) {
+        if (reg->items[i].ref_count) {
+            reg->items[kept++] = reg->items[i];
+            continue;
+        }
+        vkDestroyShaderModule(rvk_ctx.device, reg->items[i].module, NULL);
+        RVK_FREE(reg->items[i].path);
+    }
+    reg->count = kept;
+}
+
+void rvk_shader_registry_destroy()
+{
+    Rvk_Shader_Registry *reg = &rvk_ctx.shaders;
+    for (size_t i = 0; i < reg->count; i++) {
+        vkDestroyShaderModule(rvk_ctx.device, reg->items[i].module, NULL);
+        RVK_FREE(reg->items[i].path);
+    }
+    rvk_da_free(*reg);
+    *reg = (Rvk_Shader_Registry){0};
+}
+
+void rvk_render_pass_init()
+{
+    VkAttachmentDescription color = {
+        .format = rvk_ctx.surface_fmt.format,
         .samples = VK_SAMPLE_COUNT_1_BIT,
         .loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
         .storeOp = VK_ATTACHMENT_STORE_OP_STORE,
         .stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
         .stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
         .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+#ifdef PLATFORM_HEADLESS
+        .finalLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, // ready for rvk_headless_read_frame
+#else
         .finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+#endif
     };
     VkAttachmentReference color_ref = {
         .layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
@@ -1699,6 +3353,130 @@ void rvk_destroy_frame_buff(VkFramebuffer frame_buff)
     vkDestroyFramebuffer(rvk_ctx.device, frame_buff, NULL);
 }
 
+static void rvk_cmd_attachment_barrier(VkCommandBuffer cmd_buff, VkImage img, VkImageAspectFlags aspect, uint32_t layer_count,
+                                       VkImageLayout old_layout, VkImageLayout new_layout,
+                                       VkPipelineStageFlags src_stage, VkAccessFlags src_access,
+                                       VkPipelineStageFlags dst_stage, VkAccessFlags dst_access)
+{
+    VkImageMemoryBarrier barrier = {
+        .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+        .srcAccessMask = src_access,
+        .dstAccessMask = dst_access,
+        .oldLayout = old_layout,
+        .newLayout = new_layout,
+        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .image = img,
+        .subresourceRange = {
+            .aspectMask = aspect,
+            .baseMipLevel = 0,
+            .levelCount = 1,
+            .baseArrayLayer = 0,
+            .layerCount = layer_count,
+        },
+    };
+    vkCmdPipelineBarrier(cmd_buff, src_stage, dst_stage, VK_FLAGS_NONE, 0, NULL, 0, NULL, 1, &barrier);
+}
+
+/* the attachments are cleared on load, so they start from UNDEFINED and whatever used them before only
+ * needs to finish, the layout transitions a render pass would do are recorded as barriers instead */
+static void rvk_cmd_begin_rendering(VkCommandBuffer cmd_buff, Rvk_Dynamic_Target target, VkImageView color_view,
+                                    VkImageView depth_view, VkExtent2D extent, const VkClearValue *clear_values)
+{
+    if (rvk_dynamic_target.active) {
+        rvk_log(RVK_ERROR, "dynamic rendering began while another pass was still recording");
+        RVK_EXIT_APP;
+    }
+
+    rvk_cmd_attachment_barrier(
+        cmd_buff, target.color, VK_IMAGE_ASPECT_COLOR_BIT, target.layer_count,
+        VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0,
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT
+    );
+    rvk_cmd_attachment_barrier(
+        cmd_buff, target.depth, VK_IMAGE_ASPECT_DEPTH_BIT, target.layer_count,
+        VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+        VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+        VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT
+    );
+
+    VkRenderingAttachmentInfo color_att = {
+        .sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
+        .imageView = color_view,
+        .imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+        .loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
+        .storeOp = VK_ATTACHMENT_STORE_OP_STORE,
+        .clearValue = clear_values[0],
+    };
+    /* depth that stays an attachment (swapchain) is never read afterwards */
+    bool keep_depth = target.depth_final != VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+    VkRenderingAttachmentInfo depth_att = {
+        .sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
+        .imageView = depth_view,
+        .imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+        .loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
+        .storeOp = (keep_depth) ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE,
+        .clearValue = clear_values[1],
+    };
+    VkRenderingInfo rendering_info = {
+        .sType = VK_STRUCTURE_TYPE_RENDERING_INFO,
+        .flags = (target.secondary) ? VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT : 0,
+        .renderArea.extent = extent,
+        .layerCount = 1,
+        .viewMask = (target.layer_count > 1) ? (1u << target.layer_count) - 1 : 0,
+        .colorAttachmentCount = 1,
+        .pColorAttachments = &color_att,
+        .pDepthAttachment = &depth_att,
+    };
+    rvk_cmd_begin_rendering_pfn(cmd_buff, &rendering_info);
+
+    rvk_dynamic_target = target;
+    rvk_dynamic_target.active = true;
+}
+
+static void rvk_cmd_end_rendering(VkCommandBuffer cmd_buff)
+{
+    rvk_cmd_end_rendering_pfn(cmd_buff);
+
+    Rvk_Dynamic_Target target = rvk_dynamic_target;
+    rvk_cmd_attachment_barrier(
+        cmd_buff, target.color, VK_IMAGE_ASPECT_COLOR_BIT, target.layer_count,
+        VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, target.color_final,
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_ACCESS_MEMORY_READ_BIT
+    );
+    if (target.depth_final != VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL) {
+        rvk_cmd_attachment_barrier(
+            cmd_buff, target.depth, VK_IMAGE_ASPECT_DEPTH_BIT, target.layer_count,
+            VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, target.depth_final,
+            VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT, VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_ACCESS_MEMORY_READ_BIT
+        );
+    }
+    rvk_dynamic_target = (Rvk_Dynamic_Target){0};
+}
+
+static void rvk_cmd_begin_swapchain_rendering(VkCommandBuffer cmd_buff, VkExtent2D extent, const VkClearValue *clear_values,
+                                              bool secondary)
+{
+    Rvk_Dynamic_Target target = {
+        .secondary = secondary,
+        .color = rvk_ctx.swapchain.imgs[rvk_img_idx],
+        .depth = rvk_ctx.depth_img.handle,
+        .layer_count = 1,
+#ifdef PLATFORM_HEADLESS
+        .color_final = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, // ready for rvk_headless_read_frame
+#else
+        .color_final = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+#endif
+        .depth_final = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+    };
+    VkImageView color_view = rvk_ctx.swapchain.img_views[rvk_img_idx];
+    rvk_cmd_begin_rendering(cmd_buff, target, color_view, rvk_ctx.depth_img_view, extent, clear_values);
+}
+
 void rvk_begin_render_pass(float r, float g, float b, float a)
 {
     VkClearValue clear_color = {
@@ -1711,6 +3489,10 @@ void rvk_begin_render_pass(float r, float g, float b, float a)
         }
     };
     VkClearValue clear_values[] = {clear_color, clear_depth};
+    if (rvk_ctx.features.dynamic_rendering) {
+        rvk_cmd_begin_swapchain_rendering(rvk_ctx.cmd_buff, rvk_ctx.extent, clear_values, false);
+        return;
+    }
     VkRenderPassBeginInfo begin_rp = {
         .sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
         .renderPass = rvk_ctx.render_pass,
@@ -1745,6 +3527,11 @@ void rvk_cmd_begin_render_pass_(VkCommandBuffer cmd_buff, Rvk_Render_Pass_Begin_
         rvk_log(RVK_ERROR, "extent was not specified for render pass");
         return;
     }
+    if (rvk_ctx.features.dynamic_rendering && !rvk_bi.render_pass) {
+        const VkClearValue *clears = (bi.clearValueCount >= 2) ? bi.pClearValues : clear_values;
+        rvk_cmd_begin_swapchain_rendering(cmd_buff, bi.renderArea.extent, clears, false);
+        return;
+    }
     vkCmdBeginRenderPass(cmd_buff, &bi, VK_SUBPASS_CONTENTS_INLINE);
 }
 
@@ -1773,46 +3560,288 @@ void rvk_begin_offscreen_render_pass(float r, float g, float b, float a, VkRende
     vkCmdBeginRenderPass(rvk_ctx.cmd_buff, &begin_rp, VK_SUBPASS_CONTENTS_INLINE);
 }
 
+void rvk_begin_render_texture(Rvk_Render_Texture rt, float r, float g, float b, float a)
+{
+    if (rt.rp) {
+        rvk_begin_offscreen_render_pass(r, g, b, a, rt.rp, rt.fb, rt.extent);
+        return;
+    }
+    if (!rvk_ctx.features.dynamic_rendering) {
+        rvk_log(RVK_ERROR, "render texture has no render pass and dynamic rendering is not enabled");
+        RVK_EXIT_APP;
+    }
+
+    VkClearValue clear_values[] = {
+        {.color = {{r, g, b, a}}},
+        {.depthStencil = {.depth = 1.0f, .stencil = 0}},
+    };
+    /* same final layouts as rvk_create_basic_render_pass */
+    Rvk_Dynamic_Target target = {
+        .color = rt.color.img.handle,
+        .depth = rt.depth.img.handle,
+        .layer_count = (rt.view_count) ? rt.view_count : 1,
+        .color_final = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+        .depth_final = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL,
+    };
+    rvk_cmd_begin_rendering(rvk_ctx.cmd_buff, target, rt.color.view, rt.depth.view, rt.extent, clear_values);
+}
+
 void rvk_end_render_pass()
 {
-    vkCmdEndRenderPass(rvk_ctx.cmd_buff);
+    rvk_cmd_end_render_pass(rvk_ctx.cmd_buff);
 }
 
 void rvk_cmd_end_render_pass(VkCommandBuffer cmd_buff)
 {
+    if (cmd_buff == rvk_ctx.cmd_buff) rvk_ctx.parallel.active = false;
+    if (rvk_dynamic_target.active) {
+        rvk_cmd_end_rendering(cmd_buff);
+        return;
+    }
     vkCmdEndRenderPass(cmd_buff);
 }
 
+void rvk_begin_parallel_render_pass(float r, float g, float b, float a)
+{
+    VkClearValue clear_color = {
+        .color = {{r, g, b, a}}
+    };
+    VkClearValue clear_depth = {
+        .depthStencil = {
+            .depth = 1.0f,
+            .stencil = 0,
+        }
+    };
+    VkClearValue clear_values[] = {clear_color, clear_depth};
+    Rvk_Parallel_Record *par = &rvk_ctx.parallel;
+    if (rvk_ctx.features.dynamic_rendering) {
+        rvk_cmd_begin_swapchain_rendering(rvk_ctx.cmd_buff, rvk_ctx.extent, clear_values, true);
+        par->render_pass = VK_NULL_HANDLE;
+        par->frame_buff = VK_NULL_HANDLE;
+    } else {
+        VkRenderPassBeginInfo begin_rp = {
+            .sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
+            .renderPass = rvk_ctx.render_pass,
+            .framebuffer = rvk_ctx.swapchain.frame_buffs[rvk_img_idx],
+            .renderArea.extent = rvk_ctx.extent,
+            .clearValueCount = RVK_ARRAY_LEN(clear_values),
+            .pClearValues = clear_values,
+        };
+        vkCmdBeginRenderPass(rvk_ctx.cmd_buff, &begin_rp, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+        par->render_pass = begin_rp.renderPass;
+        par->frame_buff = begin_rp.framebuffer;
+    }
+    par->color_fmt = rvk_ctx.surface_fmt.format;
+    par->depth_fmt = rvk_ctx.depth_img.format;
+    par->active = true;
+    par->refused = false;
+}
+
+/* next free secondary of slot idx for this frame, pools and buffers are created the first time
+ * they are needed. runs on the calling thread so workers never touch the slot arrays */
+static VkCommandBuffer rvk_record_slot_acquire(uint32_t idx)
+{
+    Rvk_Parallel_Record *par = &rvk_ctx.parallel;
+    Rvk_Record_Slot *slot = &par->slots[idx];
+    uint32_t frame = rvk_ctx.frame_idx;
+    if (!slot->pools[frame]) {
+        VkCommandPoolCreateInfo pool_ci = {
+            .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+            .flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
+            .queueFamilyIndex = rvk_ctx.queue_idx,
+        };
+        RAG_VK(vkCreateCommandPool(rvk_ctx.device, &pool_ci, NULL, &slot->pools[frame]));
+        if (idx >= par->slot_count) par->slot_count = idx + 1;
+    }
+    if (slot->used[frame] == slot->cmd_buffs[frame].count) {
+        VkCommandBuffer cmd_buff;
+        rvk_allocate_command_buffer(&cmd_buff, .command_pool = slot->pools[frame], .level = VK_COMMAND_BUFFER_LEVEL_SECONDARY);
+        rvk_da_append(&slot->cmd_buffs[frame], cmd_buff);
+    }
+    return slot->cmd_buffs[frame].items[slot->used[frame]++];
+}
+
+/* the frame's fence signalled, its secondaries can be recorded again */
+void rvk_record_slots_reset()
+{
+    uint32_t frame = rvk_ctx.frame_idx;
+    for (uint32_t i = 0; i < rvk_ctx.parallel.slot_count; i++) {
+        Rvk_Record_Slot *slot = &rvk_ctx.parallel.slots[i];
+        if (!slot->used[frame]) continue;
+        RAG_VK(vkResetCommandPool(rvk_ctx.device, slot->pools[frame], 0));
+        slot->used[frame] = 0;
+    }
+}
+
+void rvk_record_slots_destroy()
+{
+    for (uint32_t i = 0; i < rvk_ctx.parallel.slot_count; i++) {
+        Rvk_Record_Slot *slot = &rvk_ctx.parallel.slots[i];
+        for (uint32_t j = 0; j < RVK_MAX_FRAMES_IN_FLIGHT; j++) {
+            if (slot->pools[j]) vkDestroyCommandPool(rvk_ctx.device, slot->pools[j], NULL);
+            rvk_da_free(slot->cmd_buffs[j]);
+        }
+    }
+    rvk_ctx.parallel = (Rvk_Parallel_Record){0};
+}
+
+typedef struct {
+    Rvk_Record_Slot *slot;
+    uint32_t idx;
+    uint32_t count;
+    Rvk_Record_Fn record;
+    void *data;
+} Rvk_Record_Work;
+
+static void *rvk_record_worker(void *arg)
+{
+    Rvk_Record_Work *work = arg;
+    Rvk_Parallel_Record *par = &rvk_ctx.parallel;
+    VkCommandBufferInheritanceRenderingInfo rendering_info = {
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO,
+        .colorAttachmentCount = 1,
+        .pColorAttachmentFormats = &par->color_fmt,
+        .depthAttachmentFormat = par->depth_fmt,
+        .rasterizationSamples = VK_SAMPLE_COUNT_1_BIT,
+    };
+    VkCommandBufferInheritanceInfo inheritance = {
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+        .pNext = (par->render_pass) ? NULL : &rendering_info,
+        .renderPass = par->render_pass,
+        .framebuffer = par->frame_buff,
+    };
+    VkCommandBufferBeginInfo begin_info = {
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+        .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT,
+        .pInheritanceInfo = &inheritance,
+    };
+    RAG_VK(vkBeginCommandBuffer(work->slot->cmd_buff, &begin_info));
+
+    rvk_record_slot = work->slot;
+    work->record(work->idx, work->count, work->data);
+    rvk_record_slot = NULL;
+
+    RAG_VK(vkEndCommandBuffer(work->slot->cmd_buff));
+    return NULL;
+}
+
+void rvk_record_parallel(uint32_t thread_count, Rvk_Record_Fn record, void *data)
+{
+    Rvk_Parallel_Record *par = &rvk_ctx.parallel;
+    if (!par->active || rvk_record_slot) {
+        rvk_log(RVK_ERROR, "rvk_record_parallel needs a pass begun by rvk_begin_parallel_render_pass, "
+                           "and cannot be called from a recording thread");
+        RVK_EXIT_APP;
+    }
+    if (!thread_count) thread_count = 1;
+    if (thread_count > RVK_MAX_RECORD_THREADS) {
+        rvk_log(RVK_WARNING, "%u recording threads clamped to %u", thread_count, RVK_MAX_RECORD_THREADS);
+        thread_count = RVK_MAX_RECORD_THREADS;
+    }
+
+    Rvk_Record_Work work[RVK_MAX_RECORD_THREADS];
+    VkCommandBuffer cmd_buffs[RVK_MAX_RECORD_THREADS];
+    pthread_t threads[RVK_MAX_RECORD_THREADS];
+    for (uint32_t t = 0; t < thread_count; t++) {
+        Rvk_Record_Slot *slot = &par->slots[t];
+        slot->cmd_buff = cmd_buffs[t] = rvk_record_slot_acquire(t);
+        slot->cmd_state = (Rvk_Cmd_State){.cmd_buff = slot->cmd_buff};
+        work[t] = (Rvk_Record_Work){slot, t, thread_count, record, data};
+    }
+
+    /* the calling thread records slice 0 instead of waiting */
+    for (uint32_t t = 1; t < thread_count; t++) {
+        if (pthread_create(&threads[t], NULL, rvk_record_worker, &work[t]) != 0) {
+            rvk_log(RVK_WARNING, "could not start recording thread, recording its slice here");
+            rvk_record_worker(&work[t]);
+            threads[t] = pthread_self();
+        }
+    }
+    rvk_record_worker(&work[0]);
+    for (uint32_t t = 1; t < thread_count; t++)
+        if (!pthread_equal(threads[t], pthread_self())) pthread_join(threads[t], NULL);
+
+    vkCmdExecuteCommands(rvk_ctx.cmd_buff, thread_count, cmd_buffs);
+    for (uint32_t t = 0; t < thread_count; t++) {
+        Rvk_Record_Slot *slot = &par->slots[t];
+        for (size_t i = 0; i < RVK_CMD_STATE_COUNT; i++) {
+            rvk_ctx.cmd_state.stats.issued[i] += slot->cmd_state.stats.issued[i];
+            rvk_ctx.cmd_state.stats.skipped[i] += slot->cmd_state.stats.skipped[i];
+        }
+        slot->cmd_buff = VK_NULL_HANDLE;
+    }
+    /* executing secondaries leaves the primary's bound state undefined */
+    rvk_cmd_state_invalidate();
+}
+
 void rvk_end_rec_gfx()
 {
     RAG_VK(vkEndCommandBuffer(rvk_ctx.cmd_buff));
+    rvk_ctx.cmd_stats = rvk_ctx.cmd_state.stats;
+    rvk_ctx.cmd_state.cmd_buff = VK_NULL_HANDLE;
 }
 
 void rvk_end_command_buffer(VkCommandBuffer cmd_buff)
 {
     RAG_VK(vkEndCommandBuffer(cmd_buff));
+    if (cmd_buff == rvk_ctx.cmd_state.cmd_buff) {
+        rvk_ctx.cmd_stats = rvk_ctx.cmd_state.stats;
+        rvk_ctx.cmd_state.cmd_buff = VK_NULL_HANDLE;
+    }
 }
 
-void rvk_submit_gfx()
+uint64_t rvk_submit_gfx()
 {
-    VkPipelineStageFlags wait_stage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    VkSemaphore wait_sems[2] = {0};
+    VkPipelineStageFlags wait_stages[2] = {0};
+    uint64_t wait_values[2] = {0};
+    uint32_t wait_count = 0;
+#ifndef PLATFORM_HEADLESS
+    wait_sems[wait_count] = rvk_ctx.img_avail_sem;
+    wait_stages[wait_count++] = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+#endif
+    /* compute submitted this frame finishes before anything that could read what it wrote */
+    if (rvk_ctx.compute.pending) {
+        wait_sems[wait_count] = rvk_ctx.compute.timeline.sem;
+        wait_values[wait_count] = rvk_ctx.compute.pending;
+        wait_stages[wait_count++] = VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT |
+                                    VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT |
+                                    VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT;
+        rvk_ctx.compute.pending = 0;
+    }
     VkSubmitInfo submit = {
         .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
         .commandBufferCount = 1,
         .pCommandBuffers = &rvk_ctx.cmd_buff,
-        .signalSemaphoreCount = 1,
-        .pSignalSemaphores = &rvk_ctx.render_fin_sem,
-        .waitSemaphoreCount = 1,
-        .pWaitSemaphores = &rvk_ctx.img_avail_sem,
-        .pWaitDstStageMask = &wait_stage,
+        .waitSemaphoreCount = wait_count,
+        .pWaitSemaphores = wait_sems,
+        .pWaitDstStageMask = wait_stages,
     };
 
-    RAG_VK(vkQueueSubmit(rvk_ctx.unified_queue, 1, &submit, rvk_ctx.fence));
+#ifdef PLATFORM_HEADLESS
+    /* nothing to acquire or present, the fence alone tracks the frame */
+    uint64_t frame_value = rvk_timeline_submit(&rvk_ctx.timeline, rvk_ctx.unified_queue, submit, rvk_ctx.fence, wait_values);
+    rvk_ctx.frames[rvk_ctx.frame_idx].gfx_value = frame_value;
+    rvk_headless_last_img = rvk_img_idx;
+    rvk_stg_ring_submit(RVK_STAGING_FRAME, &rvk_ctx.timeline, frame_value);
+    rvk_bindless_submit(rvk_ctx.frame_idx);
+    rvk_timeline_assign_deferred(frame_value);
+    rvk_advance_frame();
+    return frame_value;
+#endif
+
+    submit.signalSemaphoreCount = 1;
+    submit.pSignalSemaphores = &rvk_ctx.render_fin_sems[rvk_img_idx];
+    uint64_t value = rvk_timeline_submit(&rvk_ctx.timeline, rvk_ctx.unified_queue, submit, rvk_ctx.fence, wait_values);
+    rvk_ctx.frames[rvk_ctx.frame_idx].gfx_value = value;
+    rvk_stg_ring_submit(RVK_STAGING_FRAME, &rvk_ctx.timeline, value);
+    rvk_bindless_submit(rvk_ctx.frame_idx);
+    rvk_timeline_assign_deferred(value);
 
     VkPresentInfoKHR present = {
         .sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
         .waitSemaphoreCount = 1,
-        .pWaitSemaphores = &rvk_ctx.render_fin_sem,
+        .pWaitSemaphores = &rvk_ctx.render_fin_sems[rvk_img_idx],
         .swapchainCount = 1,
         .pSwapchains = &rvk_ctx.swapchain.handle,
         .pImageIndices = &rvk_img_idx,
@@ -1824,9 +3853,12 @@ void rvk_submit_gfx()
     } else if (!RVK_SUCCEEDED(res)) {
         rvk_handle_bad_vk_result(res, "vkQueuePresentKHR");
     }
+
+    rvk_advance_frame();
+    return value;
 }
 
-void rvk_queue_submit_(VkQueue queue, VkFence fence, Rvk_Submit_Info rvk_si)
+uint64_t rvk_queue_submit_(VkQueue queue, VkFence fence, Rvk_Submit_Info rvk_si)
 {
     VkSubmitInfo si = {.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO};
     si.pNext                = (rvk_si.p_next                ) ? rvk_si.p_next                 : NULL;
@@ -1841,14 +3873,373 @@ void rvk_queue_submit_(VkQueue queue, VkFence fence, Rvk_Submit_Info rvk_si)
         rvk_log(RVK_ERROR, "command buffers must be specified in Rvk_Submit_Info");
         RVK_EXIT_APP;
     }
+    return rvk_timeline_submit(rvk_queue_timeline(queue), queue, si, fence, NULL);
+}
+
+void rvk_timeline_init(Rvk_Timeline *timeline)
+{
+    VkSemaphoreTypeCreateInfo type_ci = {
+        .sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO,
+        .semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE,
+    };
+    VkSemaphoreCreateInfo sem_ci = {
+        .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+        .pNext = &type_ci,
+    };
+    *timeline = (Rvk_Timeline){0};
+    RAG_VK(vkCreateSemaphore(rvk_ctx.device, &sem_ci, NULL, &timeline->sem));
+}
+
+/* the device is idle, so everything deferred can go */
+void rvk_timeline_destroy()
+{
+    Rvk_Deferred_Destroys *deferred = &rvk_ctx.timeline.deferred;
+    for (size_t i = 0; i < deferred->count; i++)
+        rvk_destroy_deferred(deferred->items[i]);
+    rvk_da_free(*deferred);
+    vkDestroySemaphore(rvk_ctx.device, rvk_ctx.timeline.sem, NULL);
+    rvk_ctx.timeline = (Rvk_Timeline){0};
+}
+
+/* submits si with the timeline semaphore added to its signal semaphores, binary semaphores ignore their value */
+uint64_t rvk_timeline_submit(Rvk_Timeline *timeline, VkQueue queue, VkSubmitInfo si, VkFence fence, const uint64_t *wait_values)
+{
+    if (si.signalSemaphoreCount >= RVK_MAX_SUBMIT_SIGNALS) {
+        rvk_log(RVK_ERROR, "a submission can signal at most %d semaphores", RVK_MAX_SUBMIT_SIGNALS - 1);
+        RVK_EXIT_APP;
+    }
+
+    uint64_t value = timeline->submitted + 1;
+    VkSemaphore signal_sems[RVK_MAX_SUBMIT_SIGNALS] = {0};
+    uint64_t signal_values[RVK_MAX_SUBMIT_SIGNALS] = {0};
+    for (uint32_t i = 0; i < si.signalSemaphoreCount; i++) signal_sems[i] = si.pSignalSemaphores[i];
+    signal_sems[si.signalSemaphoreCount] = timeline->sem;
+    signal_values[si.signalSemaphoreCount] = value;
+
+    VkTimelineSemaphoreSubmitInfo timeline_si = {
+        .sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO,
+        .pNext = si.pNext,
+        .waitSemaphoreValueCount = (wait_values) ? si.waitSemaphoreCount : 0,
+        .pWaitSemaphoreValues = wait_values,
+        .signalSemaphoreValueCount = si.signalSemaphoreCount + 1,
+        .pSignalSemaphoreValues = signal_values,
+    };
+    si.pNext = &timeline_si;
+    si.signalSemaphoreCount++;
+    si.pSignalSemaphores = signal_sems;
     RAG_VK(vkQueueSubmit(queue, 1, &si, fence));
+
+    timeline->submitted = value;
+    return value;
+}
+
+Rvk_Timeline *rvk_gfx_timeline()
+{
+    return &rvk_ctx.timeline;
+}
+
+Rvk_Timeline *rvk_compute_timeline()
+{
+    return &rvk_ctx.compute.timeline;
+}
+
+/* the unified queue is checked first, compute and transfer alias it when they have no queue of their own */
+Rvk_Timeline *rvk_queue_timeline(VkQueue queue)
+{
+    if (queue == rvk_ctx.unified_queue) return &rvk_ctx.timeline;
+    if (queue == rvk_ctx.compute.queue) return &rvk_ctx.compute.timeline;
+    if (queue == rvk_ctx.transfer.queue) return rvk_transfer_timeline();
+    rvk_log(RVK_ERROR, "queue was not created by rag_vk, it has no timeline");
+    RVK_EXIT_APP;
+    return NULL;
+}
+
+uint64_t rvk_timeline_submitted(Rvk_Timeline *timeline)
+{
+    return timeline->submitted;
+}
+
+uint64_t rvk_timeline_completed(Rvk_Timeline *timeline)
+{
+    uint64_t value = 0;
+    RAG_VK(rvk_get_semaphore_counter_value_pfn(rvk_ctx.device, timeline->sem, &value));
+    timeline->completed = value;
+    return value;
+}
+
+bool rvk_timeline_is_complete(Rvk_Timeline *timeline, uint64_t value)
+{
+    if (value <= timeline->completed) return true;
+    return value <= rvk_timeline_completed(timeline);
+}
+
+void rvk_timeline_wait(Rvk_Timeline *timeline, uint64_t value)
+{
+    if (rvk_timeline_is_complete(timeline, value)) return;
+    if (value > timeline->submitted) {
+        rvk_log(RVK_ERROR, "waiting on timeline value %llu, but only %llu was submitted",
+                (unsigned long long)value, (unsigned long long)timeline->submitted);
+        RVK_EXIT_APP;
+    }
+
+    VkSemaphoreWaitInfo wait_info = {
+        .sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
+        .semaphoreCount = 1,
+        .pSemaphores = &timeline->sem,
+        .pValues = &value,
+    };
+    RAG_VK(rvk_wait_semaphores_pfn(rvk_ctx.device, &wait_info, UINT64_MAX));
+    timeline->completed = value;
+}
+
+void rvk_destroy_deferred(Rvk_Deferred_Destroy res)
+{
+    switch (res.kind) {
+    case RVK_DEFERRED_BUFFER:
+        vkDestroyBuffer(rvk_ctx.device, res.as.buff.handle, NULL);
+        rvk_mem_free(res.as.buff.alloc);
+        break;
+    case RVK_DEFERRED_TEXTURE:
+        vkDestroySampler(rvk_ctx.device, res.as.tex.sampler, NULL);
+        vkDestroyImageView(rvk_ctx.device, res.as.tex.view, NULL);
+        rvk_img_destroy(res.as.tex.img);
+        break;
+    }
+}
+
+/* the frame being recorded may still reference the resource, so it waits on the next frame
+ * submission. without a timeline (before init, after destroy) it goes right away */
+void rvk_defer_destroy(Rvk_Deferred_Destroy res)
+{
+    if (!rvk_ctx.timeline.sem) {
+        rvk_destroy_deferred(res);
+        return;
+    }
+    res.value = 0;
+    rvk_da_append(&rvk_ctx.timeline.deferred, res);
+}
+
+void rvk_timeline_assign_deferred(uint64_t value)
+{
+    Rvk_Deferred_Destroys *deferred = &rvk_ctx.timeline.deferred;
+    for (size_t i = deferred->count; i > 0 && !deferred->items[i - 1].value; i--)
+        deferred->items[i - 1].value = value;
+}
+
+void rvk_timeline_retire()
+{
+    Rvk_Deferred_Destroys *deferred = &rvk_ctx.timeline.deferred;
+    if (!deferred->count) return;
+
+    uint64_t completed = rvk_timeline_completed(&rvk_ctx.timeline);
+    size_t kept = 0;
+    for (size_t i = 0; i < deferred->count; i++) {
+        Rvk_Deferred_Destroy res = deferred->items[i];
+        if (res.value && res.value <= completed) rvk_destroy_deferred(res);
+        else deferred->items[kept++] = res;
+    }
+    deferred->count = kept;
+}
+
+static const char *rvk_cmd_state_names[RVK_CMD_STATE_COUNT] = {
+    [RVK_CMD_BIND_PIPELINE]        = "bind pipeline",
+    [RVK_CMD_BIND_DESCRIPTOR_SETS] = "bind descriptor sets",
+    [RVK_CMD_BIND_VERTEX_BUFFER]   = "bind vertex buffer",
+    [RVK_CMD_BIND_INDEX_BUFFER]    = "bind index buffer",
+    [RVK_CMD_SET_VIEWPORT]         = "set viewport",
+    [RVK_CMD_SET_SCISSOR]          = "set scissor",
+    [RVK_CMD_PUSH_CONSTANTS]       = "push constants",
+};
+
+/* a thread recording a slice of rvk_record_parallel tracks its own secondary */
+static Rvk_Cmd_State *rvk_cmd_state_cur()
+{
+    return (rvk_record_slot) ? &rvk_record_slot->cmd_state : &rvk_ctx.cmd_state;
+}
+
+void rvk_cmd_state_invalidate()
+{
+    Rvk_Cmd_State *state = rvk_cmd_state_cur();
+    *state = (Rvk_Cmd_State){.cmd_buff = state->cmd_buff, .stats = state->stats};
+}
+
+/* starts tracking rvk_ctx.cmd_buff from scratch, called when it begins recording */
+static void rvk_cmd_state_begin()
+{
+    rvk_ctx.cmd_state = (Rvk_Cmd_State){.cmd_buff = rvk_ctx.cmd_buff};
+}
+
+Rvk_Cmd_Stats rvk_get_cmd_stats()
+{
+    return rvk_ctx.cmd_stats;
+}
+
+void rvk_log_cmd_stats()
+{
+    rvk_log(RVK_INFO, "command state (issued / skipped) last frame:");
+    for (size_t i = 0; i < RVK_CMD_STATE_COUNT; i++)
+        rvk_log(RVK_INFO, "    %s: %u / %u", rvk_cmd_state_names[i], rvk_ctx.cmd_stats.issued[i], rvk_ctx.cmd_stats.skipped[i]);
+}
+
+/* returns the tracked state when cmd_buff is the one being tracked and counts the call,
+ * other command buffers (batches, secondaries) always record */
+static Rvk_Cmd_State *rvk_cmd_state_check(VkCommandBuffer cmd_buff, Rvk_Cmd_State_Kind kind, bool redundant)
+{
+    Rvk_Cmd_State *state = rvk_cmd_state_cur();
+    if (!cmd_buff || cmd_buff != state->cmd_buff) return NULL;
+    if (redundant) state->stats.skipped[kind]++;
+    else state->stats.issued[kind]++;
+    return state;
+}
+
+static int rvk_cmd_bind_point_idx(VkPipelineBindPoint bind_point)
+{
+    if (bind_point == VK_PIPELINE_BIND_POINT_GRAPHICS) return 0;
+    if (bind_point == VK_PIPELINE_BIND_POINT_COMPUTE)  return 1;
+    return -1;
+}
+
+static void rvk_track_bind_pipeline(VkCommandBuffer cmd_buff, VkPipelineBindPoint bind_point, VkPipeline pl)
+{
+    Rvk_Cmd_State *state = rvk_cmd_state_cur();
+    int bp = rvk_cmd_bind_point_idx(bind_point);
+    bool tracked = bp >= 0 && cmd_buff == state->cmd_buff;
+    bool redundant = tracked && state->pl[bp] == pl;
+    if (!rvk_cmd_state_check(cmd_buff, RVK_CMD_BIND_PIPELINE, redundant) || bp < 0) {
+        vkCmdBindPipeline(cmd_buff, bind_point, pl);
+        return;
+    }
+    if (redundant) return;
+
+    vkCmdBindPipeline(cmd_buff, bind_point, pl);
+    state->pl[bp] = pl;
+    /* a pipeline with static viewport or scissor overwrites the dynamic values */
+    if (bind_point == VK_PIPELINE_BIND_POINT_GRAPHICS) {
+        state->viewport_set = false;
+        state->scissor_set = false;
+    }
+}
+
+static void rvk_track_bind_ds(VkCommandBuffer cmd_buff, VkPipelineBindPoint bind_point, VkPipelineLayout pl_layout,
+                              uint32_t first, uint32_t count, const VkDescriptorSet *sets)
+{
+    Rvk_Cmd_State *state = rvk_cmd_state_cur();
+    int bp = rvk_cmd_bind_point_idx(bind_point);
+    bool trackable = bp >= 0 && cmd_buff == state->cmd_buff && first + count <= RVK_MAX_TRACKED_SETS;
+    bool redundant = trackable && state->ds_layout[bp] == pl_layout;
+    for (uint32_t i = 0; redundant && i < count; i++)
+        redundant = state->ds[bp][first + i] == sets[i];
+    if (!rvk_cmd_state_check(cmd_buff, RVK_CMD_BIND_DESCRIPTOR_SETS, redundant) || !trackable) {
+        vkCmdBindDescriptorSets(cmd_buff, bind_point, pl_layout, first, count, sets, 0, NULL);
+        /* sets beyond what is tracked may have disturbed the tracked ones */
+        if (bp >= 0 && cmd_buff == state->cmd_buff) {
+            state->ds_layout[bp] = VK_NULL_HANDLE;
+            memset(state->ds[bp], 0, sizeof(state->ds[bp]));
+        }
+        return;
+    }
+    if (redundant) return;
+
+    vkCmdBindDescriptorSets(cmd_buff, bind_point, pl_layout, first, count, sets, 0, NULL);
+    /* sets bound with another layout are no longer known to be valid */
+    if (state->ds_layout[bp] != pl_layout) memset(state->ds[bp], 0, sizeof(state->ds[bp]));
+    state->ds_layout[bp] = pl_layout;
+    for (uint32_t i = 0; i < count; i++)
+        state->ds[bp][first + i] = sets[i];
+}
+
+static void rvk_track_bind_vtx_buff(VkCommandBuffer cmd_buff, VkBuffer buff)
+{
+    Rvk_Cmd_State *curr = rvk_cmd_state_cur();
+    bool redundant = cmd_buff == curr->cmd_buff && curr->vtx_buff == buff;
+    Rvk_Cmd_State *state = rvk_cmd_state_check(cmd_buff, RVK_CMD_BIND_VERTEX_BUFFER, redundant);
+    if (redundant) return;
+
+    VkDeviceSize offsets[] = {0};
+    vkCmdBindVertexBuffers(cmd_buff, 0, 1, &buff, offsets);
+    if (state) state->vtx_buff = buff;
+}
+
+static void rvk_track_bind_idx_buff(VkCommandBuffer cmd_buff, VkBuffer buff, VkIndexType type)
+{
+    Rvk_Cmd_State *curr = rvk_cmd_state_cur();
+    bool redundant = cmd_buff == curr->cmd_buff && curr->idx_buff == buff && curr->idx_type == type;
+    Rvk_Cmd_State *state = rvk_cmd_state_check(cmd_buff, RVK_CMD_BIND_INDEX_BUFFER, redundant);
+    if (redundant) return;
+
+    vkCmdBindIndexBuffer(cmd_buff, buff, 0, type);
+    if (state) {
+        state->idx_buff = buff;
+        state->idx_type = type;
+    }
+}
+
+static void rvk_track_set_viewport(VkCommandBuffer cmd_buff, VkViewport viewport)
+{
+    Rvk_Cmd_State *curr = rvk_cmd_state_cur();
+    bool redundant = cmd_buff == curr->cmd_buff && curr->viewport_set &&
+                     !memcmp(&curr->viewport, &viewport, sizeof(viewport));
+    Rvk_Cmd_State *state = rvk_cmd_state_check(cmd_buff, RVK_CMD_SET_VIEWPORT, redundant);
+    if (redundant) return;
+
+    vkCmdSetViewport(cmd_buff, 0, 1, &viewport);
+    if (state) {
+        state->viewport = viewport;
+        state->viewport_set = true;
+    }
+}
+
+static void rvk_track_set_scissor(VkCommandBuffer cmd_buff, VkRect2D scissor)
+{
+    Rvk_Cmd_State *curr = rvk_cmd_state_cur();
+    bool redundant = cmd_buff == curr->cmd_buff && curr->scissor_set &&
+                     !memcmp(&curr->scissor, &scissor, sizeof(scissor));
+    Rvk_Cmd_State *state = rvk_cmd_state_check(cmd_buff, RVK_CMD_SET_SCISSOR, redundant);
+    if (redundant) return;
+
+    vkCmdSetScissor(cmd_buff, 0, 1, &scissor);
+    if (state) {
+        state->scissor = scissor;
+        state->scissor_set = true;
+    }
+}
+
+static void rvk_track_push_const(VkCommandBuffer cmd_buff, VkPipelineLayout pl_layout, VkShaderStageFlags flags,
+                                 uint32_t size, const void *value)
+{
+    Rvk_Cmd_State *curr = rvk_cmd_state_cur();
+    bool redundant = cmd_buff == curr->cmd_buff && curr->push_layout == pl_layout &&
+                     curr->push_stages == flags && curr->push_size == size && !memcmp(curr->push_data, value, size);
+    Rvk_Cmd_State *state = rvk_cmd_state_check(cmd_buff, RVK_CMD_PUSH_CONSTANTS, redundant);
+    if (redundant) return;
+
+    vkCmdPushConstants(cmd_buff, pl_layout, flags, 0, size, value);
+    if (state) {
+        bool fits = size <= RVK_MAX_PUSH_CONST_SIZE;
+        state->push_layout = (fits) ? pl_layout : VK_NULL_HANDLE;
+        state->push_stages = flags;
+        state->push_size = (fits) ? size : 0;
+        if (fits) memcpy(state->push_data, value, size);
+    }
+}
+
+static void rvk_track_viewport_scissor(VkCommandBuffer cmd_buff, VkExtent2D extent)
+{
+    VkViewport viewport = {
+        .width    = (float)extent.width,
+        .height   = (float)extent.height,
+        .maxDepth = 1.0f,
+    };
+    rvk_track_set_viewport(cmd_buff, viewport);
+    VkRect2D scissor = {.extent = extent};
+    rvk_track_set_scissor(cmd_buff, scissor);
 }
 
 void rvk_draw(VkPipeline pl, VkPipelineLayout pl_layout, Rvk_Buffer vtx_buff, Rvk_Buffer idx_buff, void *float16_mvp)
 {
     RVK_ASSERT(0 && "rvk_draw deprecated");
 
-    VkCommandBuffer cmd_buffer = rvk_ctx.cmd_buff;
+    VkCommandBuffer cmd_buffer = rvk_get_cmd_buff();
     vkCmdBindPipeline(cmd_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pl);
     VkViewport viewport = {
         .width = (float)rvk_ctx.extent.width,
@@ -1868,92 +4259,111 @@ void rvk_draw(VkPipeline pl, VkPipelineLayout pl_layout, Rvk_Buffer vtx_buff, Rv
 
 void rvk_bind_gfx(VkPipeline pl, VkPipelineLayout pl_layout, VkDescriptorSet *ds, size_t ds_count)
 {
-    VkCommandBuffer cmd_buff = rvk_ctx.cmd_buff;
-
-    vkCmdBindPipeline(cmd_buff, VK_PIPELINE_BIND_POINT_GRAPHICS, pl);
-    VkViewport viewport = {
-        .width    = rvk_ctx.extent.width,
-        .height   = rvk_ctx.extent.height,
-        .maxDepth = 1.0f,
-    };
-    vkCmdSetViewport(cmd_buff, 0, 1, &viewport);
-    VkRect2D scissor = {0};
-    scissor.extent = rvk_ctx.extent;
-    vkCmdSetScissor(cmd_buff, 0, 1, &scissor);
-
-    /* bind descriptor sets */
-    for (size_t i = 0; i < ds_count; i++)
-        vkCmdBindDescriptorSets(cmd_buff, VK_PIPELINE_BIND_POINT_GRAPHICS, pl_layout, i, 1, &ds[i], 0, NULL);
+    rvk_bind_gfx_extent(pl, pl_layout, ds, ds_count, rvk_ctx.extent);
 }
 
 void rvk_bind_gfx_extent(VkPipeline pl, VkPipelineLayout pl_layout, VkDescriptorSet *ds, size_t ds_count, VkExtent2D extent)
 {
-    VkCommandBuffer cmd_buff = rvk_ctx.cmd_buff;
+    VkCommandBuffer cmd_buff = rvk_get_cmd_buff();
+    if (!cmd_buff) return;
 
-    vkCmdBindPipeline(cmd_buff, VK_PIPELINE_BIND_POINT_GRAPHICS, pl);
-    VkViewport viewport = {
-        .width    = extent.width,
-        .height   = extent.height,
-        .maxDepth = 1.0f,
-    };
-    vkCmdSetViewport(cmd_buff, 0, 1, &viewport);
-    VkRect2D scissor = {0};
-    scissor.extent = extent;
-    vkCmdSetScissor(cmd_buff, 0, 1, &scissor);
+    rvk_track_bind_pipeline(cmd_buff, VK_PIPELINE_BIND_POINT_GRAPHICS, pl);
+    rvk_track_viewport_scissor(cmd_buff, extent);
 
     /* bind descriptor sets */
-    for (size_t i = 0; i < ds_count; i++)
-        vkCmdBindDescriptorSets(cmd_buff, VK_PIPELINE_BIND_POINT_GRAPHICS, pl_layout, i, 1, &ds[i], 0, NULL);
+    if (ds_count) rvk_track_bind_ds(cmd_buff, VK_PIPELINE_BIND_POINT_GRAPHICS, pl_layout, 0, ds_count, ds);
 }
 
 void rvk_draw_buffers(Rvk_Buffer vtx_buff, Rvk_Buffer idx_buff)
 {
-    VkCommandBuffer cmd_buff = rvk_ctx.cmd_buff;
-    VkDeviceSize offsets[] = {0};
-    vkCmdBindVertexBuffers(cmd_buff, 0, 1, &vtx_buff.handle, offsets);
-    vkCmdBindIndexBuffer(cmd_buff, idx_buff.handle, 0, VK_INDEX_TYPE_UINT16);
-    vkCmdDrawIndexed(cmd_buff, idx_buff.count, 1, 0, 0, 0);
+    rvk_draw_buffers_range(vtx_buff, idx_buff, (Rvk_Draw_Range){.idx_count = idx_buff.count});
+}
+
+void rvk_draw_buffers_range(Rvk_Buffer vtx_buff, Rvk_Buffer idx_buff, Rvk_Draw_Range range)
+{
+    /* meshes sharing the buffers only cost a draw, the binds are skipped by the tracker */
+    VkCommandBuffer cmd_buff = rvk_get_cmd_buff();
+    if (!cmd_buff) return;
+    rvk_track_bind_vtx_buff(cmd_buff, vtx_buff.handle);
+    rvk_track_bind_idx_buff(cmd_buff, idx_buff.handle, VK_INDEX_TYPE_UINT16);
+    vkCmdDrawIndexed(cmd_buff, range.idx_count, 1, range.first_idx, range.vtx_offset, 0);
+}
+
+void rvk_draw_buffers_instanced(Rvk_Buffer vtx_buff, Rvk_Buffer idx_buff, Rvk_Draw_Range range, Rvk_Buffer inst_buff, VkDeviceSize inst_offset, uint32_t instance_count)
+{
+    VkCommandBuffer cmd_buff = rvk_get_cmd_buff();
+    if (!cmd_buff) return;
+    rvk_track_bind_vtx_buff(cmd_buff, vtx_buff.handle);
+    vkCmdBindVertexBuffers(cmd_buff, 1, 1, &inst_buff.handle, &inst_offset);
+    rvk_track_bind_idx_buff(cmd_buff, idx_buff.handle, VK_INDEX_TYPE_UINT16);
+    vkCmdDrawIndexed(cmd_buff, range.idx_count, instance_count, range.first_idx, range.vtx_offset, 0);
+}
+
+void rvk_draw_indexed_indirect_count(Rvk_Buffer vtx_buff, Rvk_Buffer idx_buff, Rvk_Buffer cmds, VkDeviceSize cmd_offset,
+                                     Rvk_Buffer count_buff, VkDeviceSize count_offset, uint32_t max_draws)
+{
+    VkCommandBuffer cmd_buff = rvk_get_cmd_buff();
+    if (!cmd_buff) return;
+    rvk_track_bind_vtx_buff(cmd_buff, vtx_buff.handle);
+    rvk_track_bind_idx_buff(cmd_buff, idx_buff.handle, VK_INDEX_TYPE_UINT16);
+#ifndef PLATFORM_ANDROID_QUEST
+    if (rvk_ctx.features.draw_indirect_count) {
+        vkCmdDrawIndexedIndirectCount(cmd_buff, cmds.handle, cmd_offset, count_buff.handle, count_offset,
+                                      max_draws, sizeof(VkDrawIndexedIndirectCommand));
+        return;
+    }
+#else
+    (void)count_buff;
+    (void)count_offset;
+#endif
+    if (!rvk_ctx.features.multi_draw_indirect) {
+        for (uint32_t i = 0; i < max_draws; i++)
+            vkCmdDrawIndexedIndirect(cmd_buff, cmds.handle, cmd_offset + i*sizeof(VkDrawIndexedIndirectCommand), 1, 0);
+        return;
+    }
+    vkCmdDrawIndexedIndirect(cmd_buff, cmds.handle, cmd_offset, max_draws, sizeof(VkDrawIndexedIndirectCommand));
 }
 
 void rvk_bind_vertex_buffers(Rvk_Buffer vtx_buff)
 {
-    VkCommandBuffer cmd_buff = rvk_ctx.cmd_buff;
-    VkDeviceSize offsets[] = {0};
-    vkCmdBindVertexBuffers(cmd_buff, 0, 1, &vtx_buff.handle, offsets);
+    VkCommandBuffer cmd_buff = rvk_get_cmd_buff();
+    if (cmd_buff) rvk_track_bind_vtx_buff(cmd_buff, vtx_buff.handle);
 }
 
 void rvk_dispatch(VkPipeline pl, VkPipelineLayout pl_layout, VkDescriptorSet ds, size_t x, size_t y, size_t z)
 {
-    vkCmdBindPipeline(rvk_ctx.cmd_buff, VK_PIPELINE_BIND_POINT_COMPUTE, pl);
-    vkCmdBindDescriptorSets(rvk_ctx.cmd_buff, VK_PIPELINE_BIND_POINT_COMPUTE, pl_layout, 0, 1, &ds, 0, NULL);
+    rvk_track_bind_pipeline(rvk_ctx.cmd_buff, VK_PIPELINE_BIND_POINT_COMPUTE, pl);
+    rvk_track_bind_ds(rvk_ctx.cmd_buff, VK_PIPELINE_BIND_POINT_COMPUTE, pl_layout, 0, 1, &ds);
     vkCmdDispatch(rvk_ctx.cmd_buff, x, y, z);
 }
 
 void rvk_push_const(VkPipelineLayout pl_layout, VkShaderStageFlags flags, uint32_t size, void *value)
 {
-    VkCommandBuffer cmd_buff = rvk_ctx.cmd_buff;
-    vkCmdPushConstants(cmd_buff, pl_layout, flags, 0, size, value);
+    VkCommandBuffer cmd_buff = rvk_get_cmd_buff();
+    if (cmd_buff) rvk_track_push_const(cmd_buff, pl_layout, flags, size, value);
 }
 
 void rvk_draw_sst(VkPipeline pl, VkPipelineLayout pl_layout, VkDescriptorSet ds)
 {
-    vkCmdBindPipeline(rvk_ctx.cmd_buff, VK_PIPELINE_BIND_POINT_GRAPHICS, pl);
-    vkCmdBindDescriptorSets(rvk_ctx.cmd_buff, VK_PIPELINE_BIND_POINT_GRAPHICS, pl_layout, 0, 1, &ds, 0, NULL);
-
-    VkViewport viewport = {
-        .width = (float)rvk_ctx.extent.width,
-        .height =(float)rvk_ctx.extent.height,
-        .maxDepth = 1.0f,
-    };
-    vkCmdSetViewport(rvk_ctx.cmd_buff, 0, 1, &viewport);
-    VkRect2D scissor = { .extent = rvk_ctx.extent, };
-    vkCmdSetScissor(rvk_ctx.cmd_buff, 0, 1, &scissor);
-    vkCmdDraw(rvk_ctx.cmd_buff, 3, 1, 0, 0);
+    VkCommandBuffer cmd_buff = rvk_get_cmd_buff();
+    if (!cmd_buff) return;
+    rvk_track_bind_pipeline(cmd_buff, VK_PIPELINE_BIND_POINT_GRAPHICS, pl);
+    rvk_track_bind_ds(cmd_buff, VK_PIPELINE_BIND_POINT_GRAPHICS, pl_layout, 0, 1, &ds);
+    rvk_track_viewport_scissor(cmd_buff, rvk_ctx.extent);
+    vkCmdDraw(cmd_buff, 3, 1, 0, 0);
 }
 
-#ifdef PLATFORM_DESKTOP_GLFW
 void rvk_compute_pl_barrier()
 {
+#if defined(PLATFORM_DESKTOP_GLFW) || defined(PLATFORM_HEADLESS)
+    if (!rvk_ctx.features.synchronization2) {
+        rvk_mem_barrier(
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT
+        );
+        return;
+    }
+
     VkMemoryBarrier2KHR barrier = {
         .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
         .srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT_KHR,
@@ -1968,39 +4378,68 @@ void rvk_compute_pl_barrier()
         .pMemoryBarriers = &barrier,
     };
     vkCmdPipelineBarrier2(rvk_ctx.cmd_buff, &dependency);
+#else
+    rvk_mem_barrier(
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT
+    );
+#endif // PLATFORM_DESKTOP_GLFW || PLATFORM_HEADLESS
 }
-#endif // PLATFORM_DESKTOP_GLFW
 
-void rvk_draw_points(Rvk_Buffer vtx_buff, void *float16_mvp, VkPipeline pl, VkPipelineLayout pl_layout, VkDescriptorSet *ds_sets, size_t ds_set_count)
+void rvk_frame_compute_barrier()
 {
-    VkCommandBuffer cmd_buffer = rvk_ctx.cmd_buff;
-    vkCmdBindPipeline(cmd_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pl);
-    VkViewport viewport = {
-        .width = (float)rvk_ctx.extent.width,
-        .height =(float)rvk_ctx.extent.height,
-        .maxDepth = 1.0f,
+    VkMemoryBarrier barrier = {
+        .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+        .srcAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+        .dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
     };
-    vkCmdSetViewport(cmd_buffer, 0, 1, &viewport);
-    VkRect2D scissor = {.extent = rvk_ctx.extent};
-    vkCmdSetScissor(cmd_buffer, 0, 1, &scissor);
-    VkDeviceSize offsets[] = {0};
-    vkCmdBindVertexBuffers(cmd_buffer, 0, 1, &vtx_buff.handle, offsets);
+    vkCmdPipelineBarrier(
+        rvk_ctx.cmd_buff,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        0, 1, &barrier, 0, NULL, 0, NULL
+    );
+}
 
-    for (size_t i = 0; i < ds_set_count; i++) {
-        vkCmdBindDescriptorSets(
-            cmd_buffer,
-            VK_PIPELINE_BIND_POINT_GRAPHICS,
-            pl_layout, i, 1, &ds_sets[i], 0, NULL
-        );
-    }
+void rvk_mem_barrier(VkPipelineStageFlags src_stage, VkAccessFlags src_access, VkPipelineStageFlags dst_stage, VkAccessFlags dst_access)
+{
+    VkMemoryBarrier barrier = {
+        .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+        .srcAccessMask = src_access,
+        .dstAccessMask = dst_access,
+    };
+    vkCmdPipelineBarrier(rvk_ctx.cmd_buff, src_stage, dst_stage, 0, 1, &barrier, 0, NULL, 0, NULL);
+}
 
-    vkCmdPushConstants(cmd_buffer, pl_layout, VK_SHADER_STAGE_VERTEX_BIT, 0, 64, float16_mvp);
+void rvk_draw_points(Rvk_Buffer vtx_buff, void *float16_mvp, VkPipeline pl, VkPipelineLayout pl_layout, VkDescriptorSet *ds_sets, size_t ds_set_count)
+{
+    VkCommandBuffer cmd_buffer = rvk_get_cmd_buff();
+    if (!cmd_buffer) return;
+    rvk_track_bind_pipeline(cmd_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pl);
+    rvk_track_viewport_scissor(cmd_buffer, rvk_ctx.extent);
+    rvk_track_bind_vtx_buff(cmd_buffer, vtx_buff.handle);
+    if (ds_set_count) rvk_track_bind_ds(cmd_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pl_layout, 0, ds_set_count, ds_sets);
+    rvk_track_push_const(cmd_buffer, pl_layout, VK_SHADER_STAGE_VERTEX_BIT, 64, float16_mvp);
     vkCmdDraw(cmd_buffer, vtx_buff.count, 1, 0, 0);
 }
 
 void rvk_wait_to_begin_gfx()
 {
     RAG_VK(vkWaitForFences(rvk_ctx.device, 1, &rvk_ctx.fence, VK_TRUE, UINT64_MAX));
+    rvk_stg_ring_retire();
+    rvk_timeline_retire();
+    rvk_transfer_acquire_completed();
+    rvk_bindless_retire(rvk_ctx.frame_idx);
+    rvk_descriptor_pool_arena_reset(rvk_frame_ds_arena());
+    rvk_record_slots_reset();
+
+#ifdef PLATFORM_HEADLESS
+    /* each frame in flight owns its render target */
+    rvk_img_idx = rvk_ctx.frame_idx;
+    RAG_VK(vkResetFences(rvk_ctx.device, 1, &rvk_ctx.fence));
+    RAG_VK(vkResetCommandBuffer(rvk_ctx.cmd_buff, 0));
+    return;
+#endif
 
     VkResult res = vkAcquireNextImageKHR(
         rvk_ctx.device, rvk_ctx.swapchain.handle, UINT64_MAX,
@@ -2022,6 +4461,11 @@ void rvk_wait_to_begin_gfx()
 void rvk_wait_reset()
 {
     RAG_VK(vkWaitForFences(rvk_ctx.device, 1, &rvk_ctx.fence, VK_TRUE, UINT64_MAX));
+    rvk_stg_ring_retire();
+    rvk_timeline_retire();
+    rvk_bindless_retire(rvk_ctx.frame_idx);
+    rvk_descriptor_pool_arena_reset(rvk_frame_ds_arena());
+    rvk_record_slots_reset();
     RAG_VK(vkResetFences(rvk_ctx.device, 1, &rvk_ctx.fence));
     RAG_VK(vkResetCommandBuffer(rvk_ctx.cmd_buff, 0));
 }
@@ -2029,6 +4473,7 @@ void rvk_wait_reset()
 void rvk_wait_for_fences(VkFence *fences, uint32_t fence_count)
 {
     RAG_VK(vkWaitForFences(rvk_ctx.device, fence_count, fences, VK_TRUE, UINT64_MAX));
+    rvk_stg_ring_retire();
 }
 
 void rvk_reset_fences(VkFence *fences, uint32_t fence_count)
@@ -2045,21 +4490,83 @@ void rvk_begin_command_buffer(VkCommandBuffer cmd_buff)
 {
     VkCommandBufferBeginInfo begin_info = { .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO, };
     RAG_VK(vkBeginCommandBuffer(cmd_buff, &begin_info));
+    if (cmd_buff == rvk_ctx.cmd_buff) rvk_cmd_state_begin();
 }
 
 void rvk_begin_rec_gfx()
 {
     VkCommandBufferBeginInfo begin_info = { .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO, };
     RAG_VK(vkBeginCommandBuffer(rvk_ctx.cmd_buff, &begin_info));
+    rvk_cmd_state_begin();
+}
+
+void rvk_begin_rec_compute()
+{
+    if (rvk_ctx.compute.recording) {
+        rvk_log(RVK_ERROR, "compute is already recording, submit it before beginning again");
+        RVK_EXIT_APP;
+    }
+
+    /* the frame's fence usually covers this, unless compute went out without graphics */
+    Rvk_Frame *frame = &rvk_ctx.frames[rvk_ctx.frame_idx];
+    rvk_timeline_wait(&rvk_ctx.compute.timeline, frame->compute_value);
+    RAG_VK(vkResetCommandBuffer(frame->compute_cmd_buff, 0));
+    VkCommandBufferBeginInfo begin_info = {
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+        .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+    };
+    RAG_VK(vkBeginCommandBuffer(frame->compute_cmd_buff, &begin_info));
+
+    rvk_ctx.compute.recording = true;
+    rvk_ctx.compute.gfx_cmd_buff = rvk_ctx.cmd_buff;
+    rvk_ctx.compute.gfx_cmd_state = rvk_ctx.cmd_state;
+    rvk_ctx.cmd_buff = frame->compute_cmd_buff;
+    rvk_cmd_state_begin();
+}
+
+uint64_t rvk_submit_compute(uint64_t wait_gfx_value)
+{
+    if (!rvk_ctx.compute.recording) {
+        rvk_log(RVK_ERROR, "compute submitted, but it was never begun");
+        RVK_EXIT_APP;
+    }
+
+    VkCommandBuffer cmd_buff = rvk_ctx.cmd_buff;
+    RAG_VK(vkEndCommandBuffer(cmd_buff));
+    rvk_ctx.cmd_buff = rvk_ctx.compute.gfx_cmd_buff;
+    rvk_ctx.cmd_state = rvk_ctx.compute.gfx_cmd_state;
+    rvk_ctx.compute.recording = false;
+
+    VkPipelineStageFlags wait_stage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+    VkSubmitInfo submit = {
+        .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+        .waitSemaphoreCount = (wait_gfx_value) ? 1 : 0,
+        .pWaitSemaphores = &rvk_ctx.timeline.sem,
+        .pWaitDstStageMask = &wait_stage,
+        .commandBufferCount = 1,
+        .pCommandBuffers = &cmd_buff,
+    };
+    uint64_t value = rvk_timeline_submit(&rvk_ctx.compute.timeline, rvk_ctx.compute.queue, submit, VK_NULL_HANDLE, &wait_gfx_value);
+
+    rvk_ctx.frames[rvk_ctx.frame_idx].compute_value = value;
+    rvk_ctx.compute.pending = value;
+    return value;
+}
+
+uint64_t rvk_frame_gfx_value()
+{
+    return rvk_ctx.frames[rvk_ctx.frame_idx].gfx_value;
 }
 
 void rvk_recreate_swapchain()
 {
-#ifdef PLATFORM_DESKTOP_GLFW
+#if defined(PLATFORM_DESKTOP_GLFW)
     rvk_glfw_wait_resize_frame_buffer();
+#elif defined(PLATFORM_HEADLESS)
+    /* offscreen images are recreated at rvk_ctx.extent */
 #else
     rvk_log(RVK_ERROR, "rvk_recreate_swapchain currently only supports PLATFORM_DESKTOP_GLFW");
-    RVK_APP_FAIL;
+    RVK_EXIT_APP;
 #endif
 
     vkDeviceWaitIdle(rvk_ctx.device);
@@ -2067,7 +4574,7 @@ void rvk_recreate_swapchain()
     rvk_swapchain_init();
     rvk_img_views_init();
     rvk_depth_init();
-    rvk_frame_buffs_init();
+    if (!rvk_ctx.features.dynamic_rendering) rvk_frame_buffs_init();
 }
 
 void rvk_depth_init()
@@ -2119,14 +4626,76 @@ Rvk_Buffer rvk_create_mapped_uniform_buff(size_t size, void *data)
     return uniform_buff;
 }
 
+Rvk_Buffer rvk_create_mapped_vertex_buff(size_t size, size_t count)
+{
+    Rvk_Buffer vtx_buff = {0};
+    rvk_buff_init(
+        size,
+        count,
+        VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+        RVK_BUFFER_TYPE_VERTEX,
+        NULL,
+        &vtx_buff
+    );
+    rvk_buff_map(&vtx_buff);
+    return vtx_buff;
+}
+
+Rvk_Buffer rvk_create_indirect_buff(size_t size, size_t count)
+{
+    Rvk_Buffer buff = {0};
+    rvk_buff_init(
+        size,
+        count,
+        VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT  |
+        VK_BUFFER_USAGE_TRANSFER_DST_BIT,    // cleared with vkCmdFillBuffer
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        RVK_BUFFER_TYPE_INDIRECT,
+        NULL,
+        &buff
+    );
+    return buff;
+}
+
+Rvk_Frame_Buffer rvk_create_mapped_uniform_frame_buff(size_t size, void *data)
+{
+    Rvk_Frame_Buffer frame_buff = {.count = rvk_get_frames_in_flight()};
+    for (uint32_t i = 0; i < frame_buff.count; i++)
+        frame_buff.buffs[i] = rvk_create_mapped_uniform_buff(size, data);
+    return frame_buff;
+}
+
+Rvk_Buffer *rvk_frame_buff_get(Rvk_Frame_Buffer *frame_buff)
+{
+    RVK_ASSERT(rvk_ctx.frame_idx < frame_buff->count);
+    return &frame_buff->buffs[rvk_ctx.frame_idx];
+}
+
+void rvk_destroy_frame_buffer(Rvk_Frame_Buffer frame_buff)
+{
+    for (uint32_t i = 0; i < frame_buff.count; i++)
+        rvk_buff_destroy(frame_buff.buffs[i]);
+}
+
 bool rvk_is_device_suitable(VkPhysicalDevice phys_device)
 {
+#ifdef PLATFORM_HEADLESS
+    /* nothing to present to, any graphics queue will do */
+    if (!rvk_set_gfx_capable_queue_idx(phys_device)) return false;
+#else
     if (!rvk_has_unified_gfx_and_present_queue(phys_device)) return false;
+#endif
 
     VkPhysicalDeviceProperties props = {0};
     VkPhysicalDeviceFeatures features = {0};
     vkGetPhysicalDeviceProperties(phys_device, &props);
     vkGetPhysicalDeviceFeatures(phys_device, &features);
+#ifdef PLATFORM_HEADLESS
+    /* software rasterizers (i.e. lavapipe) are fine when there is no display */
+    if (props.deviceType == VK_PHYSICAL_DEVICE_TYPE_CPU) return features.geometryShader;
+#endif
     if (props.deviceType != VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU &&
         props.deviceType != VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU) {
         rvk_log(RVK_ERROR, "device not suitable, neither discrete nor integrated GPU present");
@@ -2136,8 +4705,10 @@ bool rvk_is_device_suitable(VkPhysicalDevice phys_device)
         rvk_log(RVK_ERROR, "device not suitable, geometry shader not present");
         return false;
     }
+#ifndef PLATFORM_HEADLESS
     if (!rvk_device_exts_supported(phys_device)) return false;
     if (!rvk_swapchain_adequate(phys_device))    return false;
+#endif
 
     return true;
 }
@@ -2321,7 +4892,11 @@ void rvk_pick_phys_device()
     for (size_t i = 0; i < device_count; i++) {
         if (rvk_is_device_suitable(phys_devices[i])) {
             rvk_ctx.phys_device = phys_devices[i];
+#ifndef PLATFORM_HEADLESS
             rvk_ctx.queue_idx = rvk_get_unified_gfx_and_present_queue_idx(rvk_ctx.phys_device);
+#endif
+            rvk_transfer_queue_pick(rvk_ctx.phys_device);
+            rvk_compute_queue_pick(rvk_ctx.phys_device);
             return;
         }
     }
@@ -2393,7 +4968,7 @@ VkExtent2D rvk_choose_swp_extent()
     if (capabilities.currentExtent.width != UINT32_MAX) {
         return capabilities.currentExtent;
     } else {
-        int width, height;
+        int width = rvk_ctx.extent.width, height = rvk_ctx.extent.height;
 #ifdef PLATFORM_DESKTOP_GLFW
         glfwGetFramebufferSize(rvk_glfw_window, &width, &height);
 #endif
@@ -2406,38 +4981,286 @@ VkExtent2D rvk_choose_swp_extent()
         extent.width = clamp(extent.width, capabilities.minImageExtent.width, capabilities.maxImageExtent.width);
         extent.height = clamp(extent.height, capabilities.minImageExtent.height, capabilities.maxImageExtent.height);
 
-        return extent;
+        return extent;
+    }
+}
+
+void rvk_destroy_swapchain()
+{
+    vkDestroyImageView(rvk_ctx.device, rvk_ctx.depth_img_view, NULL);
+    rvk_img_destroy(rvk_ctx.depth_img);
+
+    for (size_t i = 0; i < rvk_ctx.swapchain.img_count; i++) {
+        vkDestroyFramebuffer(rvk_ctx.device, rvk_ctx.swapchain.frame_buffs[i], NULL);
+        vkDestroyImageView(rvk_ctx.device, rvk_ctx.swapchain.img_views[i], NULL);
+    }
+#ifdef PLATFORM_HEADLESS
+    rvk_headless_imgs_destroy();
+#else
+    vkDestroySwapchainKHR(rvk_ctx.device, rvk_ctx.swapchain.handle, NULL);
+#endif
+
+    /* reset image count, otherwise call to vkGetSwapchainImagesKHR will fail as a query */
+    rvk_ctx.swapchain.img_count = 0;
+}
+
+bool rvk_find_mem_type_idx(uint32_t type, VkMemoryPropertyFlags properties, uint32_t *idx)
+{
+    VkPhysicalDeviceMemoryProperties mem_properites = {0};
+    vkGetPhysicalDeviceMemoryProperties(rvk_ctx.phys_device, &mem_properites);
+    for (uint32_t i = 0; i < mem_properites.memoryTypeCount; i++) {
+        if (type & (1 << i) && (mem_properites.memoryTypes[i].propertyFlags & properties) == properties) {
+            *idx = i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static VkDeviceSize rvk_align_up(VkDeviceSize value, VkDeviceSize alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+/* a linear and an optimal resource may only be neighbors if they are on different granularity pages */
+static bool rvk_mem_granularity_conflict(Rvk_Mem_Range lower, VkDeviceSize upper_offset, bool upper_linear)
+{
+    if (lower.linear == upper_linear) return false;
+    VkDeviceSize page = rvk_ctx.mem_allocator.granularity;
+    VkDeviceSize lower_last = lower.offset + lower.size - 1;
+    return (lower_last / page) == (upper_offset / page);
+}
+
+/* first fit inside a single block, returns false if there is no gap large enough */
+static bool rvk_mem_block_alloc(Rvk_Mem_Block *block, VkDeviceSize size, VkDeviceSize alignment, bool linear, VkDeviceSize *offset)
+{
+    Rvk_Mem_Ranges *ranges = &block->ranges;
+    if (block->size - block->used < size) return false;
+
+    for (size_t i = 0; i <= ranges->count; i++) {
+        VkDeviceSize gap_start = 0;
+        if (i > 0) {
+            Rvk_Mem_Range prev = ranges->items[i - 1];
+            gap_start = rvk_align_up(prev.offset + prev.size, alignment);
+            if (rvk_mem_granularity_conflict(prev, gap_start, linear))
+                gap_start = rvk_align_up(gap_start, rvk_ctx.mem_allocator.granularity);
+        }
+        VkDeviceSize gap_end = (i < ranges->count) ? ranges->items[i].offset : block->size;
+        if (gap_start + size > gap_end) continue;
+
+        Rvk_Mem_Range range = {.offset = gap_start, .size = size, .linear = linear};
+        if (i < ranges->count && rvk_mem_granularity_conflict(range, ranges->items[i].offset, ranges->items[i].linear))
+            continue;
+
+        /* insert while keeping the ranges sorted */
+        rvk_da_append(ranges, range);
+        memmove(ranges->items + i + 1, ranges->items + i, (ranges->count - 1 - i)*sizeof(*ranges->items));
+        ranges->items[i] = range;
+        block->used += size;
+        *offset = gap_start;
+        return true;
+    }
+
+    return false;
+}
+
+static Rvk_Mem_Block *rvk_mem_block_create(uint32_t mem_type_idx, VkDeviceSize size)
+{
+    /* a block can hold any buffer, so with buffer device address every block allows it */
+    VkMemoryAllocateFlagsInfo flags_info = {
+        .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO,
+        .flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT,
+    };
+    VkMemoryAllocateInfo alloc_ci = {
+        .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+        .pNext = (rvk_ctx.features.buffer_device_address) ? &flags_info : NULL,
+        .allocationSize = size,
+        .memoryTypeIndex = mem_type_idx,
+    };
+    VkDeviceMemory mem;
+    RAG_VK(vkAllocateMemory(rvk_ctx.device, &alloc_ci, NULL, &mem));
+
+    Rvk_Mem_Block *block = RVK_REALLOC(NULL, sizeof(Rvk_Mem_Block));
+    RVK_ASSERT(block != NULL && "\"Buy more RAM lol\"\n\t\t-Tsoding");
+    *block = (Rvk_Mem_Block) {
+        .mem = mem,
+        .size = size,
+        .mem_type_idx = mem_type_idx,
+    };
+    rvk_da_append(&rvk_ctx.mem_allocator.blocks[mem_type_idx], block);
+    return block;
+}
+
+Rvk_Allocation rvk_mem_alloc(VkMemoryRequirements mem_reqs, VkMemoryPropertyFlags properties, bool linear)
+{
+    Rvk_Mem_Allocator *allocator = &rvk_ctx.mem_allocator;
+    VkPhysicalDeviceMemoryProperties mem_props = {0};
+    vkGetPhysicalDeviceMemoryProperties(rvk_ctx.phys_device, &mem_props);
+    if (!allocator->granularity) {
+        VkPhysicalDeviceProperties props = {0};
+        vkGetPhysicalDeviceProperties(rvk_ctx.phys_device, &props);
+        allocator->granularity = props.limits.bufferImageGranularity;
+        if (!allocator->granularity) allocator->granularity = 1;
+    }
+
+    uint32_t mem_type_idx;
+    if (!rvk_find_mem_type_idx(mem_reqs.memoryTypeBits, properties, &mem_type_idx)) {
+        rvk_log(RVK_ERROR, "Memory not suitable based on memory requirements");
+        RVK_EXIT_APP;
+    }
+
+    /* first fit over the existing blocks of this memory type */
+    Rvk_Allocation alloc = {.size = mem_reqs.size};
+    Rvk_Mem_Blocks *blocks = &allocator->blocks[mem_type_idx];
+    for (size_t i = 0; i < blocks->count; i++) {
+        if (rvk_mem_block_alloc(blocks->items[i], mem_reqs.size, mem_reqs.alignment, linear, &alloc.offset)) {
+            alloc.block = blocks->items[i];
+            return alloc;
+        }
+    }
+
+    /* small heaps get smaller blocks, anything bigger than a block gets a block of its own */
+    VkDeviceSize heap_size = mem_props.memoryHeaps[mem_props.memoryTypes[mem_type_idx].heapIndex].size;
+    VkDeviceSize block_size = RVK_MEM_BLOCK_SIZE;
+    if (heap_size < 1024ull*1024*1024 && heap_size / 8 < block_size) block_size = heap_size / 8;
+    if (block_size < mem_reqs.size) block_size = mem_reqs.size;
+
+    alloc.block = rvk_mem_block_create(mem_type_idx, block_size);
+    if (!rvk_mem_block_alloc(alloc.block, mem_reqs.size, mem_reqs.alignment, linear, &alloc.offset)) {
+        rvk_log(RVK_ERROR, "allocation of %zu bytes did not fit in a fresh memory block", (size_t)mem_reqs.size);
+        RVK_EXIT_APP;
+    }
+    return alloc;
+}
+
+static Rvk_Mem_Range *rvk_mem_find_range(Rvk_Allocation alloc)
+{
+    Rvk_Mem_Ranges *ranges = &alloc.block->ranges;
+    size_t lo = 0, hi = ranges->count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo)/2;
+        if (ranges->items[mid].offset < alloc.offset) lo = mid + 1;
+        else hi = mid;
+    }
+    if (lo == ranges->count || ranges->items[lo].offset != alloc.offset) {
+        rvk_log(RVK_ERROR, "no allocation at offset %zu in memory block", (size_t)alloc.offset);
+        RVK_EXIT_APP;
+        return NULL;
+    }
+    return &ranges->items[lo];
+}
+
+void rvk_mem_free(Rvk_Allocation alloc)
+{
+    Rvk_Mem_Block *block = alloc.block;
+    if (!block) return;
+
+    Rvk_Mem_Range *range = rvk_mem_find_range(alloc);
+    if (!range) return;
+    if (range->mapped) rvk_mem_unmap(alloc);
+
+    Rvk_Mem_Ranges *ranges = &block->ranges;
+    size_t i = range - ranges->items;
+    block->used -= range->size;
+    memmove(ranges->items + i, ranges->items + i + 1, (ranges->count - 1 - i)*sizeof(*ranges->items));
+    ranges->count--;
+    if (ranges->count) return;
+
+    /* keep one empty block per memory type around, give the rest back */
+    Rvk_Mem_Blocks *blocks = &rvk_ctx.mem_allocator.blocks[block->mem_type_idx];
+    if (blocks->count == 1) return;
+    for (size_t j = 0; j < blocks->count; j++) {
+        if (blocks->items[j] != block) continue;
+        blocks->items[j] = blocks->items[--blocks->count];
+        break;
     }
+    if (block->mapped) vkUnmapMemory(rvk_ctx.device, block->mem);
+    vkFreeMemory(rvk_ctx.device, block->mem, NULL);
+    rvk_da_free(block->ranges);
+    RVK_FREE(block);
+}
+
+void *rvk_mem_map(Rvk_Allocation alloc)
+{
+    /* a VkDeviceMemory can only be mapped once, so the whole block is mapped and shared */
+    Rvk_Mem_Block *block = alloc.block;
+    Rvk_Mem_Range *range = rvk_mem_find_range(alloc);
+    if (!range->mapped) {
+        if (!block->map_count)
+            RAG_VK(vkMapMemory(rvk_ctx.device, block->mem, 0, VK_WHOLE_SIZE, 0, &block->mapped));
+        block->map_count++;
+        range->mapped = true;
+    }
+    return (uint8_t *)block->mapped + alloc.offset;
 }
 
-void rvk_destroy_swapchain()
+void rvk_mem_unmap(Rvk_Allocation alloc)
 {
-    vkDestroyImageView(rvk_ctx.device, rvk_ctx.depth_img_view, NULL);
-    vkDestroyImage(rvk_ctx.device, rvk_ctx.depth_img.handle, NULL);
-    vkFreeMemory(rvk_ctx.device, rvk_ctx.depth_img.mem, NULL);
-
-    for (size_t i = 0; i < rvk_ctx.swapchain.img_count; i++) {
-        vkDestroyFramebuffer(rvk_ctx.device, rvk_ctx.swapchain.frame_buffs[i], NULL);
-        vkDestroyImageView(rvk_ctx.device, rvk_ctx.swapchain.img_views[i], NULL);
+    Rvk_Mem_Block *block = alloc.block;
+    Rvk_Mem_Range *range = rvk_mem_find_range(alloc);
+    if (!range || !range->mapped) return;
+    range->mapped = false;
+    if (--block->map_count == 0) {
+        vkUnmapMemory(rvk_ctx.device, block->mem);
+        block->mapped = NULL;
     }
-    vkDestroySwapchainKHR(rvk_ctx.device, rvk_ctx.swapchain.handle, NULL);
-
-    /* reset image count, otherwise call to vkGetSwapchainImagesKHR will fail as a query */
-    rvk_ctx.swapchain.img_count = 0;
 }
 
-bool rvk_find_mem_type_idx(uint32_t type, VkMemoryPropertyFlags properties, uint32_t *idx)
+void rvk_mem_destroy()
 {
-    VkPhysicalDeviceMemoryProperties mem_properites = {0};
-    vkGetPhysicalDeviceMemoryProperties(rvk_ctx.phys_device, &mem_properites);
-    for (uint32_t i = 0; i < mem_properites.memoryTypeCount; i++) {
-        if (type & (1 << i) && (mem_properites.memoryTypes[i].propertyFlags & properties) == properties) {
-            *idx = i;
-            return true;
+    for (size_t t = 0; t < VK_MAX_MEMORY_TYPES; t++) {
+        Rvk_Mem_Blocks *blocks = &rvk_ctx.mem_allocator.blocks[t];
+        for (size_t i = 0; i < blocks->count; i++) {
+            Rvk_Mem_Block *block = blocks->items[i];
+            if (block->mapped) vkUnmapMemory(rvk_ctx.device, block->mem);
+            vkFreeMemory(rvk_ctx.device, block->mem, NULL);
+            rvk_da_free(block->ranges);
+            RVK_FREE(block);
         }
+        rvk_da_free(*blocks);
     }
+    rvk_ctx.mem_allocator = (Rvk_Mem_Allocator){0};
+}
+
+Rvk_Mem_Stats rvk_mem_stats()
+{
+    Rvk_Mem_Stats stats = {0};
+    VkDeviceSize total_free = 0;
+    for (size_t t = 0; t < VK_MAX_MEMORY_TYPES; t++) {
+        Rvk_Mem_Blocks *blocks = &rvk_ctx.mem_allocator.blocks[t];
+        for (size_t i = 0; i < blocks->count; i++) {
+            Rvk_Mem_Block *block = blocks->items[i];
+            stats.block_count++;
+            stats.alloc_count    += block->ranges.count;
+            stats.bytes_reserved += block->size;
+            stats.bytes_used     += block->used;
+            total_free           += block->size - block->used;
+
+            VkDeviceSize prev_end = 0;
+            for (size_t j = 0; j <= block->ranges.count; j++) {
+                VkDeviceSize gap_end = (j < block->ranges.count) ? block->ranges.items[j].offset : block->size;
+                if (gap_end - prev_end > stats.largest_free) stats.largest_free = gap_end - prev_end;
+                if (j < block->ranges.count) prev_end = block->ranges.items[j].offset + block->ranges.items[j].size;
+            }
+        }
+    }
+    if (total_free) stats.fragmentation = 1.0f - (float)stats.largest_free / (float)total_free;
+    return stats;
+}
 
-    return false;
+void rvk_mem_log_stats()
+{
+    Rvk_Mem_Stats stats = rvk_mem_stats();
+    rvk_log(RVK_INFO, "device memory: %zu blocks, %zu allocations, %zu/%zu bytes used, largest free %zu, fragmentation %.2f",
+            stats.block_count, stats.alloc_count, (size_t)stats.bytes_used, (size_t)stats.bytes_reserved,
+            (size_t)stats.largest_free, stats.fragmentation);
+}
+
+void rvk_img_destroy(Rvk_Image img)
+{
+    vkDestroyImage(rvk_ctx.device, img.handle, NULL);
+    rvk_mem_free(img.alloc);
 }
 
 bool rvk_inst_exts_satisfied()
@@ -2521,13 +5344,7 @@ void rvk_buff_init(size_t size, size_t count, VkBufferUsageFlags usage, VkMemory
 
     buffer->size = size;
     buffer->count = count;
-
-    if (!data) {
-        rvk_log(RVK_ERROR, "rvk_buff_init failed data was NULL");
-        RVK_EXIT_APP;
-    }
-
-    buffer->data = data;
+    buffer->data = data; // may be NULL for buffers that are filled in later
 
     VkBufferCreateInfo buffer_ci = {
         .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
@@ -2539,16 +5356,8 @@ void rvk_buff_init(size_t size, size_t count, VkBufferUsageFlags usage, VkMemory
 
     VkMemoryRequirements mem_reqs = {0};
     vkGetBufferMemoryRequirements(rvk_ctx.device, buffer->handle, &mem_reqs);
-    VkMemoryAllocateInfo alloc_ci = {
-        .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
-        .allocationSize = mem_reqs.size,
-    };
-    if (!rvk_find_mem_type_idx(mem_reqs.memoryTypeBits, mem_props, &alloc_ci.memoryTypeIndex)) {
-        rvk_log(RVK_ERROR, "while initializing buffer, memory not suitable based on memory requirements");
-        RVK_EXIT_APP;
-    }
-    RAG_VK(vkAllocateMemory(rvk_ctx.device, &alloc_ci, NULL, &buffer->mem));
-    RAG_VK(vkBindBufferMemory(rvk_ctx.device, buffer->handle, buffer->mem, 0));
+    buffer->alloc = rvk_mem_alloc(mem_reqs, mem_props, true);
+    RAG_VK(vkBindBufferMemory(rvk_ctx.device, buffer->handle, buffer->alloc.block->mem, buffer->alloc.offset));
 
     /* book keeping */
     buffer->info.buffer = buffer->handle;
@@ -2718,7 +5527,7 @@ void rvk_buff_map(Rvk_Buffer *buff)
         RVK_EXIT_APP;
     }
 
-    RAG_VK(vkMapMemory(rvk_ctx.device, buff->mem, 0, buff->size, 0, &buff->mapped));
+    buff->mapped = rvk_mem_map(buff->alloc);
 }
 
 void rvk_buff_unmap(Rvk_Buffer buff)
@@ -2727,24 +5536,22 @@ void rvk_buff_unmap(Rvk_Buffer buff)
         rvk_log(RVK_ERROR, "rvk_buff_map failed, buffer invalid");
         RVK_EXIT_APP;
     }
-    vkUnmapMemory(rvk_ctx.device, buff.mem);
+    rvk_mem_unmap(buff.alloc);
 }
 
 void rvk_buff_destroy(Rvk_Buffer buffer)
 {
-    vkDestroyBuffer(rvk_ctx.device, buffer.handle, NULL);
-    vkFreeMemory(rvk_ctx.device, buffer.mem, NULL);
+    rvk_defer_destroy((Rvk_Deferred_Destroy){.kind = RVK_DEFERRED_BUFFER, .as.buff = buffer});
 }
 
 void rvk_destroy_buffer(Rvk_Buffer buffer)
 {
-    vkDestroyBuffer(rvk_ctx.device, buffer.handle, NULL);
-    vkFreeMemory(rvk_ctx.device, buffer.mem, NULL);
+    rvk_buff_destroy(buffer);
 }
 
 const char *rvk_buff_type_as_str(Rvk_Buffer_Type type)
 {
-    assert(RVK_BUFFER_TYPE_COUNT == 6 && "update buffer types");
+    assert(RVK_BUFFER_TYPE_COUNT == 7 && "update buffer types");
     switch (type) {
     case RVK_BUFFER_TYPE_ANY:     return "any";
     case RVK_BUFFER_TYPE_VERTEX:  return "vertex";
@@ -2752,6 +5559,7 @@ const char *rvk_buff_type_as_str(Rvk_Buffer_Type type)
     case RVK_BUFFER_TYPE_COMPUTE: return "compute";
     case RVK_BUFFER_TYPE_UNIFORM: return "uniform";
     case RVK_BUFFER_TYPE_STAGING: return "staging";
+    case RVK_BUFFER_TYPE_INDIRECT: return "indirect";
     default:                      return "unrecognized";
     }
 }
@@ -2763,41 +5571,161 @@ void rvk_buff_staged_upload(Rvk_Buffer buff)
         RVK_EXIT_APP;
     }
 
-    Rvk_Buffer stg_buff = {0};
-    rvk_stage_buff_init(buff.size, buff.count, buff.data, &stg_buff);
-    RAG_VK(vkMapMemory(rvk_ctx.device, stg_buff.mem, 0, stg_buff.size, 0, &stg_buff.mapped));
-    memcpy(stg_buff.mapped, buff.data, stg_buff.size);
-    vkUnmapMemory(rvk_ctx.device, stg_buff.mem);
+    if (!buff.data) {
+        rvk_log(RVK_ERROR, "rvk_buff_staged_upload failed, buffer has no data to upload");
+        RVK_EXIT_APP;
+    }
 
-    /* transfer data from staging buffer to vertex buffer */
-    rvk_buff_copy(buff, stg_buff, 0);
-    rvk_buff_destroy(stg_buff);
+    rvk_buff_upload(buff, 0, buff.data, buff.size);
+}
+
+/* batch that the upload helpers currently record into (NULL if none) */
+static Rvk_Upload_Batch *rvk_active_upload_batch = NULL;
+
+void rvk_buff_upload(Rvk_Buffer dst_buff, VkDeviceSize dst_offset, const void *data, VkDeviceSize size)
+{
+    if (dst_offset + size > dst_buff.size) {
+        rvk_log(RVK_ERROR, "Cannot upload buffer, %zu bytes at offset %zu won't fit", (size_t)size, (size_t)dst_offset);
+        RVK_EXIT_APP;
+    }
+    /* the unified queue never releases the buffer to the transfer family, so the bytes the batch
+     * does not write would be undefined once the transfer queue has written the rest */
+    if (rvk_ctx.transfer.dedicated && rvk_active_upload_batch && (dst_offset || size != dst_buff.size)) {
+        rvk_log(RVK_ERROR, "Cannot upload %zu bytes at offset %zu in a batch on the transfer queue, "
+                "batches replace buffers whole, upload outside the batch or with rvk_frame_buff_upload",
+                (size_t)size, (size_t)dst_offset);
+        RVK_EXIT_APP;
+    }
+
+    const uint8_t *src = data;
+    VkDeviceSize max_chunk = rvk_stg_ring_max_chunk();
+    while (size) {
+        VkDeviceSize chunk = (size < max_chunk) ? size : max_chunk;
+        Rvk_Staging_Range range = rvk_stg_ring_alloc(rvk_upload_owner(), chunk, 4);
+        memcpy(range.mapped, src, chunk);
+
+        VkCommandBuffer tmp_cmd_buff = rvk_upload_cmd_begin();
+            VkBufferCopy copy_region = {
+                .srcOffset = range.offset,
+                .dstOffset = dst_offset,
+                .size = chunk,
+            };
+            vkCmdCopyBuffer(tmp_cmd_buff, range.handle, dst_buff.handle, 1, &copy_region);
+            rvk_transfer_release_buff(dst_buff.handle);
+        rvk_upload_cmd_end(&tmp_cmd_buff);
+
+        src        += chunk;
+        dst_offset += chunk;
+        size       -= chunk;
+    }
+}
+
+void rvk_frame_buff_upload(Rvk_Buffer dst_buff, VkDeviceSize dst_offset, const void *data, VkDeviceSize size)
+{
+    if (dst_offset + size > dst_buff.size) {
+        rvk_log(RVK_ERROR, "Cannot upload buffer, %zu bytes at offset %zu won't fit", (size_t)size, (size_t)dst_offset);
+        RVK_EXIT_APP;
+    }
+
+    const uint8_t *src = data;
+    VkDeviceSize max_chunk = rvk_stg_ring_max_chunk();
+    while (size) {
+        VkDeviceSize chunk = (size < max_chunk) ? size : max_chunk;
+        Rvk_Staging_Range range = rvk_stg_ring_alloc(RVK_STAGING_FRAME, chunk, 4);
+        memcpy(range.mapped, src, chunk);
+        VkBufferCopy copy_region = {
+            .srcOffset = range.offset,
+            .dstOffset = dst_offset,
+            .size = chunk,
+        };
+        vkCmdCopyBuffer(rvk_ctx.cmd_buff, range.handle, dst_buff.handle, 1, &copy_region);
+
+        src        += chunk;
+        dst_offset += chunk;
+        size       -= chunk;
+    }
+}
+
+void rvk_img_upload(VkImage dst_img, VkExtent2D extent, VkFormat fmt, const void *data)
+{
+    VkDeviceSize texel_size = rvk_format_to_size(fmt);
+    VkDeviceSize row_size = extent.width * texel_size;
+    VkDeviceSize max_rows = rvk_stg_ring_max_chunk() / row_size;
+    if (!max_rows) {
+        rvk_log(RVK_ERROR, "Cannot upload image, a single row (%zu bytes) is larger than the staging ring", (size_t)row_size);
+        RVK_EXIT_APP;
+    }
+
+    /* chunks are whole rows so each one is a plain buffer to image copy */
+    const uint8_t *src = data;
+    uint32_t row = 0;
+    while (row < extent.height) {
+        uint32_t rows = extent.height - row;
+        if (rows > max_rows) rows = max_rows;
+        VkDeviceSize chunk = rows * row_size;
+        Rvk_Staging_Range range = rvk_stg_ring_alloc(rvk_upload_owner(), chunk, 4 * texel_size);
+        memcpy(range.mapped, src, chunk);
+
+        VkCommandBuffer tmp_cmd_buff = rvk_upload_cmd_begin();
+            VkBufferImageCopy region = {
+                .bufferOffset = range.offset,
+                .imageSubresource = {
+                    .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                    .layerCount = 1,
+                },
+                .imageOffset = {0, (int32_t)row, 0},
+                .imageExtent = {extent.width, rows, 1},
+            };
+            vkCmdCopyBufferToImage(tmp_cmd_buff, range.handle, dst_img, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+        rvk_upload_cmd_end(&tmp_cmd_buff);
+
+        src += chunk;
+        row += rows;
+    }
 }
 
 void rvk_buff_copy(Rvk_Buffer dst_buff, Rvk_Buffer src_buff, VkDeviceSize size)
 {
-    VkCommandBuffer tmp_cmd_buff = rvk_cmd_quick_begin();
-        VkBufferCopy copy_region = {0};
-        if (size) {
-            copy_region.size = size;
-            if (size > dst_buff.size) {
-                rvk_log(RVK_ERROR, "Cannot copy buffer, size > dst buffer (won't fit)");
-                RVK_EXIT_APP;
-            }
-            if (size > src_buff.size) {
-                rvk_log(RVK_ERROR, "Cannot copy buffer, size > src buffer (cannot copy more than what's available)");
-                RVK_EXIT_APP;
-            }
-        } else {
-            // size == 0 means copy the entire src to dst
-            if (dst_buff.size < src_buff.size) {
-                rvk_log(RVK_ERROR, "Cannot copy buffer, dst buffer < src buffer (won't fit)");
-                RVK_EXIT_APP;
-            }
-            copy_region.size = src_buff.size;
+    /* the transfer family would read src without the unified queue releasing it first */
+    if (rvk_ctx.transfer.dedicated) {
+        if (rvk_active_upload_batch) {
+            rvk_log(RVK_ERROR, "rvk_buff_copy cannot run inside an upload batch on the transfer queue, "
+                               "it would not see the batch's uploads, copy before or after the batch");
+            RVK_EXIT_APP;
+        }
+        VkCommandBuffer tmp_cmd_buff = rvk_cmd_quick_begin();
+            rvk_cmd_buff_copy(tmp_cmd_buff, dst_buff, src_buff, size);
+        rvk_cmd_quick_end(&tmp_cmd_buff);
+        return;
+    }
+
+    VkCommandBuffer tmp_cmd_buff = rvk_upload_cmd_begin();
+        rvk_cmd_buff_copy(tmp_cmd_buff, dst_buff, src_buff, size);
+    rvk_upload_cmd_end(&tmp_cmd_buff);
+}
+
+void rvk_cmd_buff_copy(VkCommandBuffer cmd_buff, Rvk_Buffer dst_buff, Rvk_Buffer src_buff, VkDeviceSize size)
+{
+    VkBufferCopy copy_region = {0};
+    if (size) {
+        copy_region.size = size;
+        if (size > dst_buff.size) {
+            rvk_log(RVK_ERROR, "Cannot copy buffer, size > dst buffer (won't fit)");
+            RVK_EXIT_APP;
+        }
+        if (size > src_buff.size) {
+            rvk_log(RVK_ERROR, "Cannot copy buffer, size > src buffer (cannot copy more than what's available)");
+            RVK_EXIT_APP;
+        }
+    } else {
+        // size == 0 means copy the entire src to dst
+        if (dst_buff.size < src_buff.size) {
+            rvk_log(RVK_ERROR, "Cannot copy buffer, dst buffer < src buffer (won't fit)");
+            RVK_EXIT_APP;
         }
-        vkCmdCopyBuffer(tmp_cmd_buff, src_buff.handle, dst_buff.handle, 1, &copy_region);
-    rvk_cmd_quick_end(&tmp_cmd_buff);
+        copy_region.size = src_buff.size;
+    }
+    vkCmdCopyBuffer(cmd_buff, src_buff.handle, dst_buff.handle, 1, &copy_region);
 }
 
 void rvk_img_init(Rvk_Image *img, VkImageUsageFlags usage, VkMemoryPropertyFlags properties)
@@ -2825,16 +5753,8 @@ void rvk_img_init(Rvk_Image *img, VkImageUsageFlags usage, VkMemoryPropertyFlags
     VkMemoryRequirements mem_reqs = {0};
     vkGetImageMemoryRequirements(rvk_ctx.device, img->handle, &mem_reqs);
 
-    VkMemoryAllocateInfo alloc_ci = {
-        .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
-        .allocationSize = mem_reqs.size,
-    };
-    if (!rvk_find_mem_type_idx(mem_reqs.memoryTypeBits, properties, &alloc_ci.memoryTypeIndex)) {
-        rvk_log(RVK_ERROR, "Memory not suitable based on memory requirements");
-        RVK_EXIT_APP;
-    }
-    RAG_VK(vkAllocateMemory(rvk_ctx.device, &alloc_ci, NULL, &img->mem));
-    RAG_VK(vkBindImageMemory(rvk_ctx.device, img->handle, img->mem, 0));
+    img->alloc = rvk_mem_alloc(mem_reqs, properties, false);
+    RAG_VK(vkBindImageMemory(rvk_ctx.device, img->handle, img->alloc.block->mem, img->alloc.offset));
 }
 
 Rvk_Image rvk_create_image_(VkExtent3D extent, VkMemoryPropertyFlags properties, Rvk_Image_Create_Info img_ci)
@@ -2872,16 +5792,9 @@ Rvk_Image rvk_create_image_(VkExtent3D extent, VkMemoryPropertyFlags properties,
     VkMemoryRequirements mem_reqs = {0};
     vkGetImageMemoryRequirements(rvk_ctx.device, img.handle, &mem_reqs);
 
-    VkMemoryAllocateInfo alloc_ci = {
-        .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
-        .allocationSize = mem_reqs.size,
-    };
-    if (!rvk_find_mem_type_idx(mem_reqs.memoryTypeBits, properties, &alloc_ci.memoryTypeIndex)) {
-        rvk_log(RVK_ERROR, "Memory not suitable based on memory requirements");
-        RVK_EXIT_APP;
-    }
-    RAG_VK(vkAllocateMemory(rvk_ctx.device, &alloc_ci, NULL, &img.mem));
-    RAG_VK(vkBindImageMemory(rvk_ctx.device, img.handle, img.mem, 0));
+    bool linear = actual_ci.tiling == VK_IMAGE_TILING_LINEAR;
+    img.alloc = rvk_mem_alloc(mem_reqs, properties, linear);
+    RAG_VK(vkBindImageMemory(rvk_ctx.device, img.handle, img.alloc.block->mem, img.alloc.offset));
 
     /* book keeping */
     img.extent = (VkExtent2D){actual_ci.extent.width, actual_ci.extent.height}; // TODO: this probably means that image should be VkExtent3D
@@ -2897,6 +5810,13 @@ void rvk_cmd_pool_init()
         .queueFamilyIndex = rvk_ctx.queue_idx,
     };
     RAG_VK(vkCreateCommandPool(rvk_ctx.device, &cmd_pool_ci, NULL, &rvk_ctx.pool));
+
+    if (rvk_ctx.transfer.dedicated) {
+        cmd_pool_ci.queueFamilyIndex = rvk_ctx.transfer.queue_idx;
+        RAG_VK(vkCreateCommandPool(rvk_ctx.device, &cmd_pool_ci, NULL, &rvk_ctx.transfer.pool));
+    } else {
+        rvk_ctx.transfer.pool = rvk_ctx.pool;
+    }
 }
 
 void rvk_allocate_command_buffer_(VkCommandBuffer *buff, Rvk_Command_Buffer_Allocate_Info rvk_ci)
@@ -2917,117 +5837,619 @@ void rvk_cmd_syncs_init()
         .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
         .flags = VK_FENCE_CREATE_SIGNALED_BIT,
     };
-    RAG_VK(vkCreateSemaphore(rvk_ctx.device, &sem_ci, NULL, &rvk_ctx.img_avail_sem));
-    RAG_VK(vkCreateSemaphore(rvk_ctx.device, &sem_ci, NULL, &rvk_ctx.render_fin_sem));
-    RAG_VK(vkCreateFence(rvk_ctx.device, &fence_ci, NULL, &rvk_ctx.fence));
+    for (uint32_t i = 0; i < rvk_ctx.frames_in_flight; i++) {
+        Rvk_Frame *frame = &rvk_ctx.frames[i];
+        RAG_VK(vkCreateSemaphore(rvk_ctx.device, &sem_ci, NULL, &frame->img_avail_sem));
+        RAG_VK(vkCreateFence(rvk_ctx.device, &fence_ci, NULL, &frame->fence));
+    }
+    for (uint32_t i = 0; i < RVK_MAX_SWAPCHAIN_IMAGES; i++)
+        RAG_VK(vkCreateSemaphore(rvk_ctx.device, &sem_ci, NULL, &rvk_ctx.render_fin_sems[i]));
+    rvk_timeline_init(&rvk_ctx.timeline);
+    rvk_timeline_init(&rvk_ctx.compute.timeline);
+    if (rvk_ctx.transfer.dedicated) rvk_timeline_init(&rvk_ctx.transfer.timeline);
+}
+
+void rvk_create_semaphore(VkSemaphore *semaphore)
+{
+    VkSemaphoreCreateInfo sem_ci = {.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO};
+    RAG_VK(vkCreateSemaphore(rvk_ctx.device, &sem_ci, NULL, semaphore));
+}
+
+void rvk_create_fence(VkFence *fence)
+{
+    VkFenceCreateInfo fence_ci = {
+        .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
+        .flags = VK_FENCE_CREATE_SIGNALED_BIT,
+    };
+    RAG_VK(vkCreateFence(rvk_ctx.device, &fence_ci, NULL, fence));
+}
+
+void rvk_destroy_semaphore(VkSemaphore semaphore)
+{
+    vkDestroySemaphore(rvk_ctx.device, semaphore, NULL);
+}
+
+void rvk_destroy_fence(VkFence fence)
+{
+    vkDestroyFence(rvk_ctx.device, fence, NULL);
+}
+
+// TODO: rvk_temp_cmd_buff
+VkCommandBuffer rvk_cmd_quick_begin()
+{
+    VkCommandBuffer cmd_buff = VK_NULL_HANDLE;
+    VkCommandBufferAllocateInfo ci = {
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+        .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+        .commandPool = rvk_ctx.pool,
+        .commandBufferCount = 1,
+    };
+    RAG_VK(vkAllocateCommandBuffers(rvk_ctx.device, &ci, &cmd_buff));
+    VkCommandBufferBeginInfo cmd_begin = {
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+        .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+    };
+    RAG_VK(vkBeginCommandBuffer(cmd_buff, &cmd_begin));
+    return cmd_buff;
+}
+
+void rvk_cmd_quick_end(VkCommandBuffer *tmp_cmd_buff)
+{
+    RAG_VK(vkEndCommandBuffer(*tmp_cmd_buff));
+    VkSubmitInfo submit = {
+        .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+        .commandBufferCount = 1,
+        .pCommandBuffers = tmp_cmd_buff,
+    };
+    rvk_timeline_wait(&rvk_ctx.timeline, rvk_timeline_submit(&rvk_ctx.timeline, rvk_ctx.unified_queue, submit, VK_NULL_HANDLE, NULL));
+    vkFreeCommandBuffers(rvk_ctx.device, rvk_ctx.pool, 1, tmp_cmd_buff);
+}
+
+void rvk_transfer_queue_pick(VkPhysicalDevice phys_device)
+{
+    Rvk_Transfer_Queue *transfer = &rvk_ctx.transfer;
+    transfer->dedicated = false;
+    transfer->queue_idx = rvk_ctx.queue_idx;
+    if (transfer->disabled) return;
+
+    /* graphics and compute families can transfer too, only a family that does nothing else is worth it */
+    uint32_t queue_fam_count = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(phys_device, &queue_fam_count, NULL);
+    VkQueueFamilyProperties queue_fam_props[queue_fam_count];
+    vkGetPhysicalDeviceQueueFamilyProperties(phys_device, &queue_fam_count, queue_fam_props);
+    for (uint32_t i = 0; i < queue_fam_count; i++) {
+        VkQueueFlags flags = queue_fam_props[i].queueFlags;
+        if ((flags & VK_QUEUE_TRANSFER_BIT) && !(flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT))) {
+            transfer->dedicated = true;
+            transfer->queue_idx = i;
+            rvk_log(RVK_INFO, "uploads run on transfer queue family %u", i);
+            return;
+        }
+    }
+    rvk_log(RVK_INFO, "no transfer-only queue family, uploads run on the unified queue");
+}
+
+void rvk_compute_queue_pick(VkPhysicalDevice phys_device)
+{
+    rvk_ctx.compute.async = false;
+    if (rvk_ctx.compute.disabled) return;
+
+    uint32_t queue_fam_count = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(phys_device, &queue_fam_count, NULL);
+    VkQueueFamilyProperties queue_fam_props[queue_fam_count];
+    vkGetPhysicalDeviceQueueFamilyProperties(phys_device, &queue_fam_count, queue_fam_props);
+    if (queue_fam_props[rvk_ctx.queue_idx].queueCount >= 2) {
+        rvk_ctx.compute.async = true;
+        rvk_log(RVK_INFO, "compute runs on a second queue of family %u", rvk_ctx.queue_idx);
+    } else {
+        rvk_log(RVK_INFO, "queue family %u has one queue, compute shares it with graphics", rvk_ctx.queue_idx);
+    }
+}
+
+void rvk_transfer_queue_destroy()
+{
+    Rvk_Transfer_Queue *transfer = &rvk_ctx.transfer;
+    if (transfer->dedicated) {
+        vkDestroyCommandPool(rvk_ctx.device, transfer->pool, NULL);
+        vkDestroySemaphore(rvk_ctx.device, transfer->timeline.sem, NULL);
+    }
+    for (size_t i = 0; i < transfer->acquire_cmds.count; i++)
+        vkFreeCommandBuffers(rvk_ctx.device, rvk_ctx.pool, 1, &transfer->acquire_cmds.items[i].cmd_buff);
+    rvk_da_free(transfer->pending);
+    rvk_da_free(transfer->acquire_cmds);
+    transfer->pool = VK_NULL_HANDLE;
+    transfer->timeline = (Rvk_Timeline){0};
+}
+
+Rvk_Timeline *rvk_transfer_timeline()
+{
+    return (rvk_ctx.transfer.dedicated) ? &rvk_ctx.transfer.timeline : &rvk_ctx.timeline;
+}
+
+/* the active batch wrote buff, it changes owner when the batch is submitted */
+void rvk_transfer_release_buff(VkBuffer buff)
+{
+    Rvk_Queue_Transfers *pending = &rvk_ctx.transfer.pending;
+    if (!rvk_ctx.transfer.dedicated || !rvk_active_upload_batch) return;
+    for (size_t i = pending->count; i > 0 && !pending->items[i - 1].value; i--)
+        if (pending->items[i - 1].buff == buff) return;
+    rvk_da_append(pending, ((Rvk_Queue_Transfer){.buff = buff}));
+}
+
+/* records the release half of every ownership transfer of the batch being submitted */
+void rvk_transfer_release(VkCommandBuffer cmd_buff)
+{
+    Rvk_Queue_Transfers *pending = &rvk_ctx.transfer.pending;
+    for (size_t i = pending->count; i > 0 && !pending->items[i - 1].value; i--) {
+        Rvk_Queue_Transfer *t = &pending->items[i - 1];
+        if (t->buff) {
+            VkBufferMemoryBarrier barrier = {
+                .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+                .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+                .srcQueueFamilyIndex = rvk_ctx.transfer.queue_idx,
+                .dstQueueFamilyIndex = rvk_ctx.queue_idx,
+                .buffer = t->buff,
+                .size = VK_WHOLE_SIZE,
+            };
+            vkCmdPipelineBarrier(
+                cmd_buff, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                0, 0, NULL, 1, &barrier, 0, NULL
+            );
+        } else if (t->old_layout != VK_IMAGE_LAYOUT_UNDEFINED) {
+            VkPipelineStageFlags src_stage, dst_stage;
+            VkAccessFlags src_access, dst_access;
+            rvk_img_layout_masks(t->old_layout, t->new_layout, &src_stage, &dst_stage, &src_access, &dst_access);
+            VkImageMemoryBarrier barrier = {
+                .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+                .srcAccessMask = src_access,
+                .oldLayout = t->old_layout,
+                .newLayout = t->new_layout,
+                .srcQueueFamilyIndex = rvk_ctx.transfer.queue_idx,
+                .dstQueueFamilyIndex = rvk_ctx.queue_idx,
+                .image = t->img,
+                .subresourceRange = {
+                    .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                    .levelCount = 1,
+                    .layerCount = 1,
+                },
+            };
+            vkCmdPipelineBarrier(
+                cmd_buff, src_stage, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                0, 0, NULL, 0, NULL, 1, &barrier
+            );
+        }
+    }
+}
+
+/* for every transfer batch that has completed, records the acquire half of its ownership transfers
+ * into a small submission on the unified queue that waits on the batch's value, which has already
+ * been reached, so rendering never stalls on it. later submissions see the batch's writes */
+void rvk_transfer_acquire_completed()
+{
+    Rvk_Transfer_Queue *transfer = &rvk_ctx.transfer;
+    if (!transfer->dedicated) return;
+
+    size_t kept = 0;
+    for (size_t i = 0; i < transfer->acquire_cmds.count; i++) {
+        Rvk_Acquire_Cmd cmd = transfer->acquire_cmds.items[i];
+        if (rvk_timeline_is_complete(&rvk_ctx.timeline, cmd.value)) vkFreeCommandBuffers(rvk_ctx.device, rvk_ctx.pool, 1, &cmd.cmd_buff);
+        else transfer->acquire_cmds.items[kept++] = cmd;
+    }
+    transfer->acquire_cmds.count = kept;
+
+    if (!transfer->pending.count || !transfer->pending.items[0].value) return;
+    uint64_t completed = rvk_timeline_completed(&transfer->timeline);
+    size_t count = 0;
+    while (count < transfer->pending.count && transfer->pending.items[count].value &&
+           transfer->pending.items[count].value <= completed) count++;
+    if (!count) return;
+
+    VkCommandBuffer cmd_buff = VK_NULL_HANDLE;
+    rvk_allocate_command_buffer(&cmd_buff);
+    VkCommandBufferBeginInfo cmd_begin = {
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+        .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+    };
+    RAG_VK(vkBeginCommandBuffer(cmd_buff, &cmd_begin));
+    for (size_t i = 0; i < count; i++) {
+        Rvk_Queue_Transfer *t = &transfer->pending.items[i];
+        if (t->buff) {
+            VkBufferMemoryBarrier barrier = {
+                .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+                .dstAccessMask = VK_ACCESS_MEMORY_READ_BIT,
+                .srcQueueFamilyIndex = transfer->queue_idx,
+                .dstQueueFamilyIndex = rvk_ctx.queue_idx,
+                .buffer = t->buff,
+                .size = VK_WHOLE_SIZE,
+            };
+            vkCmdPipelineBarrier(
+                cmd_buff, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                0, 0, NULL, 1, &barrier, 0, NULL
+            );
+        } else if (t->old_layout == VK_IMAGE_LAYOUT_UNDEFINED) {
+            rvk_cmd_transition_img_layout(cmd_buff, t->img, t->old_layout, t->new_layout);
+        } else {
+            VkPipelineStageFlags src_stage, dst_stage;
+            VkAccessFlags src_access, dst_access;
+            rvk_img_layout_masks(t->old_layout, t->new_layout, &src_stage, &dst_stage, &src_access, &dst_access);
+            VkImageMemoryBarrier barrier = {
+                .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+                .dstAccessMask = dst_access,
+                .oldLayout = t->old_layout,
+                .newLayout = t->new_layout,
+                .srcQueueFamilyIndex = transfer->queue_idx,
+                .dstQueueFamilyIndex = rvk_ctx.queue_idx,
+                .image = t->img,
+                .subresourceRange = {
+                    .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                    .levelCount = 1,
+                    .layerCount = 1,
+                },
+            };
+            vkCmdPipelineBarrier(
+                cmd_buff, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, dst_stage,
+                0, 0, NULL, 0, NULL, 1, &barrier
+            );
+        }
+    }
+    RAG_VK(vkEndCommandBuffer(cmd_buff));
+
+    uint64_t wait_value = transfer->pending.items[count - 1].value;
+    VkPipelineStageFlags wait_stage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+    VkSubmitInfo submit = {
+        .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+        .waitSemaphoreCount = 1,
+        .pWaitSemaphores = &transfer->timeline.sem,
+        .pWaitDstStageMask = &wait_stage,
+        .commandBufferCount = 1,
+        .pCommandBuffers = &cmd_buff,
+    };
+    uint64_t value = rvk_timeline_submit(&rvk_ctx.timeline, rvk_ctx.unified_queue, submit, VK_NULL_HANDLE, &wait_value);
+    rvk_da_append(&transfer->acquire_cmds, ((Rvk_Acquire_Cmd){.cmd_buff = cmd_buff, .value = value}));
+
+    transfer->acquired = wait_value;
+    transfer->pending.count -= count;
+    memmove(transfer->pending.items, transfer->pending.items + count, transfer->pending.count * sizeof(*transfer->pending.items));
+}
+
+void rvk_begin_upload_batch(Rvk_Upload_Batch *batch)
+{
+    if (rvk_active_upload_batch) {
+        rvk_log(RVK_ERROR, "an upload batch is already recording, submit it before beginning another");
+        RVK_EXIT_APP;
+    }
+
+    *batch = (Rvk_Upload_Batch){0};
+    rvk_allocate_command_buffer(&batch->cmd_buff, .command_pool = rvk_ctx.transfer.pool);
+    VkCommandBufferBeginInfo cmd_begin = {
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+        .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+    };
+    RAG_VK(vkBeginCommandBuffer(batch->cmd_buff, &cmd_begin));
+    rvk_active_upload_batch = batch;
+}
+
+/* on the dedicated queue the batch waits for the graphics submitted before it, the buffers it
+ * rewrites may still be read by frames in flight */
+static uint64_t rvk_upload_batch_queue_submit(Rvk_Upload_Batch *batch, VkFence fence)
+{
+    uint64_t gfx_value = rvk_ctx.timeline.submitted;
+    if (!rvk_ctx.transfer.dedicated || !gfx_value)
+        return rvk_queue_submit(rvk_ctx.transfer.queue, fence, .p_command_buffers = &batch->cmd_buff);
+
+    VkPipelineStageFlags wait_stage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+    VkSubmitInfo si = {
+        .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+        .waitSemaphoreCount = 1,
+        .pWaitSemaphores = &rvk_ctx.timeline.sem,
+        .pWaitDstStageMask = &wait_stage,
+        .commandBufferCount = 1,
+        .pCommandBuffers = &batch->cmd_buff,
+    };
+    return rvk_timeline_submit(&rvk_ctx.transfer.timeline, rvk_ctx.transfer.queue, si, fence, &gfx_value);
+}
+
+VkFence rvk_submit_upload_batch(Rvk_Upload_Batch *batch)
+{
+    if (rvk_active_upload_batch != batch) {
+        rvk_log(RVK_ERROR, "upload batch submitted, but it was not the one recording");
+        RVK_EXIT_APP;
+    }
+    rvk_active_upload_batch = NULL;
+
+    if (rvk_ctx.transfer.dedicated) {
+        rvk_transfer_release(batch->cmd_buff);
+    } else {
+        /* one barrier for the whole batch, makes the transfers visible to anything submitted later */
+        VkMemoryBarrier barrier = {
+            .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+            .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+            .dstAccessMask = VK_ACCESS_MEMORY_READ_BIT,
+        };
+        vkCmdPipelineBarrier(
+            batch->cmd_buff,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+            0, 1, &barrier, 0, NULL, 0, NULL
+        );
+    }
+    RAG_VK(vkEndCommandBuffer(batch->cmd_buff));
+
+    VkFenceCreateInfo fence_ci = {.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
+    RAG_VK(vkCreateFence(rvk_ctx.device, &fence_ci, NULL, &batch->fence));
+    batch->timeline = rvk_transfer_timeline();
+    batch->timeline_value = rvk_upload_batch_queue_submit(batch, batch->fence);
+    rvk_stg_ring_submit(RVK_STAGING_BATCH, batch->timeline, batch->timeline_value);
+
+    /* what the batch released changes owner once its value is reached */
+    Rvk_Queue_Transfers *pending = &rvk_ctx.transfer.pending;
+    for (size_t i = pending->count; i > 0 && !pending->items[i - 1].value; i--)
+        pending->items[i - 1].value = batch->timeline_value;
+    return batch->fence;
+}
+
+bool rvk_upload_batch_done(Rvk_Upload_Batch *batch)
+{
+    if (!batch->fence) return false;
+    if (rvk_ctx.transfer.dedicated) {
+        rvk_transfer_acquire_completed();
+        return batch->timeline_value <= rvk_ctx.transfer.acquired;
+    }
+    return vkGetFenceStatus(rvk_ctx.device, batch->fence) == VK_SUCCESS;
+}
+
+void rvk_wait_upload_batch(Rvk_Upload_Batch *batch)
+{
+    if (!batch->fence) {
+        rvk_log(RVK_ERROR, "upload batch must be submitted before waiting on it");
+        RVK_EXIT_APP;
+    }
+
+    RAG_VK(vkWaitForFences(rvk_ctx.device, 1, &batch->fence, VK_TRUE, UINT64_MAX));
+    rvk_stg_ring_retire();
+    rvk_transfer_acquire_completed();
+    vkDestroyFence(rvk_ctx.device, batch->fence, NULL);
+    vkFreeCommandBuffers(rvk_ctx.device, rvk_ctx.transfer.pool, 1, &batch->cmd_buff);
+    *batch = (Rvk_Upload_Batch){0};
 }
 
-void rvk_create_semaphore(VkSemaphore *semaphore)
+void rvk_end_upload_batch(Rvk_Upload_Batch *batch)
 {
-    VkSemaphoreCreateInfo sem_ci = {.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO};
-    RAG_VK(vkCreateSemaphore(rvk_ctx.device, &sem_ci, NULL, semaphore));
+    rvk_submit_upload_batch(batch);
+    rvk_wait_upload_batch(batch);
 }
 
-void rvk_create_fence(VkFence *fence)
+Rvk_Staging_Owner rvk_upload_owner()
 {
-    VkFenceCreateInfo fence_ci = {
-        .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
-        .flags = VK_FENCE_CREATE_SIGNALED_BIT,
-    };
-    RAG_VK(vkCreateFence(rvk_ctx.device, &fence_ci, NULL, fence));
+    return (rvk_active_upload_batch) ? RVK_STAGING_BATCH : RVK_STAGING_QUICK;
 }
 
-void rvk_destroy_semaphore(VkSemaphore semaphore)
+VkCommandBuffer rvk_upload_cmd_begin()
 {
-    vkDestroySemaphore(rvk_ctx.device, semaphore, NULL);
+    if (!rvk_active_upload_batch) return rvk_cmd_quick_begin();
+    rvk_active_upload_batch->cmd_count++;
+    return rvk_active_upload_batch->cmd_buff;
 }
 
-void rvk_destroy_fence(VkFence fence)
+void rvk_upload_cmd_end(VkCommandBuffer *cmd_buff)
 {
-    vkDestroyFence(rvk_ctx.device, fence, NULL);
+    if (rvk_active_upload_batch) return;
+
+    /* quick end has waited on the copy, its ranges are reclaimed once every older span is done too */
+    rvk_cmd_quick_end(cmd_buff);
+    rvk_stg_ring_submit(RVK_STAGING_QUICK, &rvk_ctx.timeline, rvk_ctx.timeline.submitted);
+    rvk_stg_ring_retire();
 }
 
-// TODO: rvk_temp_cmd_buff
-VkCommandBuffer rvk_cmd_quick_begin()
+/* submits what the active batch has recorded so far and waits on it, used when the
+ * batch alone has filled the staging ring */
+static void rvk_upload_batch_flush(Rvk_Upload_Batch *batch)
 {
-    VkCommandBuffer cmd_buff = VK_NULL_HANDLE;
-    VkCommandBufferAllocateInfo ci = {
-        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
-        .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
-        .commandPool = rvk_ctx.pool,
-        .commandBufferCount = 1,
-    };
-    RAG_VK(vkAllocateCommandBuffers(rvk_ctx.device, &ci, &cmd_buff));
+    RAG_VK(vkEndCommandBuffer(batch->cmd_buff));
+    uint64_t value = rvk_upload_batch_queue_submit(batch, VK_NULL_HANDLE);
+    rvk_stg_ring_submit(RVK_STAGING_BATCH, rvk_transfer_timeline(), value);
+    rvk_timeline_wait(rvk_transfer_timeline(), value);
+    rvk_stg_ring_retire();
+
+    RAG_VK(vkResetCommandBuffer(batch->cmd_buff, 0));
     VkCommandBufferBeginInfo cmd_begin = {
         .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
         .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
     };
-    RAG_VK(vkBeginCommandBuffer(cmd_buff, &cmd_begin));
-    return cmd_buff;
+    RAG_VK(vkBeginCommandBuffer(batch->cmd_buff, &cmd_begin));
 }
 
-void rvk_cmd_quick_end(VkCommandBuffer *tmp_cmd_buff)
+void rvk_stg_ring_init(VkDeviceSize size)
 {
-    RAG_VK(vkEndCommandBuffer(*tmp_cmd_buff));
-    VkSubmitInfo submit = {
-        .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
-        .commandBufferCount = 1,
-        .pCommandBuffers = tmp_cmd_buff,
+    Rvk_Staging_Ring *ring = &rvk_ctx.stg_ring;
+    *ring = (Rvk_Staging_Ring){.capacity = size};
+
+    VkBufferCreateInfo buffer_ci = {
+        .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+        .size = size,
+        .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
     };
-    RAG_VK(vkQueueSubmit(rvk_ctx.unified_queue, 1, &submit, VK_NULL_HANDLE));
-    RAG_VK(vkQueueWaitIdle(rvk_ctx.unified_queue));
-    vkFreeCommandBuffers(rvk_ctx.device, rvk_ctx.pool, 1, tmp_cmd_buff);
+    RAG_VK(vkCreateBuffer(rvk_ctx.device, &buffer_ci, NULL, &ring->handle));
+
+    VkMemoryRequirements mem_reqs = {0};
+    vkGetBufferMemoryRequirements(rvk_ctx.device, ring->handle, &mem_reqs);
+    VkMemoryAllocateInfo alloc_ci = {
+        .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+        .allocationSize = mem_reqs.size,
+    };
+    VkMemoryPropertyFlags mem_props = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    if (!rvk_find_mem_type_idx(mem_reqs.memoryTypeBits, mem_props, &alloc_ci.memoryTypeIndex)) {
+        rvk_log(RVK_ERROR, "no host visible memory for the staging ring");
+        RVK_EXIT_APP;
+    }
+    RAG_VK(vkAllocateMemory(rvk_ctx.device, &alloc_ci, NULL, &ring->mem));
+    RAG_VK(vkBindBufferMemory(rvk_ctx.device, ring->handle, ring->mem, 0));
+    RAG_VK(vkMapMemory(rvk_ctx.device, ring->mem, 0, size, 0, &ring->mapped));
 }
 
-void rvk_transition_img_layout(VkImage image, VkImageLayout old_layout, VkImageLayout new_layout)
+void rvk_stg_ring_destroy()
+{
+    Rvk_Staging_Ring *ring = &rvk_ctx.stg_ring;
+    if (!ring->handle) return;
+    vkUnmapMemory(rvk_ctx.device, ring->mem);
+    vkDestroyBuffer(rvk_ctx.device, ring->handle, NULL);
+    vkFreeMemory(rvk_ctx.device, ring->mem, NULL);
+    rvk_da_free(ring->spans);
+    *ring = (Rvk_Staging_Ring){0};
+}
+
+VkDeviceSize rvk_stg_ring_max_chunk()
+{
+    /* half the ring, so one chunk can be filled while the previous is still being copied */
+    return rvk_ctx.stg_ring.capacity / 2;
+}
+
+void rvk_stg_ring_submit(Rvk_Staging_Owner owner, Rvk_Timeline *timeline, uint64_t value)
+{
+    Rvk_Staging_Spans *spans = &rvk_ctx.stg_ring.spans;
+    for (size_t i = 0; i < spans->count; i++) {
+        Rvk_Staging_Span *span = &spans->items[i];
+        if (span->owner != owner || span->timeline) continue;
+        span->timeline = timeline;
+        span->value = value;
+    }
+}
+
+void rvk_stg_ring_retire()
+{
+    /* the timelines are independent, a later span may be done while an older one is still read */
+    Rvk_Staging_Ring *ring = &rvk_ctx.stg_ring;
+    size_t count = 0;
+    while (count < ring->spans.count) {
+        Rvk_Staging_Span span = ring->spans.items[count];
+        if (!span.timeline || !rvk_timeline_is_complete(span.timeline, span.value)) break;
+        ring->tail = span.end;
+        count++;
+    }
+    if (!count) return;
+    ring->spans.count -= count;
+    memmove(ring->spans.items, ring->spans.items + count, ring->spans.count * sizeof(*ring->spans.items));
+}
+
+Rvk_Staging_Range rvk_stg_ring_alloc(Rvk_Staging_Owner owner, VkDeviceSize size, VkDeviceSize alignment)
 {
-    VkCommandBuffer tmp_cmd_buff = rvk_cmd_quick_begin();
-        VkPipelineStageFlags src_stg_mask;
-        VkPipelineStageFlags dst_stg_mask;
-        VkAccessFlags src_access_mask;
-        VkAccessFlags dst_access_mask;
-        if (old_layout == VK_IMAGE_LAYOUT_UNDEFINED && new_layout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL) {
-            src_access_mask = 0;
-            dst_access_mask = VK_ACCESS_TRANSFER_WRITE_BIT;
-            src_stg_mask = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-            dst_stg_mask = VK_PIPELINE_STAGE_TRANSFER_BIT;
-        } else if (old_layout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL &&
-                   new_layout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL) {
-            src_access_mask = VK_ACCESS_TRANSFER_WRITE_BIT;
-            dst_access_mask = VK_ACCESS_SHADER_READ_BIT;
-            src_stg_mask = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            dst_stg_mask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-        } else if (old_layout == VK_IMAGE_LAYOUT_UNDEFINED && new_layout == VK_IMAGE_LAYOUT_GENERAL) {
-            src_access_mask = 0;
-            dst_access_mask = 0;
-            src_stg_mask = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
-            dst_stg_mask = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+    Rvk_Staging_Ring *ring = &rvk_ctx.stg_ring;
+    if (!ring->handle) {
+        rvk_log(RVK_ERROR, "staging ring used before rvk_init");
+        RVK_EXIT_APP;
+    }
+    if (size > ring->capacity) {
+        rvk_log(RVK_ERROR, "staging allocation of %zu bytes is larger than the ring (%zu bytes)",
+                (size_t)size, (size_t)ring->capacity);
+        RVK_EXIT_APP;
+    }
+
+    for (;;) {
+        /* an empty ring can restart at offset zero */
+        if (ring->head == ring->tail) {
+            ring->head = ring->tail = (ring->head + ring->capacity - 1) / ring->capacity * ring->capacity;
+        }
+
+        VkDeviceSize offset = ring->head % ring->capacity;
+        VkDeviceSize aligned = (offset + alignment - 1) / alignment * alignment;
+        if (aligned + size > ring->capacity) aligned = ring->capacity; // wrap around, skip the end
+        VkDeviceSize new_head = ring->head + (aligned - offset) + size;
+        if (new_head - ring->tail <= ring->capacity) {
+            ring->head = new_head;
+            Rvk_Staging_Span *last = (ring->spans.count) ? &ring->spans.items[ring->spans.count - 1] : NULL;
+            if (last && last->owner == owner && !last->timeline) last->end = new_head;
+            else rvk_da_append(&ring->spans, ((Rvk_Staging_Span){.end = new_head, .owner = owner}));
+            VkDeviceSize start = aligned % ring->capacity;
+            return (Rvk_Staging_Range) {
+                .handle = ring->handle,
+                .offset = start,
+                .size = size,
+                .mapped = (uint8_t *)ring->mapped + start,
+            };
+        }
+
+        /* out of room, wait on the oldest upload or frame still reading from the ring */
+        Rvk_Staging_Span *oldest = &ring->spans.items[0];
+        if (oldest->timeline) {
+            rvk_timeline_wait(oldest->timeline, oldest->value);
+            rvk_stg_ring_retire();
+        } else if (oldest->owner == RVK_STAGING_BATCH && rvk_active_upload_batch && rvk_active_upload_batch->cmd_count) {
+            rvk_upload_batch_flush(rvk_active_upload_batch);
         } else {
-            rvk_log(RVK_ERROR, "old_layout %d with new_layout %d not allowed yet", old_layout, new_layout);
+            rvk_log(RVK_ERROR, "staging ring is full of ranges that were never submitted, increase Rvk_Config.staging_ring_size");
             RVK_EXIT_APP;
         }
+    }
+}
 
-        VkImageMemoryBarrier barrier = {
-            .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
-            .srcAccessMask = src_access_mask,
-            .dstAccessMask = dst_access_mask,
-            .oldLayout = old_layout,
-            .newLayout = new_layout,
-            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-            .image = image,
-            .subresourceRange = {
-                .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
-                .levelCount = 1,
-                .layerCount = 1,
-            },
-        };
-        vkCmdPipelineBarrier(
-            tmp_cmd_buff, src_stg_mask, dst_stg_mask,
-            0, 0, NULL, 0, NULL, 1,
-            &barrier
-        );
-    rvk_cmd_quick_end(&tmp_cmd_buff);
+void rvk_transition_img_layout(VkImage image, VkImageLayout old_layout, VkImageLayout new_layout)
+{
+    VkCommandBuffer tmp_cmd_buff = rvk_upload_cmd_begin();
+        if (rvk_ctx.transfer.dedicated && rvk_active_upload_batch && new_layout != VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL) {
+            /* the layout the unified queue will use, the transition becomes part of the ownership transfer */
+            Rvk_Queue_Transfer t = {.img = image, .old_layout = old_layout, .new_layout = new_layout};
+            rvk_da_append(&rvk_ctx.transfer.pending, t);
+        } else {
+            rvk_cmd_transition_img_layout(tmp_cmd_buff, image, old_layout, new_layout);
+        }
+    rvk_upload_cmd_end(&tmp_cmd_buff);
+}
+
+void rvk_img_layout_masks(VkImageLayout old_layout, VkImageLayout new_layout,
+                          VkPipelineStageFlags *src_stage, VkPipelineStageFlags *dst_stage,
+                          VkAccessFlags *src_access, VkAccessFlags *dst_access)
+{
+    if (old_layout == VK_IMAGE_LAYOUT_UNDEFINED && new_layout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL) {
+        *src_access = 0;
+        *dst_access = VK_ACCESS_TRANSFER_WRITE_BIT;
+        *src_stage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+        *dst_stage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+    } else if (old_layout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL &&
+               new_layout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL) {
+        *src_access = VK_ACCESS_TRANSFER_WRITE_BIT;
+        *dst_access = VK_ACCESS_SHADER_READ_BIT;
+        *src_stage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+        *dst_stage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    } else if (old_layout == VK_IMAGE_LAYOUT_UNDEFINED && new_layout == VK_IMAGE_LAYOUT_GENERAL) {
+        *src_access = 0;
+        *dst_access = 0;
+        *src_stage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+        *dst_stage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+    } else {
+        rvk_log(RVK_ERROR, "old_layout %d with new_layout %d not allowed yet", old_layout, new_layout);
+        RVK_EXIT_APP;
+    }
+}
+
+void rvk_cmd_transition_img_layout(VkCommandBuffer cmd_buff, VkImage image, VkImageLayout old_layout, VkImageLayout new_layout)
+{
+    VkPipelineStageFlags src_stg_mask;
+    VkPipelineStageFlags dst_stg_mask;
+    VkAccessFlags src_access_mask;
+    VkAccessFlags dst_access_mask;
+    rvk_img_layout_masks(old_layout, new_layout, &src_stg_mask, &dst_stg_mask, &src_access_mask, &dst_access_mask);
+
+    VkImageMemoryBarrier barrier = {
+        .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+        .srcAccessMask = src_access_mask,
+        .dstAccessMask = dst_access_mask,
+        .oldLayout = old_layout,
+        .newLayout = new_layout,
+        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .image = image,
+        .subresourceRange = {
+            .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+            .levelCount = 1,
+            .layerCount = 1,
+        },
+    };
+    vkCmdPipelineBarrier(
+        cmd_buff, src_stg_mask, dst_stg_mask,
+        0, 0, NULL, 0, NULL, 1,
+        &barrier
+    );
 }
 
 void rvk_pl_barrier(VkImageMemoryBarrier barrier)
@@ -3135,17 +6557,22 @@ void rvk_color_img_barrier(VkImage color_img)
 
 void rvk_img_copy(VkImage dst_img, VkBuffer src_buff, VkExtent2D extent)
 {
-    VkCommandBuffer tmp_cmd_buff = rvk_cmd_quick_begin();
-        VkBufferImageCopy region = {
-            .imageSubresource = {
-                .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
-                .layerCount = 1,
-            },
-            .imageOffset = {0, 0, 0},
-            .imageExtent = {extent.width, extent.height, 1},
-        };
-        vkCmdCopyBufferToImage(tmp_cmd_buff, src_buff, dst_img, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
-    rvk_cmd_quick_end(&tmp_cmd_buff);
+    VkCommandBuffer tmp_cmd_buff = rvk_upload_cmd_begin();
+        rvk_cmd_img_copy(tmp_cmd_buff, dst_img, src_buff, extent);
+    rvk_upload_cmd_end(&tmp_cmd_buff);
+}
+
+void rvk_cmd_img_copy(VkCommandBuffer cmd_buff, VkImage dst_img, VkBuffer src_buff, VkExtent2D extent)
+{
+    VkBufferImageCopy region = {
+        .imageSubresource = {
+            .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+            .layerCount = 1,
+        },
+        .imageOffset = {0, 0, 0},
+        .imageExtent = {extent.width, extent.height, 1},
+    };
+    vkCmdCopyBufferToImage(cmd_buff, src_buff, dst_img, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
 }
 
 int rvk_format_to_size(VkFormat fmt)
@@ -3184,15 +6611,6 @@ Rvk_Texture rvk_load_texture(void *data, size_t width, size_t height, VkFormat f
 {
     Rvk_Texture texture = {0};
 
-    /* create staging buffer for image */
-    Rvk_Buffer stg_buff = {0};
-    size_t size  = width * height * rvk_format_to_size(fmt);
-    size_t count = width * height;
-    rvk_stage_buff_init(size, count, data, &stg_buff);
-    RAG_VK(vkMapMemory(rvk_ctx.device, stg_buff.mem, 0, stg_buff.size, 0, &stg_buff.mapped));
-    memcpy(stg_buff.mapped, data, stg_buff.size);
-    rvk_buff_unmap(stg_buff);
-
     /* create the image */
     VkExtent3D extent = {width, height, 1};
     Rvk_Image img = rvk_create_image(
@@ -3202,7 +6620,7 @@ Rvk_Texture rvk_load_texture(void *data, size_t width, size_t height, VkFormat f
         .usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT);
 
     rvk_transition_img_layout(img.handle, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-    rvk_img_copy(img.handle, stg_buff.handle, img.extent);
+    rvk_img_upload(img.handle, img.extent, fmt, data);
     rvk_transition_img_layout(
         img.handle,
         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
@@ -3241,8 +6659,6 @@ Rvk_Texture rvk_load_texture(void *data, size_t width, size_t height, VkFormat f
     VkSampler sampler;
     RAG_VK(vkCreateSampler(rvk_ctx.device, &sampler_ci, NULL, &sampler));
 
-    rvk_buff_destroy(stg_buff);
-
     texture.view = img_view;
     texture.sampler = sampler;
     texture.img = img;
@@ -3257,6 +6673,7 @@ Rvk_Render_Texture rvk_create_render_texture(VkExtent2D extent)
 {
     Rvk_Render_Texture rt = {0};
     rt.extent = extent;
+    rt.view_count = 1;
     /* create the depth image */
     rt.depth.img = (Rvk_Image) {
         .extent = {extent.width, extent.height},
@@ -3298,6 +6715,7 @@ Rvk_Render_Texture rvk_create_render_texture(VkExtent2D extent)
     /* create the frame buffer which combines both depth and color */
     rt.img_views[0] = rt.color.view;
     rt.img_views[1] = rt.depth.view;
+    if (rvk_ctx.features.dynamic_rendering) return rt;
 
     rt.rp = rvk_create_basic_render_pass();
 
@@ -3316,8 +6734,20 @@ void rvk_destroy_render_texture(Rvk_Render_Texture rt)
 {
     rvk_unload_texture(rt.depth);
     rvk_unload_texture(rt.color);
-    rvk_destroy_render_pass(rt.rp);
-    rvk_destroy_frame_buff(rt.fb);
+    if (rt.rp) rvk_destroy_render_pass(rt.rp);
+    if (rt.fb) rvk_destroy_frame_buff(rt.fb);
+}
+
+void rvk_resize_render_texture(Rvk_Render_Texture *rt, VkExtent2D extent)
+{
+    if (rt->extent.width == extent.width && rt->extent.height == extent.height) return;
+
+    uint32_t view_count = (rt->view_count) ? rt->view_count : 1;
+    rvk_destroy_render_texture(*rt);
+    if (view_count > 1)
+        *rt = rvk_create_multiview_render_texture(extent, view_count);
+    else
+        *rt = rvk_create_render_texture(extent);
 }
 
 VkRenderPass rvk_create_multiview_render_pass()
@@ -3419,7 +6849,7 @@ VkRenderPass rvk_create_multiview_render_pass()
 Rvk_Render_Texture rvk_create_multiview_render_texture(VkExtent2D extent, uint32_t view_count)
 {
     VkExtent3D extent3d = (VkExtent3D){extent.width, extent.height, 1};
-    Rvk_Render_Texture rt = { .extent = extent };
+    Rvk_Render_Texture rt = { .extent = extent, .view_count = view_count };
     rt.depth.img = rvk_create_image(
         extent3d,
         VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
@@ -3473,6 +6903,7 @@ Rvk_Render_Texture rvk_create_multiview_render_texture(VkExtent2D extent, uint32
     /* create the frame buffer which combines both depth and color */
     rt.img_views[0] = rt.color.view;
     rt.img_views[1] = rt.depth.view;
+    if (rvk_ctx.features.dynamic_rendering) return rt; // view mask comes from view_count
 
     // TODO: the viewcount doesn't do anything here and it should
     rt.rp = rvk_create_multiview_render_pass();
@@ -3490,18 +6921,12 @@ Rvk_Render_Texture rvk_create_multiview_render_texture(VkExtent2D extent, uint32
 
 void rvk_unload_texture(Rvk_Texture texture)
 {
-    vkDestroySampler(rvk_ctx.device, texture.sampler, NULL);
-    vkDestroyImageView(rvk_ctx.device, texture.view, NULL);
-    vkDestroyImage(rvk_ctx.device, texture.img.handle, NULL);
-    vkFreeMemory(rvk_ctx.device, texture.img.mem, NULL);
+    rvk_defer_destroy((Rvk_Deferred_Destroy){.kind = RVK_DEFERRED_TEXTURE, .as.tex = texture});
 }
 
 void rvk_destroy_texture(Rvk_Texture texture)
 {
-    vkDestroySampler(rvk_ctx.device, texture.sampler, NULL);
-    vkDestroyImageView(rvk_ctx.device, texture.view, NULL);
-    vkDestroyImage(rvk_ctx.device, texture.img.handle, NULL);
-    vkFreeMemory(rvk_ctx.device, texture.img.mem, NULL);
+    rvk_unload_texture(texture);
 }
 
 void rvk_storage_tex_init(Rvk_Texture *texture, VkExtent2D extent)
@@ -3570,68 +6995,48 @@ void rvk_create_ds_pool(VkDescriptorPoolCreateInfo pool_ci, VkDescriptorPool *po
     RAG_VK(vkCreateDescriptorPool(rvk_ctx.device, &pool_ci, NULL, pool));
 }
 
+/* pools are created lazily by the first allocation, sized from the layouts actually used */
 void rvk_descriptor_pool_arena_init(Rvk_Descriptor_Pool_Arena *arena)
 {
-    VkDescriptorPoolSize pool_sizes[] = {
-        {.type = VK_DESCRIPTOR_TYPE_SAMPLER,                .descriptorCount = MAX_DESCRIPTOR_SETS},
-        {.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, .descriptorCount = MAX_DESCRIPTOR_SETS},
-        {.type = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,          .descriptorCount = MAX_DESCRIPTOR_SETS},
-        {.type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,          .descriptorCount = MAX_DESCRIPTOR_SETS},
-        {.type = VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER,   .descriptorCount = MAX_DESCRIPTOR_SETS},
-        {.type = VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER,   .descriptorCount = MAX_DESCRIPTOR_SETS},
-        {.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,         .descriptorCount = MAX_DESCRIPTOR_SETS},
-        {.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         .descriptorCount = MAX_DESCRIPTOR_SETS},
-        {.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, .descriptorCount = MAX_DESCRIPTOR_SETS},
-        {.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, .descriptorCount = MAX_DESCRIPTOR_SETS},
-        {.type = VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT,       .descriptorCount = MAX_DESCRIPTOR_SETS},
-    };
-    VkDescriptorPoolCreateInfo pool_ci = {
-        .sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
-        .poolSizeCount = RVK_ARRAY_LEN(pool_sizes),
-        .pPoolSizes    = pool_sizes,
-        .maxSets       = MAX_DESCRIPTOR_SETS,
-    };
-    rvk_create_ds_pool(pool_ci, &arena->pool);
+    *arena = (Rvk_Descriptor_Pool_Arena){0};
 }
 
 Rvk_Descriptor_Pool_Arena rvk_create_descriptor_pool_arena()
 {
     Rvk_Descriptor_Pool_Arena arena = {0};
-    VkDescriptorPoolSize pool_sizes[] = {
-        {.type = VK_DESCRIPTOR_TYPE_SAMPLER,                .descriptorCount = MAX_DESCRIPTOR_SETS},
-        {.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, .descriptorCount = MAX_DESCRIPTOR_SETS},
-        {.type = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,          .descriptorCount = MAX_DESCRIPTOR_SETS},
-        {.type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,          .descriptorCount = MAX_DESCRIPTOR_SETS},
-        {.type = VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER,   .descriptorCount = MAX_DESCRIPTOR_SETS},
-        {.type = VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER,   .descriptorCount = MAX_DESCRIPTOR_SETS},
-        {.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,         .descriptorCount = MAX_DESCRIPTOR_SETS},
-        {.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         .descriptorCount = MAX_DESCRIPTOR_SETS},
-        {.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, .descriptorCount = MAX_DESCRIPTOR_SETS},
-        {.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, .descriptorCount = MAX_DESCRIPTOR_SETS},
-        {.type = VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT,       .descriptorCount = MAX_DESCRIPTOR_SETS},
-    };
-    VkDescriptorPoolCreateInfo pool_ci = {
-        .sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
-        .poolSizeCount = RVK_ARRAY_LEN(pool_sizes),
-        .pPoolSizes    = pool_sizes,
-        .maxSets       = MAX_DESCRIPTOR_SETS,
-    };
-    rvk_create_ds_pool(pool_ci, &arena.pool);
     return arena;
 }
 
 void rvk_descriptor_pool_arena_reset(Rvk_Descriptor_Pool_Arena *arena)
 {
+    if (arena->pools.count > 1) {
+        /* the chain grew since the last reset, the next allocation creates one pool fitting the peak */
+        for (size_t i = 0; i < arena->pools.count; i++)
+            rvk_destroy_ds_pool(arena->pools.items[i]);
+        arena->pools.count = 0;
+        arena->pool = VK_NULL_HANDLE;
+    } else if (arena->pools.count == 1) {
+        rvk_reset_pool(arena->pool);
+    }
+    arena->pool_idx = 0;
+    arena->set_count = 0;
     for (size_t i = 0; i < RVK_DESCRIPTOR_TYPE_COUNT; i++)
         arena->pools_usage[i] = 0;
-    rvk_reset_pool(arena->pool);
 }
 
 void rvk_ds_layout_init(VkDescriptorSetLayoutBinding *bindings, size_t b_count, Rvk_Descriptor_Set_Layout *layout)
 {
+    layout->binding_count = 0;
     for (size_t i = 0; i < b_count; i++) {
         VkDescriptorSetLayoutBinding binding = bindings[i];
         layout->desc_count[binding.descriptorType] += binding.descriptorCount;
+        if (b_count <= RVK_MAX_LAYOUT_BINDINGS) {
+            layout->bindings[layout->binding_count++] = (Rvk_Layout_Binding){
+                .binding = binding.binding,
+                .type    = binding.descriptorType,
+                .count   = binding.descriptorCount,
+            };
+        }
     }
     VkDescriptorSetLayoutCreateInfo layout_ci = {
         .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
@@ -3641,20 +7046,275 @@ void rvk_ds_layout_init(VkDescriptorSetLayoutBinding *bindings, size_t b_count,
     RAG_VK(vkCreateDescriptorSetLayout(rvk_ctx.device, &layout_ci, NULL, &layout->handle));
 }
 
+static void rvk_descriptor_pool_arena_grow(Rvk_Descriptor_Pool_Arena *arena, Rvk_Descriptor_Set_Layout *ds_layout)
+{
+    /* twice what was handed out since the last reset, at least the peak seen so far */
+    VkDescriptorPoolSize pool_sizes[RVK_DESCRIPTOR_TYPE_COUNT];
+    uint32_t size_count = 0;
+    for (size_t i = 0; i < RVK_DESCRIPTOR_TYPE_COUNT; i++) {
+        uint32_t count = RVK_MAX(2 * arena->pools_usage[i], arena->peak_usage[i]);
+        count = RVK_MAX(count, ds_layout->desc_count[i] * RVK_DESCRIPTOR_ARENA_INITIAL_SETS);
+        if (count) pool_sizes[size_count++] = (VkDescriptorPoolSize){.type = (VkDescriptorType)i, .descriptorCount = count};
+    }
+    if (!size_count)
+        pool_sizes[size_count++] = (VkDescriptorPoolSize){.type = VK_DESCRIPTOR_TYPE_SAMPLER, .descriptorCount = 1};
+    uint32_t max_sets = RVK_MAX(2 * arena->set_count, arena->peak_set_count);
+
+    VkDescriptorPoolCreateInfo pool_ci = {
+        .sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+        .poolSizeCount = size_count,
+        .pPoolSizes    = pool_sizes,
+        .maxSets       = RVK_MAX(max_sets, RVK_DESCRIPTOR_ARENA_INITIAL_SETS),
+    };
+    VkDescriptorPool pool;
+    rvk_create_ds_pool(pool_ci, &pool);
+    rvk_da_append(&arena->pools, pool);
+}
+
 void rvk_descriptor_pool_arena_alloc_set(Rvk_Descriptor_Pool_Arena *arena, Rvk_Descriptor_Set_Layout *ds_layout, VkDescriptorSet *set)
 {
     VkDescriptorSetAllocateInfo alloc_info = {
         .sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
-        .descriptorPool     = arena->pool,
         .descriptorSetCount = 1,
         .pSetLayouts        = &ds_layout->handle,
     };
-    for (size_t i = 0; i < RVK_DESCRIPTOR_TYPE_COUNT; i++)
-        arena->pools_usage[i] += ds_layout->desc_count[i];
-    if (!rvk_alloc_ds(alloc_info, set)) {
+    for (;;) {
+        bool fresh = arena->pool_idx == arena->pools.count;
+        if (fresh) rvk_descriptor_pool_arena_grow(arena, ds_layout);
+        arena->pool = arena->pools.items[arena->pool_idx];
+        alloc_info.descriptorPool = arena->pool;
+
+        VkResult res = vkAllocateDescriptorSets(rvk_ctx.device, &alloc_info, set);
+        if (RVK_SUCCEEDED(res)) break;
+        if ((res == VK_ERROR_OUT_OF_POOL_MEMORY || res == VK_ERROR_FRAGMENTED_POOL) && !fresh) {
+            arena->pool_idx++;
+            continue;
+        }
+
+        /* a pool sized for this very layout should not run out, the layout counts are likely wrong */
+        rvk_log(RVK_ERROR, "failed to allocate descriptor set from arena");
+        rvk_log_descriptor_layout_usage(*ds_layout, NULL);
         rvk_log_descriptor_pool_usage(*arena);
         RVK_EXIT_APP;
     }
+
+    arena->set_count++;
+    arena->peak_set_count = RVK_MAX(arena->peak_set_count, arena->set_count);
+    for (size_t i = 0; i < RVK_DESCRIPTOR_TYPE_COUNT; i++) {
+        arena->pools_usage[i] += ds_layout->desc_count[i];
+        arena->peak_usage[i] = RVK_MAX(arena->peak_usage[i], arena->pools_usage[i]);
+    }
+}
+
+Rvk_Descriptor_Pool_Arena *rvk_frame_ds_arena()
+{
+    return &rvk_ctx.frames[rvk_ctx.frame_idx].ds_arena;
+}
+
+void rvk_frame_alloc_set(Rvk_Descriptor_Set_Layout *ds_layout, VkDescriptorSet *set)
+{
+    rvk_descriptor_pool_arena_alloc_set(rvk_frame_ds_arena(), ds_layout, set);
+}
+
+static const VkDescriptorType rvk_bindless_desc_types[RVK_BINDLESS_KIND_COUNT] = {
+    [RVK_BINDLESS_TEXTURE]        = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+    [RVK_BINDLESS_STORAGE_BUFFER] = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+    [RVK_BINDLESS_STORAGE_IMAGE]  = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+};
+
+static uint32_t rvk_min_u32(uint32_t a, uint32_t b) { return (a < b) ? a : b; }
+
+void rvk_bindless_init()
+{
+    Rvk_Bindless_Table *table = &rvk_ctx.bindless;
+
+    /* update-after-bind limits are separate from the regular per set limits */
+    VkPhysicalDeviceDescriptorIndexingProperties indexing = {.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES};
+    VkPhysicalDeviceProperties2 props = {.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2, .pNext = &indexing};
+    vkGetPhysicalDeviceProperties2(rvk_ctx.phys_device, &props);
+    table->capacity[RVK_BINDLESS_TEXTURE] = rvk_min_u32(RVK_BINDLESS_MAX_TEXTURES,
+        rvk_min_u32(indexing.maxDescriptorSetUpdateAfterBindSampledImages, indexing.maxPerStageDescriptorUpdateAfterBindSampledImages));
+    table->capacity[RVK_BINDLESS_STORAGE_BUFFER] = rvk_min_u32(RVK_BINDLESS_MAX_STORAGE_BUFFERS,
+        rvk_min_u32(indexing.maxDescriptorSetUpdateAfterBindStorageBuffers, indexing.maxPerStageDescriptorUpdateAfterBindStorageBuffers));
+    table->capacity[RVK_BINDLESS_STORAGE_IMAGE] = rvk_min_u32(RVK_BINDLESS_MAX_STORAGE_IMAGES,
+        rvk_min_u32(indexing.maxDescriptorSetUpdateAfterBindStorageImages, indexing.maxPerStageDescriptorUpdateAfterBindStorageImages));
+
+    VkDescriptorSetLayoutBinding bindings[RVK_BINDLESS_KIND_COUNT] = {0};
+    VkDescriptorBindingFlags binding_flags[RVK_BINDLESS_KIND_COUNT] = {0};
+    VkDescriptorPoolSize pool_sizes[RVK_BINDLESS_KIND_COUNT] = {0};
+    for (uint32_t kind = 0; kind < RVK_BINDLESS_KIND_COUNT; kind++) {
+        bindings[kind] = (VkDescriptorSetLayoutBinding) {
+            .binding = kind,
+            .descriptorType = rvk_bindless_desc_types[kind],
+            .descriptorCount = table->capacity[kind],
+            .stageFlags = VK_SHADER_STAGE_ALL,
+        };
+        binding_flags[kind] = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT |
+                              VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+                              VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+        pool_sizes[kind] = (VkDescriptorPoolSize) {
+            .type = rvk_bindless_desc_types[kind],
+            .descriptorCount = table->capacity[kind],
+        };
+    }
+    VkDescriptorSetLayoutBindingFlagsCreateInfo flags_ci = {
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO,
+        .bindingCount = RVK_ARRAY_LEN(binding_flags),
+        .pBindingFlags = binding_flags,
+    };
+    VkDescriptorSetLayoutCreateInfo layout_ci = {
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+        .pNext = &flags_ci,
+        .flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT,
+        .bindingCount = RVK_ARRAY_LEN(bindings),
+        .pBindings = bindings,
+    };
+    RAG_VK(vkCreateDescriptorSetLayout(rvk_ctx.device, &layout_ci, NULL, &table->layout));
+
+    VkDescriptorPoolCreateInfo pool_ci = {
+        .sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+        .flags         = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT,
+        .poolSizeCount = RVK_ARRAY_LEN(pool_sizes),
+        .pPoolSizes    = pool_sizes,
+        .maxSets       = 1,
+    };
+    rvk_create_ds_pool(pool_ci, &table->pool);
+
+    VkDescriptorSetAllocateInfo alloc_info = {
+        .sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+        .descriptorPool     = table->pool,
+        .descriptorSetCount = 1,
+        .pSetLayouts        = &table->layout,
+    };
+    if (!rvk_alloc_ds(alloc_info, &table->set)) RVK_EXIT_APP;
+
+    rvk_log(RVK_INFO, "bindless table: %u textures, %u storage buffers, %u storage images",
+            table->capacity[RVK_BINDLESS_TEXTURE],
+            table->capacity[RVK_BINDLESS_STORAGE_BUFFER],
+            table->capacity[RVK_BINDLESS_STORAGE_IMAGE]);
+}
+
+void rvk_bindless_destroy()
+{
+    Rvk_Bindless_Table *table = &rvk_ctx.bindless;
+    if (!table->pool) return;
+
+    vkDestroyDescriptorPool(rvk_ctx.device, table->pool, NULL);
+    vkDestroyDescriptorSetLayout(rvk_ctx.device, table->layout, NULL);
+    for (uint32_t kind = 0; kind < RVK_BINDLESS_KIND_COUNT; kind++) {
+        rvk_da_free(table->free[kind]);
+        rvk_da_free(table->removed[kind]);
+        for (uint32_t i = 0; i < RVK_MAX_FRAMES_IN_FLIGHT; i++)
+            rvk_da_free(table->retired[i][kind]);
+    }
+    *table = (Rvk_Bindless_Table){0};
+}
+
+void rvk_bindless_submit(uint32_t frame_idx)
+{
+    Rvk_Bindless_Table *table = &rvk_ctx.bindless;
+    if (!table->pool) return;
+
+    for (uint32_t kind = 0; kind < RVK_BINDLESS_KIND_COUNT; kind++) {
+        Rvk_Bindless_Slots *removed = &table->removed[kind];
+        for (size_t i = 0; i < removed->count; i++)
+            rvk_da_append(&table->retired[frame_idx][kind], removed->items[i]);
+        removed->count = 0;
+    }
+}
+
+void rvk_bindless_retire(uint32_t frame_idx)
+{
+    Rvk_Bindless_Table *table = &rvk_ctx.bindless;
+    if (!table->pool) return;
+
+    for (uint32_t kind = 0; kind < RVK_BINDLESS_KIND_COUNT; kind++) {
+        Rvk_Bindless_Slots *retired = &table->retired[frame_idx][kind];
+        for (size_t i = 0; i < retired->count; i++)
+            rvk_da_append(&table->free[kind], retired->items[i]);
+        retired->count = 0;
+    }
+}
+
+static uint32_t rvk_bindless_alloc(Rvk_Bindless_Kind kind)
+{
+    Rvk_Bindless_Table *table = &rvk_ctx.bindless;
+    if (!table->pool) {
+        rvk_log(RVK_ERROR, "bindless table does not exist, call rvk_enable_bindless() before initializing");
+        RVK_EXIT_APP;
+    }
+
+    if (table->free[kind].count) return table->free[kind].items[--table->free[kind].count];
+    if (table->used[kind] < table->capacity[kind]) return table->used[kind]++;
+
+    rvk_log(RVK_ERROR, "bindless table is full (%u slots of kind %d)", table->capacity[kind], kind);
+    return RVK_BINDLESS_NONE;
+}
+
+static void rvk_bindless_write(Rvk_Bindless_Kind kind, uint32_t idx, const VkDescriptorImageInfo *img_info, const VkDescriptorBufferInfo *buff_info)
+{
+    VkWriteDescriptorSet write = {
+        .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+        .dstSet = rvk_ctx.bindless.set,
+        .dstBinding = kind,
+        .dstArrayElement = idx,
+        .descriptorCount = 1,
+        .descriptorType = rvk_bindless_desc_types[kind],
+        .pImageInfo = img_info,
+        .pBufferInfo = buff_info,
+    };
+    vkUpdateDescriptorSets(rvk_ctx.device, 1, &write, 0, NULL);
+}
+
+uint32_t rvk_bindless_add_texture(Rvk_Texture tex)
+{
+    uint32_t idx = rvk_bindless_alloc(RVK_BINDLESS_TEXTURE);
+    if (idx != RVK_BINDLESS_NONE) rvk_bindless_write(RVK_BINDLESS_TEXTURE, idx, &tex.info, NULL);
+    return idx;
+}
+
+uint32_t rvk_bindless_add_storage_buffer(Rvk_Buffer buff)
+{
+    uint32_t idx = rvk_bindless_alloc(RVK_BINDLESS_STORAGE_BUFFER);
+    if (idx != RVK_BINDLESS_NONE) rvk_bindless_write(RVK_BINDLESS_STORAGE_BUFFER, idx, NULL, &buff.info);
+    return idx;
+}
+
+uint32_t rvk_bindless_add_storage_image(VkImageView view)
+{
+    uint32_t idx = rvk_bindless_alloc(RVK_BINDLESS_STORAGE_IMAGE);
+    VkDescriptorImageInfo info = {.imageView = view, .imageLayout = VK_IMAGE_LAYOUT_GENERAL};
+    if (idx != RVK_BINDLESS_NONE) rvk_bindless_write(RVK_BINDLESS_STORAGE_IMAGE, idx, &info, NULL);
+    return idx;
+}
+
+void rvk_bindless_update_texture(uint32_t idx, Rvk_Texture tex)
+{
+    /* the slot is update-unused-while-pending, so only change it when no frame in flight reads it */
+    rvk_bindless_write(RVK_BINDLESS_TEXTURE, idx, &tex.info, NULL);
+}
+
+void rvk_bindless_remove(Rvk_Bindless_Kind kind, uint32_t idx)
+{
+    if (idx == RVK_BINDLESS_NONE) return;
+    /* whichever frame last drew with the slot, the next frame submission completes after it */
+    rvk_da_append(&rvk_ctx.bindless.removed[kind], idx);
+}
+
+VkDescriptorSetLayout rvk_bindless_layout()
+{
+    return rvk_ctx.bindless.layout;
+}
+
+void rvk_bind_bindless(VkPipelineLayout pl_layout, VkPipelineBindPoint bind_point)
+{
+    VkCommandBuffer cmd_buff = rvk_get_cmd_buff();
+    if (cmd_buff) rvk_cmd_bind_bindless(cmd_buff, pl_layout, bind_point);
+}
+
+void rvk_cmd_bind_bindless(VkCommandBuffer cmd_buff, VkPipelineLayout pl_layout, VkPipelineBindPoint bind_point)
+{
+    rvk_track_bind_ds(cmd_buff, bind_point, pl_layout, 0, 1, &rvk_ctx.bindless.set);
 }
 
 const char *rvk_desc_type_to_str(Rvk_Descriptor_Type type)
@@ -3679,13 +7339,13 @@ const char *rvk_desc_type_to_str(Rvk_Descriptor_Type type)
 
 void rvk_log_descriptor_pool_usage(Rvk_Descriptor_Pool_Arena arena)
 {
-    rvk_log(RVK_INFO, "Descriptor pool usage:");
+    rvk_log(RVK_INFO, "Descriptor pool usage (%zu pools, %u sets, peak %u sets):",
+            arena.pools.count, arena.set_count, arena.peak_set_count);
     rvk_log(RVK_INFO, "only increases when you call: rvk_descriptor_pool_arena_alloc_set(...)");
     rvk_log(RVK_INFO, "only resets to zero when you call: rvk_descriptor_pool_arena_reset(...)");
-    rvk_log(RVK_INFO, "keep in mind there is no in between");
     rvk_log(RVK_INFO, "---------------------");
     for (size_t i = 0; i < RVK_DESCRIPTOR_TYPE_COUNT; i++)
-        rvk_log(RVK_INFO, "    type %s: %zu", rvk_desc_type_to_str(i), arena.pools_usage[i]);
+        rvk_log(RVK_INFO, "    type %s: %u (peak %u)", rvk_desc_type_to_str(i), arena.pools_usage[i], arena.peak_usage[i]);
     rvk_log(RVK_INFO, "---------------------");
 }
 
@@ -3698,12 +7358,14 @@ void rvk_log_descriptor_layout_usage(Rvk_Descriptor_Set_Layout layout, const cha
 
 void rvk_descriptor_pool_arena_destroy(Rvk_Descriptor_Pool_Arena arena)
 {
-    rvk_destroy_ds_pool(arena.pool);
+    for (size_t i = 0; i < arena.pools.count; i++)
+        rvk_destroy_ds_pool(arena.pools.items[i]);
+    rvk_da_free(arena.pools);
 }
 
 void rvk_destroy_descriptor_pool_arena(Rvk_Descriptor_Pool_Arena arena)
 {
-    rvk_destroy_ds_pool(arena.pool);
+    rvk_descriptor_pool_arena_destroy(arena);
 }
 
 void rvk_destroy_ds_pool(VkDescriptorPool pool)
@@ -3735,34 +7397,120 @@ void rvk_update_ds(size_t count, VkWriteDescriptorSet *writes)
     vkUpdateDescriptorSets(rvk_ctx.device, (uint32_t)count, writes, 0, NULL);
 }
 
+void rvk_ds_template_init(Rvk_Descriptor_Set_Layout *layout, Rvk_Ds_Template *tmpl)
+{
+    if (!layout->binding_count) {
+        rvk_log(RVK_ERROR, "update templates need a layout from rvk_ds_layout_init with at most %d bindings",
+                RVK_MAX_LAYOUT_BINDINGS);
+        RVK_EXIT_APP;
+    }
+
+    *tmpl = (Rvk_Ds_Template){.binding_count = layout->binding_count};
+    VkDescriptorUpdateTemplateEntry entries[RVK_MAX_LAYOUT_BINDINGS];
+    for (uint32_t i = 0; i < layout->binding_count; i++) {
+        Rvk_Layout_Binding binding = layout->bindings[i];
+        tmpl->bindings[i] = binding;
+        entries[i] = (VkDescriptorUpdateTemplateEntry){
+            .dstBinding      = binding.binding,
+            .descriptorCount = binding.count,
+            .descriptorType  = binding.type,
+            .offset          = tmpl->info_count * sizeof(Rvk_Descriptor_Info),
+            .stride          = sizeof(Rvk_Descriptor_Info),
+        };
+        tmpl->info_count += binding.count;
+    }
+
+#ifndef PLATFORM_ANDROID_QUEST
+    VkDescriptorUpdateTemplateCreateInfo tmpl_ci = {
+        .sType                      = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO,
+        .descriptorUpdateEntryCount = layout->binding_count,
+        .pDescriptorUpdateEntries   = entries,
+        .templateType               = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET,
+        .descriptorSetLayout        = layout->handle,
+    };
+    RAG_VK(vkCreateDescriptorUpdateTemplate(rvk_ctx.device, &tmpl_ci, NULL, &tmpl->handle));
+#endif
+}
+
+void rvk_update_ds_with_template(Rvk_Ds_Template *tmpl, VkDescriptorSet set, const Rvk_Descriptor_Info *infos)
+{
+    if (tmpl->handle) {
+        vkUpdateDescriptorSetWithTemplate(rvk_ctx.device, set, tmpl->handle, infos);
+        return;
+    }
+
+    /* vulkan 1.0 has no templates, write one descriptor at a time since the slots are
+     * spaced by sizeof(Rvk_Descriptor_Info) rather than by the size of each info */
+    VkWriteDescriptorSet writes[32];
+    uint32_t write_count = 0;
+    uint32_t info_idx = 0;
+    for (uint32_t i = 0; i < tmpl->binding_count; i++) {
+        Rvk_Layout_Binding binding = tmpl->bindings[i];
+        for (uint32_t elem = 0; elem < binding.count; elem++, info_idx++) {
+            const Rvk_Descriptor_Info *info = &infos[info_idx];
+            writes[write_count++] = (VkWriteDescriptorSet){
+                .sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                .dstSet           = set,
+                .dstBinding       = binding.binding,
+                .dstArrayElement  = elem,
+                .descriptorCount  = 1,
+                .descriptorType   = binding.type,
+                .pBufferInfo      = &info->buff,
+                .pImageInfo       = &info->img,
+                .pTexelBufferView = &info->texel_buff,
+            };
+            if (write_count == RVK_ARRAY_LEN(writes)) {
+                rvk_update_ds(write_count, writes);
+                write_count = 0;
+            }
+        }
+    }
+    if (write_count) rvk_update_ds(write_count, writes);
+}
+
+void rvk_destroy_ds_template(Rvk_Ds_Template tmpl)
+{
+#ifndef PLATFORM_ANDROID_QUEST
+    vkDestroyDescriptorUpdateTemplate(rvk_ctx.device, tmpl.handle, NULL);
+#else
+    (void)tmpl;
+#endif
+}
+
 void rvk_wait_idle()
 {
     RAG_VK(vkDeviceWaitIdle(rvk_ctx.device));
+    rvk_timeline_retire();
 }
 
 void rvk_cmd_bind_pipeline(VkPipeline pl, VkPipelineBindPoint bind_point)
 {
-    vkCmdBindPipeline(rvk_ctx.cmd_buff, bind_point, pl);
+    VkCommandBuffer cmd_buff = rvk_get_cmd_buff();
+    if (cmd_buff) rvk_track_bind_pipeline(cmd_buff, bind_point, pl);
 }
 
 void rvk_cmd_bind_descriptor_sets(VkPipelineLayout pl_layout, VkPipelineBindPoint bind_point, VkDescriptorSet *set)
 {
-    vkCmdBindDescriptorSets(rvk_ctx.cmd_buff, bind_point, pl_layout, 0, 1, set, 0, NULL);
+    VkCommandBuffer cmd_buff = rvk_get_cmd_buff();
+    if (cmd_buff) rvk_track_bind_ds(cmd_buff, bind_point, pl_layout, 0, 1, set);
 }
 
 void rvk_cmd_set_viewport(VkViewport viewport)
 {
-    vkCmdSetViewport(rvk_ctx.cmd_buff, 0, 1, &viewport);
+    VkCommandBuffer cmd_buff = rvk_get_cmd_buff();
+    if (cmd_buff) rvk_track_set_viewport(cmd_buff, viewport);
 }
 
 void rvk_cmd_set_scissor(VkRect2D scissor)
 {
-    vkCmdSetScissor(rvk_ctx.cmd_buff, 0, 1, &scissor);
+    VkCommandBuffer cmd_buff = rvk_get_cmd_buff();
+    if (cmd_buff) rvk_track_set_scissor(cmd_buff, scissor);
 }
 
 void rvk_cmd_draw(uint32_t vertex_count)
 {
-    vkCmdDraw(rvk_ctx.cmd_buff, vertex_count, 1, 0, 0);
+    VkCommandBuffer cmd_buff = rvk_get_cmd_buff();
+    if (cmd_buff) vkCmdDraw(cmd_buff, vertex_count, 1, 0, 0);
 }
 
 #endif // RAG_VK_IMPLEMENTATION